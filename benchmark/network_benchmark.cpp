@@ -0,0 +1,374 @@
+#include <algorithm>                   // for max, min
+#include <chrono>                      // for steady_clock, duration_cast, nanoseconds
+#include <cinttypes>                   // for PRIu64
+#include <cstdint>                     // for uint8_t, uint32_t, uint64_t
+#include <cstdio>                      // for printf, fprintf
+#include <cstdlib>                     // for exit, strtol, strtoull
+#include <cstring>                     // for strchr
+#include <functional>                  // for cref
+#include <string>                      // for string
+#include <sys/socket.h>                // for SOCK_STREAM, SOCK_DGRAM
+#include <thread>                      // for thread, sleep_for
+#include <vector>                      // for vector
+
+#include "ramrod/network_communication/client.h"
+#include "ramrod/network_communication/connection_metrics.h"
+#include "ramrod/network_communication/conversor.h"
+#include "ramrod/network_communication/operation.h"
+#include "ramrod/network_communication/reconnection_policy.h"
+#include "ramrod/network_communication/server.h"
+#include "ramrod/network_communication/socket_options.h"
+
+namespace {
+  namespace network = ramrod::network_communication;
+  using benchmark_clock = std::chrono::steady_clock;
+
+  // Every case uses its own port, counted from the base port, so a session that is still
+  // closing never receives the client of the next case
+  constexpr int tcp_echo_port{0};
+  constexpr int udp_echo_port{1};
+  constexpr int bulk_port{2};
+  constexpr int connection_port{3};
+  constexpr int async_echo_port{4};
+
+  // Size of the ping-pong messages and of the datagram that ends a UDP session
+  constexpr std::size_t ping_size{64};
+  constexpr std::size_t udp_goodbye{1};
+
+  struct settings {
+    // local: both sides in this process, server: only the remote side, client: only the cases
+    std::string role{"local"};
+    std::string ip{"127.0.0.1"};
+    int port{5700};
+    std::string only{"all"};
+    std::size_t iterations{10000};
+    std::size_t megabytes{64};
+    std::size_t connections{200};
+  };
+
+  bool selected(const settings &options, const char *name){
+    return options.only == "all" || options.only == name;
+  }
+
+  std::uint64_t elapsed(const benchmark_clock::time_point &start){
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+             benchmark_clock::now() - start).count());
+  }
+
+  double microseconds(const std::uint64_t nanoseconds){
+    return static_cast<double>(nanoseconds) / 1000.0;
+  }
+
+  void report(const char *name, const network::latency_histogram &latencies){
+    const network::histogram_snapshot result{latencies.snapshot()};
+    std::printf("%-24s %8" PRIu64 "  min %9.2f  p50 %9.2f  p90 %9.2f  p99 %9.2f  p99.9 %9.2f"
+                "  max %9.2f  mean %9.2f us\n", name, result.count,
+                microseconds(result.minimum), microseconds(result.percentile(0.5)),
+                microseconds(result.percentile(0.9)), microseconds(result.percentile(0.99)),
+                microseconds(result.percentile(0.999)), microseconds(result.maximum),
+                result.mean() / 1000.0);
+  }
+
+  network::socket_options low_latency(){
+    network::socket_options options;
+    options.no_delay = true;
+    options.quick_ack = true;
+    return options;
+  }
+
+  void fast_reconnection(network::client *connection){
+    // The servers of the local role could still be binding when the first intent is made
+    network::reconnection_policy policy{connection->reconnection()};
+    policy.initial_delay = 10;
+    policy.maximum_delay = 100;
+    connection->reconnection(policy);
+  }
+
+  // ::::::::::::::::::::::::::::::::::::::: REMOTE SIDE :::::::::::::::::::::::::::::::::::::::
+
+  // Sends back everything it receives, `sessions` equal to 0 serves forever
+  void serve_echo(const settings &options, const int socket_type, const int port_offset,
+                  const std::size_t sessions){
+    const bool is_tcp{socket_type == SOCK_STREAM};
+    const int port{options.port + port_offset};
+    std::uint8_t buffer[65536];
+
+    for(std::size_t session = 0; sessions == 0 || session < sessions; ++session){
+      network::server echo;
+      echo.options(low_latency());
+      if(!echo.connect(options.ip, port, socket_type, false)){
+        std::fprintf(stderr, "The echo server could not start in port %d\n", port);
+        return;
+      }
+
+      while(true){
+        const ssize_t received{echo.receive(buffer, sizeof(buffer))};
+        // A lost datagram is not the end of a UDP session, only the goodbye is
+        if(!is_tcp && received < 0) continue;
+        if(received <= 0 || (!is_tcp && received == static_cast<ssize_t>(udp_goodbye))) break;
+        if(echo.send_all(buffer, static_cast<std::size_t>(received)) <= 0) break;
+      }
+      echo.disconnect();
+    }
+  }
+
+  // Receives blocks announced by a header of size and count, then answers with one byte
+  void serve_bulk(const settings &options, const std::size_t sessions){
+    std::vector<std::uint8_t> buffer;
+
+    for(std::size_t session = 0; sessions == 0 || session < sessions; ++session){
+      network::server sink;
+      if(!sink.connect(options.ip, options.port + bulk_port, SOCK_STREAM, false)){
+        std::fprintf(stderr, "The bulk server could not start\n");
+        return;
+      }
+
+      std::uint32_t header[2];
+      while(sink.receive_all(header, sizeof(header)) == static_cast<ssize_t>(sizeof(header))){
+        const std::size_t size{network::conversor::network_to_host(header[0])};
+        const std::uint32_t count{network::conversor::network_to_host(header[1])};
+        if(size == 0) break;
+
+        buffer.resize(size);
+        std::uint32_t done{0};
+        for(; done < count; ++done)
+          if(sink.receive_all(buffer.data(), size) != static_cast<ssize_t>(size)) break;
+        if(done < count) break;
+
+        const std::uint8_t acknowledgement{1};
+        if(sink.send_all(&acknowledgement, sizeof(acknowledgement)) <= 0) break;
+      }
+      sink.disconnect();
+    }
+  }
+
+  // Accepts any number of clients and discards what they send
+  bool serve_connections(const settings &options, network::server *acceptor){
+    network::connection_handlers handlers;
+    handlers.readable = [acceptor](const int client_fd){
+      std::uint8_t buffer[1024];
+      while(acceptor->receive_from(client_fd, buffer, sizeof(buffer)) > 0);
+    };
+    return acceptor->listen(options.ip, handlers, options.port + connection_port, 1, false);
+  }
+
+  // :::::::::::::::::::::::::::::::::::::::: CASES ::::::::::::::::::::::::::::::::::::::::::::
+
+  // Every case returns false if it could not be completed
+  bool ping_pong(const settings &options, const int socket_type, const bool asynchronous){
+    const bool is_tcp{socket_type == SOCK_STREAM};
+    const char *name{asynchronous ? "tcp ping-pong async" : is_tcp ? "tcp ping-pong"
+                                                                   : "udp ping-pong"};
+    const int port{asynchronous ? async_echo_port : is_tcp ? tcp_echo_port : udp_echo_port};
+    network::client connection;
+    connection.options(low_latency());
+    fast_reconnection(&connection);
+    // A lost datagram is detected after a short time instead of the default second
+    if(!is_tcp){
+      connection.io_timeout(100);
+      connection.max_reconnection_intents(3);
+    }
+    if(!connection.connect(options.ip, options.port + port, socket_type, false)){
+      std::fprintf(stderr, "%s: could not connect\n", name);
+      return false;
+    }
+
+    std::uint8_t outgoing[ping_size]{};
+    std::uint8_t incoming[ping_size];
+    network::latency_histogram latencies;
+    std::size_t lost{0};
+    const std::size_t warm_up{std::min<std::size_t>(100, options.iterations)};
+
+    for(std::size_t i = 0; i < warm_up + options.iterations; ++i){
+      outgoing[0] = static_cast<std::uint8_t>(i);
+      const benchmark_clock::time_point start{benchmark_clock::now()};
+      ssize_t received;
+      if(asynchronous){
+        network::operation sending{connection.send_all_async(outgoing, sizeof(outgoing))};
+        network::operation receiving{connection.receive_all_async(incoming, sizeof(incoming))};
+        sending.get();
+        received = receiving.get();
+      }else{
+        received = connection.send_all(outgoing, sizeof(outgoing)) <= 0
+                   ? -1 : connection.receive_all(incoming, sizeof(incoming));
+      }
+      const std::uint64_t duration{elapsed(start)};
+
+      if(received != static_cast<ssize_t>(sizeof(incoming)) || incoming[0] != outgoing[0]){
+        if(is_tcp){
+          std::fprintf(stderr, "%s: the round trip %zu failed\n", name, i);
+          connection.disconnect();
+          return false;
+        }
+        ++lost;
+        continue;
+      }
+      if(i >= warm_up) latencies.record(duration);
+    }
+
+    if(!is_tcp){
+      const std::uint8_t goodbye[udp_goodbye]{0};
+      connection.send_all(goodbye, sizeof(goodbye));
+    }
+    connection.disconnect();
+
+    report(name, latencies);
+    if(lost > 0) std::printf("%-24s %8zu datagrams lost or late\n", "", lost);
+    return true;
+  }
+
+  bool bulk(const settings &options){
+    network::client connection;
+    fast_reconnection(&connection);
+    if(!connection.connect(options.ip, options.port + bulk_port, SOCK_STREAM, false)){
+      std::fprintf(stderr, "bulk: could not connect\n");
+      return false;
+    }
+
+    const std::size_t sizes[]{64, 1024, 16384, 262144, 1048576};
+    const std::size_t total{options.megabytes * 1024 * 1024};
+    std::vector<std::uint8_t> buffer(sizes[sizeof(sizes) / sizeof(sizes[0]) - 1], 0x5a);
+
+    for(const std::size_t size : sizes){
+      const std::uint32_t count{static_cast<std::uint32_t>(std::max<std::size_t>(1, total / size))};
+      const std::uint32_t header[2]{
+        network::conversor::host_to_network(static_cast<std::uint32_t>(size)),
+        network::conversor::host_to_network(count)
+      };
+
+      const benchmark_clock::time_point start{benchmark_clock::now()};
+      std::uint32_t done{0};
+      if(connection.send_all(header, sizeof(header)) > 0)
+        for(; done < count; ++done)
+          if(connection.send_all(buffer.data(), size) != static_cast<ssize_t>(size)) break;
+      std::uint8_t acknowledgement;
+      if(done < count || connection.receive_all(&acknowledgement, 1) != 1){
+        std::fprintf(stderr, "bulk: the transfer of %zu bytes blocks failed\n", size);
+        connection.disconnect();
+        return false;
+      }
+
+      const double seconds{static_cast<double>(elapsed(start)) / 1e9};
+      const double bytes{static_cast<double>(size) * count};
+      std::printf("bulk %-19zu %8" PRIu32 "  %10.1f MiB/s  %12.0f messages/s\n", size, count,
+                  bytes / seconds / (1024.0 * 1024.0), count / seconds);
+    }
+
+    const std::uint32_t end[2]{0, 0};
+    connection.send_all(end, sizeof(end));
+    connection.disconnect();
+    return true;
+  }
+
+  bool connection_setup(const settings &options){
+    network::client connection;
+    fast_reconnection(&connection);
+    network::latency_histogram latencies;
+
+    for(std::size_t i = 0; i < options.connections; ++i){
+      const benchmark_clock::time_point start{benchmark_clock::now()};
+      if(!connection.connect(options.ip, options.port + connection_port, SOCK_STREAM, false)
+         || !connection.is_connected()){
+        std::fprintf(stderr, "connect: the intent %zu failed\n", i);
+        return false;
+      }
+      latencies.record(elapsed(start));
+      connection.disconnect();
+    }
+    report("tcp connect", latencies);
+    return true;
+  }
+
+  void usage(const char *program){
+    std::printf("Usage: %s [options]\n"
+                "  --role=local|server|client  local runs both sides in this process (default),\n"
+                "                              server waits for the clients of another host and\n"
+                "                              client runs the cases against --ip\n"
+                "  --ip=ADDRESS                address to connect or bind (default 127.0.0.1)\n"
+                "  --port=PORT                 first of the 5 ports used (default 5700)\n"
+                "  --case=NAME                 all, tcp, udp, async, bulk or connect\n"
+                "  --iterations=N              round trips of every ping-pong (default 10000)\n"
+                "  --megabytes=N               bytes sent per block size in bulk (default 64)\n"
+                "  --connections=N             connections made by connect (default 200)\n",
+                program);
+  }
+
+  bool parse(const int argc, char **argv, settings *options){
+    for(int i = 1; i < argc; ++i){
+      const char *argument{argv[i]};
+      const char *value{std::strchr(argument, '=')};
+      if(value == nullptr) return false;
+      const std::string name(argument, static_cast<std::size_t>(value - argument));
+      ++value;
+
+      if(name == "--role") options->role = value;
+      else if(name == "--ip") options->ip = value;
+      else if(name == "--port") options->port = static_cast<int>(std::strtol(value, nullptr, 10));
+      else if(name == "--case") options->only = value;
+      else if(name == "--iterations") options->iterations = std::strtoull(value, nullptr, 10);
+      else if(name == "--megabytes") options->megabytes = std::strtoull(value, nullptr, 10);
+      else if(name == "--connections") options->connections = std::strtoull(value, nullptr, 10);
+      else return false;
+    }
+    return options->role == "local" || options->role == "server" || options->role == "client";
+  }
+} // namespace: anonymous
+
+int main(int argc, char **argv){
+  settings options;
+  if(!parse(argc, argv, &options)){
+    usage(argv[0]);
+    return 1;
+  }
+
+  const bool tcp{selected(options, "tcp")};
+  const bool async{selected(options, "async")};
+  const bool udp{selected(options, "udp")};
+  const bool bulk_case{selected(options, "bulk")};
+  const bool connect_case{selected(options, "connect")};
+
+  network::server acceptor;
+  std::vector<std::thread> servers;
+  if(options.role != "client"){
+    // The remote side serves forever, the local one only the sessions of this run
+    const bool forever{options.role == "server"};
+    const std::size_t sessions{forever ? 0U : 1U};
+    if(forever || tcp)
+      servers.emplace_back(serve_echo, std::cref(options), SOCK_STREAM, tcp_echo_port, sessions);
+    if(forever || async)
+      servers.emplace_back(serve_echo, std::cref(options), SOCK_STREAM, async_echo_port,
+                           sessions);
+    if(forever || udp)
+      servers.emplace_back(serve_echo, std::cref(options), SOCK_DGRAM, udp_echo_port, sessions);
+    if(forever || bulk_case)
+      servers.emplace_back(serve_bulk, std::cref(options), sessions);
+    if((forever || connect_case) && !serve_connections(options, &acceptor))
+      std::fprintf(stderr, "The connection server could not start\n");
+
+    if(forever){
+      std::printf("Serving the benchmark in %s, ports %d to %d\n", options.ip.c_str(),
+                  options.port, options.port + async_echo_port);
+      for(std::thread &running : servers) running.join();
+      return 0;
+    }
+    // The UDP server must be bound before the client sends its identifier
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  }
+
+  std::printf("%-24s %8s  (latencies in microseconds)\n", "case", "count");
+  bool succeeded{true};
+  if(tcp) succeeded &= ping_pong(options, SOCK_STREAM, false);
+  if(async) succeeded &= ping_pong(options, SOCK_STREAM, true);
+  if(udp) succeeded &= ping_pong(options, SOCK_DGRAM, false);
+  if(bulk_case) succeeded &= bulk(options);
+  if(connect_case) succeeded &= connection_setup(options);
+
+  if(!succeeded){
+    // The server of a case that failed could still be waiting for its client
+    for(std::thread &running : servers) running.detach();
+    std::exit(1);
+  }
+  for(std::thread &running : servers) running.join();
+  acceptor.disconnect();
+  return 0;
+}
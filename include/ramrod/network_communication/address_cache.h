@@ -0,0 +1,66 @@
+#ifndef RAMROD_NETWORK_COMMUNICATION_ADDRESS_CACHE_H
+#define RAMROD_NETWORK_COMMUNICATION_ADDRESS_CACHE_H
+
+#include <chrono>        // for steady_clock
+#include <netdb.h>       // for addrinfo
+#include <string>        // for string
+#include <sys/un.h>      // for sockaddr_un
+
+namespace ramrod {
+  namespace network_communication {
+    /**
+     * @brief Keeps the result of `getaddrinfo` so the reconnection intents do not resolve
+     *        the same host name again and again
+     *
+     * The "unix:" addresses (see `local_prefix`) are not resolved, they produce one
+     * `AF_UNIX` address (only for `SOCK_STREAM`). It is not thread-safe, every `client`
+     * and `server` owns one that is only used by its connecting thread.
+     */
+    class address_cache
+    {
+    public:
+      address_cache();
+      ~address_cache();
+      address_cache(const address_cache&) = delete;
+      address_cache &operator=(const address_cache&) = delete;
+      /**
+       * @brief Discards the resolved addresses, the next `resolve()` calls `getaddrinfo`
+       */
+      void clear();
+      /**
+       * @brief Getting the addresses of a host, they are resolved again only when the
+       *        host, port, type or flags change or when they expired
+       *
+       * @param host        IP address or host name
+       * @param port        Port number
+       * @param socket_type `SOCK_STREAM` or `SOCK_DGRAM`
+       * @param flags       `getaddrinfo` flags, like `AI_PASSIVE`
+       * @param ttl         Milliseconds that the addresses are reused, 0 resolves them
+       *                    always and a negative value never expires them
+       * @param status      Returns the `getaddrinfo` error code, 0 if it succeeded (a
+       *                    wrong "unix:" address returns `EAI_NONAME`, or `EAI_SOCKTYPE`
+       *                    if it is not `SOCK_STREAM`)
+       *
+       * @return List of addresses, it is valid until the next call or `clear()`, or
+       *         `nullptr` if they could not be resolved
+       */
+      const addrinfo *resolve(const std::string &host, const int port, const int socket_type,
+                              const int flags, const int ttl, int *status);
+
+    private:
+      std::string host_;
+      int port_;
+      int socket_type_;
+      int flags_;
+      addrinfo *results_;
+      std::chrono::steady_clock::time_point resolved_;
+
+      // The AF_UNIX address does not come from getaddrinfo and it is not freed
+      bool local_;
+      addrinfo local_info_;
+      sockaddr_un local_address_;
+    };
+  } // namespace: network_communication
+} // namespace: ramrod
+
+#endif // RAMROD_NETWORK_COMMUNICATION_ADDRESS_CACHE_H
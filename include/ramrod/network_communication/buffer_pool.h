@@ -0,0 +1,162 @@
+#ifndef RAMROD_NETWORK_COMMUNICATION_BUFFER_POOL_H
+#define RAMROD_NETWORK_COMMUNICATION_BUFFER_POOL_H
+
+#include <cstddef>       // for size_t
+#include <cstdint>       // for uint8_t
+#include <functional>    // for function
+#include <memory>        // for shared_ptr
+#include <mutex>         // for mutex
+#include <sys/types.h>   // for ssize_t
+#include <sys/uio.h>     // for iovec
+#include <vector>        // for vector
+
+namespace ramrod {
+  namespace network_communication {
+    /**
+     * @brief Alignment of every buffer of a `buffer_pool`, two buffers never share a cache
+     *        line so two threads could write them without false sharing
+     */
+    constexpr std::size_t cache_line_size{64};
+
+    class buffer_pool;
+
+    /**
+     * @brief Move-only handle to one buffer of a `buffer_pool`, the buffer returns to its
+     *        pool when the lease is destroyed or `release()` is called
+     *
+     * The lease keeps the pool's memory alive, so it could outlive the `buffer_pool` object.
+     */
+    class buffer_lease
+    {
+    public:
+      /**
+       * @brief Creates an empty lease, `is_valid()` will return `false`
+       */
+      buffer_lease();
+      buffer_lease(buffer_lease &&other) noexcept;
+      buffer_lease &operator=(buffer_lease &&other) noexcept;
+      buffer_lease(const buffer_lease&) = delete;
+      buffer_lease &operator=(const buffer_lease&) = delete;
+      ~buffer_lease();
+      /**
+       * @brief Getting the size of the buffer
+       *
+       * @return Number of bytes that could be written in `data()`
+       */
+      std::size_t capacity() const;
+      /**
+       * @brief Getting the memory of the buffer
+       *
+       * @return Pointer aligned to `cache_line_size`, `nullptr` if the lease is empty
+       */
+      std::uint8_t *data() const;
+      /**
+       * @brief Checks if the lease has a buffer
+       *
+       * @return `false` after being moved or released
+       */
+      bool is_valid() const;
+      /**
+       * @brief Returns the buffer to its pool, the lease becomes empty
+       */
+      void release();
+      /**
+       * @brief Getting the number of bytes that contain data, set by the function that
+       *        filled the buffer
+       *
+       * @return Number of used bytes, never bigger than `capacity()`
+       */
+      std::size_t size() const;
+      /**
+       * @brief Setting the number of bytes that contain data
+       *
+       * @param new_size Number of used bytes, bigger values are changed to `capacity()`
+       */
+      void size(const std::size_t new_size);
+
+    private:
+      friend class buffer_pool;
+      struct shared;
+
+      buffer_lease(const std::shared_ptr<shared> &pool, std::uint8_t *data,
+                   const std::size_t capacity);
+
+      std::shared_ptr<shared> pool_;
+      std::uint8_t *data_;
+      std::size_t capacity_;
+      std::size_t size_;
+    };
+
+    /**
+     * @brief Pool of fixed-size buffers that are reused, after the first buffers are
+     *        created there are no more allocations while the number of leased buffers does
+     *        not grow
+     *
+     * The buffers are taken from big slabs mapped with `mmap()`, every buffer starts at a
+     * multiple of `cache_line_size`. The pool could be bound to a NUMA node, then its pages
+     * are placed in the memory of that node when they are touched for the first time.
+     * All the functions are thread-safe.
+     */
+    class buffer_pool
+    {
+    public:
+      /**
+       * @brief Creates a pool and its first slab
+       *
+       * @param buffer_size Size in bytes of every buffer
+       * @param buffers     Number of buffers of every slab, a new slab is mapped when all
+       *                    the buffers are leased, values smaller than 1 will be changed to 1
+       * @param numa_node   NUMA node where the memory should be placed, a negative value
+       *                    lets the kernel decide
+       */
+      explicit buffer_pool(const std::size_t buffer_size, const std::size_t buffers = 64,
+                           const int numa_node = -1);
+      buffer_pool(const buffer_pool&) = delete;
+      buffer_pool &operator=(const buffer_pool&) = delete;
+      /**
+       * @brief Leases a buffer, a new slab is mapped if all of them are leased
+       *
+       * @return Lease of the buffer, it is empty if the memory could not be mapped
+       */
+      buffer_lease acquire();
+      /**
+       * @brief Getting the number of buffers that are not leased
+       *
+       * @return Number of free buffers
+       */
+      std::size_t available() const;
+      /**
+       * @brief Getting the size in bytes of every buffer
+       *
+       * @return Buffer size
+       */
+      std::size_t buffer_size() const;
+      /**
+       * @brief Getting the total number of buffers, leased or not
+       *
+       * @return Number of buffers of all the slabs
+       */
+      std::size_t size() const;
+      /**
+       * @brief Getting the memory of all the slabs mapped until now, for example to
+       *        register it in an `io_ring`
+       *
+       * @return One element per slab, the slabs are never unmapped while the pool or any
+       *         lease exists
+       */
+      std::vector<iovec> slabs() const;
+
+    private:
+      std::shared_ptr<buffer_lease::shared> shared_;
+    };
+
+    /**
+     * @brief Function called by the worker thread when a receiving task that uses a
+     *        `buffer_pool` finishes, it receives the leased buffer (with its `size()` set
+     *        to the received bytes) and the same value that `operation::get()` returns
+     */
+    using lease_completion = std::function<void(buffer_lease buffer, const ssize_t result)>;
+  } // namespace: network_communication
+} // namespace: ramrod
+
+#endif // RAMROD_NETWORK_COMMUNICATION_BUFFER_POOL_H
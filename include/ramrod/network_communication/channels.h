@@ -0,0 +1,192 @@
+#ifndef RAMROD_NETWORK_COMMUNICATION_CHANNELS_H
+#define RAMROD_NETWORK_COMMUNICATION_CHANNELS_H
+
+#include <array>         // for array
+#include <cstddef>       // for size_t
+#include <cstdint>       // for uint8_t, uint32_t
+#include <deque>         // for deque
+#include <functional>    // for function
+#include <mutex>         // for mutex
+#include <sys/uio.h>     // for iovec
+#include <vector>        // for vector
+
+#include "ramrod/network_communication/message_buffer.h"
+
+namespace ramrod {
+  namespace network_communication {
+    /**
+     * @brief Number of logical channels of one connection, they are numbered from 0
+     */
+    constexpr std::size_t max_channels{256};
+    /**
+     * @brief Number of priorities, 0 is the most urgent one
+     */
+    constexpr std::size_t channel_priorities{8};
+    /**
+     * @brief Biggest part of a message sent at once, a more urgent message waits at most
+     *        for one chunk (and the bytes already in the socket's sending buffer)
+     */
+    constexpr std::size_t channel_chunk_size{16 * 1024};
+    /**
+     * @brief Bytes added to every chunk after the message's header: the channel and the
+     *        flags that mark the first and the last chunk of a message
+     */
+    constexpr std::size_t channel_header_size{2};
+
+    /**
+     * @brief Function called for every complete message of a channel, `message` is only
+     *        valid until the function returns
+     */
+    using channel_handler = std::function<void(const std::uint8_t channel, const void *message,
+                                                const std::size_t size)>;
+
+    /**
+     * @brief Messages of several channels waiting to be sent, the writer always takes the
+     *        next chunk of the most urgent one
+     *
+     * Every priority has its own queue of messages (a lane) and the messages are split
+     * into chunks of `channel_chunk_size` bytes, so a small urgent message is sent between
+     * two chunks of a big one instead of waiting until it is completely sent. Every chunk
+     * is a message of `message_buffer` whose first bytes tell its channel, see
+     * `channel_assembler`. The messages of one channel are always sent in order, a message
+     * waits in the front of its lane while an older one of its channel is in another lane.
+     */
+    class channel_scheduler
+    {
+    public:
+      /**
+       * @brief Maximum number of elements written by `next()`
+       */
+      static constexpr std::size_t max_parts{2};
+
+      /**
+       * @brief Creates an empty scheduler, all the channels have priority 0
+       *
+       * @param max_bytes Limit of bytes waiting to be sent
+       */
+      explicit channel_scheduler(const std::size_t max_bytes = 64 * 1024 * 1024);
+      channel_scheduler(const channel_scheduler&) = delete;
+      channel_scheduler &operator=(const channel_scheduler&) = delete;
+      /**
+       * @brief Adds a message, it is copied so the buffer could be reused immediately
+       *
+       * @param channel Channel of the message
+       * @param buffer  Message to be sent
+       * @param size    Size of the message
+       * @param start   Returns `true` if the writer was not working, then the caller must
+       *                start it, the writer calls `next()` until it returns 0
+       *
+       * @return `false` if the message does not fit in the limit of bytes (`errno` will be
+       *         `ENOBUFS`)
+       */
+      bool add(const std::uint8_t channel, const void *buffer, const std::size_t size,
+               bool *start);
+      /**
+       * @brief Getting the number of bytes waiting to be sent
+       *
+       * @return Bytes added and not sent yet
+       */
+      std::size_t bytes() const;
+      /**
+       * @brief Takes the next chunk, only called by the writer
+       *
+       * @param parts Array of at least `max_parts` elements where the chunk is written,
+       *              they are valid until `sent()`
+       *
+       * @return Number of elements written in `parts`, 0 if there is nothing to send and
+       *         the next `add()` will ask for a new writer
+       */
+      std::size_t next(iovec *parts);
+      /**
+       * @brief Getting the priority of a channel
+       *
+       * @param channel Channel to read
+       *
+       * @return Its priority, 0 is the most urgent one
+       */
+      std::uint8_t priority(const std::uint8_t channel) const;
+      /**
+       * @brief Setting the priority of a channel, its queued messages keep the old one and
+       *        the new ones are sent after them
+       *
+       * @param channel      Channel to change
+       * @param new_priority New priority, smaller than `channel_priorities`
+       *
+       * @return `false` if the priority is not valid (and `errno` will be `EINVAL`)
+       */
+      bool priority(const std::uint8_t channel, const std::uint8_t new_priority);
+      /**
+       * @brief Indicates that the chunk returned by `next()` was sent, only called by the
+       *        writer
+       *
+       * @param failed `true` if it could not be sent, then the rest of its message is
+       *               discarded
+       */
+      void sent(const bool failed);
+
+    private:
+      struct pending {
+        std::uint8_t channel;
+        // Position in its channel, compared with oldest_ to keep the channel in order
+        std::uint32_t sequence;
+        std::vector<std::uint8_t> data;
+        std::size_t offset;
+      };
+
+      mutable std::mutex mutex_;
+      std::array<std::deque<pending>, channel_priorities> lanes_;
+      std::array<std::uint8_t, max_channels> priorities_;
+      // Sequence of the next message of every channel and of its oldest one not sent
+      std::array<std::uint32_t, max_channels> sequences_;
+      std::array<std::uint32_t, max_channels> oldest_;
+      std::size_t bytes_;
+      std::size_t max_bytes_;
+      bool writing_;
+      // Chunk returned by next(), its lane and its size
+      std::size_t lane_;
+      std::size_t chunk_;
+      std::uint8_t header_[message_buffer::header_size + channel_header_size];
+    };
+
+    /**
+     * @brief Joins the chunks sent by a `channel_scheduler` into the messages of every
+     *        channel
+     *
+     * A message with only one chunk is given to the handler without copying it, the
+     * others are copied into a buffer of their channel until their last chunk arrives.
+     */
+    class channel_assembler
+    {
+    public:
+      /**
+       * @brief Creates an assembler without incomplete messages
+       *
+       * @param max_message_size Biggest message that could be joined
+       */
+      explicit channel_assembler(const std::size_t max_message_size = 64 * 1024 * 1024);
+      /**
+       * @brief Adds one chunk received with `message_buffer`
+       *
+       * @param chunk   Received chunk, including the channel's header
+       * @param size    Size of the chunk
+       * @param handler Function called if the chunk completes a message
+       *
+       * @return 1 if a message was completed, 0 if more chunks are needed, or -1 if the
+       *         chunk is not valid (`errno` will be `EPROTO`) or the message is bigger than
+       *         the maximum (`EMSGSIZE`), then that message is discarded
+       */
+      int add(const std::uint8_t *chunk, const std::uint32_t size,
+              const channel_handler &handler);
+      /**
+       * @brief Discards all the incomplete messages
+       */
+      void clear();
+
+    private:
+      std::array<std::vector<std::uint8_t>, max_channels> partial_;
+      std::size_t max_message_size_;
+    };
+  } // namespace: network_communication
+} // namespace: ramrod
+
+#endif // RAMROD_NETWORK_COMMUNICATION_CHANNELS_H
@@ -0,0 +1,156 @@
+#ifndef RAMROD_NETWORK_COMMUNICATION_COMPRESSION_H
+#define RAMROD_NETWORK_COMMUNICATION_COMPRESSION_H
+
+#include <cstddef>       // for size_t
+#include <cstdint>       // for uint8_t, uint32_t
+#include <sys/uio.h>     // for iovec
+#include <vector>        // for vector
+
+#ifdef RAMROD_NETWORK_ZSTD
+struct ZSTD_CCtx_s;
+struct ZSTD_DCtx_s;
+#endif
+
+namespace ramrod {
+  namespace network_communication {
+    /**
+     * @brief Algorithms that compress the messages of `send_message()`, only the ones
+     *        enabled when compiling are available (`RAMROD_NETWORK_LZ4` and
+     *        `RAMROD_NETWORK_ZSTD`)
+     */
+    enum class compression_algorithm : std::uint8_t {
+      none = 0,
+      // Fast, for links where the CPU still matters
+      lz4  = 1,
+      // Better ratio, for the slowest links
+      zstd = 2
+    };
+
+    struct compression_options {
+      // Preferred algorithm, `none` does not negotiate anything with the other device
+      compression_algorithm algorithm{compression_algorithm::none};
+      // Smaller messages are sent uncompressed, compressing them saves almost nothing
+      std::size_t threshold{256};
+      // 0 is the default of the algorithm, bigger is smaller and slower for zstd and
+      // bigger is faster (the acceleration) for LZ4
+      int level{0};
+    };
+
+    /**
+     * @brief Bytes added before every message when an algorithm was negotiated: the
+     *        algorithm and, if it is compressed, the size of the original message
+     */
+    constexpr std::size_t compression_header_size{5};
+
+    /**
+     * @brief Compresses and decompresses messages reusing the same contexts and buffers
+     *
+     * One message is compressed and another one decompressed at the same time at most,
+     * the caller must serialize the sending and the receiving threads separately.
+     */
+    class compression_context
+    {
+    public:
+      compression_context();
+      ~compression_context();
+      compression_context(const compression_context&) = delete;
+      compression_context &operator=(const compression_context&) = delete;
+      /**
+       * @brief Getting the current algorithm
+       *
+       * @return Algorithm used by `compress()`
+       */
+      compression_algorithm algorithm() const;
+      /**
+       * @brief Selects the algorithm for the next messages, its contexts are created only
+       *        once and kept until it is destroyed
+       *
+       * @param new_algorithm Algorithm of `compress()`, `decompress()` accepts all of them
+       * @param level         See `compression_options::level`
+       *
+       * @return `false` if the algorithm was not compiled (and `errno` will be
+       *         `EPROTONOSUPPORT`) or its context could not be created (`ENOMEM`)
+       */
+      bool algorithm(const compression_algorithm new_algorithm, const int level = 0);
+      /**
+       * @brief Compresses a message, if it is smaller than the threshold or the result is
+       *        not smaller then it is sent as it is
+       *
+       * @param data      Message to compress
+       * @param size      Size of the message
+       * @param threshold Minimum size to compress
+       * @param parts     Array of two elements where the message is written: the header and
+       *                  the data, they are valid until the next `compress()`
+       *
+       * @return `false` on error (and `errno` will be set accordingly), the message could
+       *         not be compressed
+       */
+      bool compress(const void *data, const std::size_t size, const std::size_t threshold,
+                    iovec *parts);
+      /**
+       * @brief Decompresses a message written by `compress()` in the other device
+       *
+       * @param message   Received message, including the header
+       * @param size      Size of the message
+       * @param max_size  Biggest accepted size of the original message
+       * @param data      Returns the original message, it points inside `message` if it
+       *                  was not compressed, it is valid until the next `decompress()`
+       * @param data_size Returns the size of the original message
+       *
+       * @return `false` if the message is not valid (and `errno` will be `EPROTO`), its
+       *         algorithm was not compiled (`EPROTONOSUPPORT`) or it is too big (`EMSGSIZE`)
+       */
+      bool decompress(const std::uint8_t *message, const std::uint32_t size,
+                      const std::size_t max_size, const std::uint8_t **data,
+                      std::size_t *data_size);
+      /**
+       * @brief Getting if an algorithm was compiled
+       *
+       * @param algorithm Algorithm to check
+       *
+       * @return `true` if it is available, `none` is always available
+       */
+      static bool available(const compression_algorithm algorithm);
+
+    private:
+      compression_algorithm algorithm_;
+      int level_;
+      std::uint8_t header_[compression_header_size];
+#ifdef RAMROD_NETWORK_LZ4
+      // State of LZ4_compress_fast_extState(), the decompression does not need one
+      std::vector<char> lz4_state_;
+#endif
+#ifdef RAMROD_NETWORK_ZSTD
+      ZSTD_CCtx_s *zstd_compression_;
+      ZSTD_DCtx_s *zstd_decompression_;
+#endif
+      // Reused by every message, they only grow
+      std::vector<std::uint8_t> compressed_;
+      std::vector<std::uint8_t> decompressed_;
+    };
+
+    /**
+     * @brief Exchanges the compression algorithms with the other device just after
+     *        connecting, both of them must call it before sending any message
+     *
+     * Every device sends its preferred algorithm and the ones it has available, the one
+     * preferred by the client is used if both have it, otherwise the one of the server,
+     * otherwise the messages are not compressed.
+     *
+     * @param fd        Connected TCP socket, blocking or not
+     * @param options   Options of this device, its algorithm must not be `none`
+     * @param is_client `true` in the device that connected
+     * @param timeout   Maximum waiting time for the other device in milliseconds
+     * @param agreed    Returns the algorithm that both will use
+     *
+     * @return `false` on error (and `errno` will be set accordingly, `ETIMEDOUT` if the
+     *         other device did not answer, `EPROTO` if it does not negotiate compression),
+     *         then the connection must be closed
+     */
+    bool negotiate_compression(const int fd, const compression_options &options,
+                               const bool is_client, const int timeout,
+                               compression_algorithm *agreed);
+  } // namespace: network_communication
+} // namespace: ramrod
+
+#endif // RAMROD_NETWORK_COMMUNICATION_COMPRESSION_H
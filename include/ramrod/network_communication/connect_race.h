@@ -0,0 +1,45 @@
+#ifndef RAMROD_NETWORK_COMMUNICATION_CONNECT_RACE_H
+#define RAMROD_NETWORK_COMMUNICATION_CONNECT_RACE_H
+
+#include <atomic>        // for atomic
+#include <netdb.h>       // for addrinfo
+
+#include "ramrod/network_communication/socket_options.h"
+
+namespace ramrod {
+  namespace network_communication {
+    /**
+     * @brief Default time between two connection attempts, see `race_connect()`
+     */
+    constexpr int default_attempt_delay{250};
+
+    /**
+     * @brief Connects to the first reachable address of a `getaddrinfo` list ("happy
+     *        eyeballs", RFC 8305)
+     *
+     * The addresses are reordered so the families alternate (IPv6, IPv4, IPv6...) keeping
+     * the order of `getaddrinfo` inside every family. Every attempt is a non-blocking
+     * `connect`, and a new one starts after `attempt_delay` milliseconds, or immediately
+     * if the previous one failed, while the older ones keep running. The first one that
+     * succeeds wins and all the others are closed. In this way a dead address does not
+     * stall the connection for the whole kernel timeout.
+     *
+     * @param candidates    Result of `getaddrinfo`
+     * @param options       Options applied to every socket before connecting
+     * @param attempt_delay Milliseconds between the start of two attempts
+     * @param timeout       Maximum time in milliseconds for the whole race, a negative
+     *                      value waits until every attempt fails
+     * @param cancel        Optional flag that stops the race when it becomes `true`, it
+     *                      is checked at least every 50 milliseconds
+     *
+     * @return The connected socket in blocking mode, or -1 on error (and `errno` will be
+     *         set accordingly, `ETIMEDOUT` if the time expired, `ECANCELED` if it was
+     *         cancelled, or the error of the last failed attempt)
+     */
+    int race_connect(const addrinfo *candidates, const socket_options &options,
+                     const int attempt_delay = default_attempt_delay, const int timeout = -1,
+                     const std::atomic<bool> *cancel = nullptr);
+  } // namespace: network_communication
+} // namespace: ramrod
+
+#endif // RAMROD_NETWORK_COMMUNICATION_CONNECT_RACE_H
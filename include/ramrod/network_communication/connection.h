@@ -0,0 +1,222 @@
+#ifndef RAMROD_NETWORK_COMMUNICATION_CONNECTION_H
+#define RAMROD_NETWORK_COMMUNICATION_CONNECTION_H
+
+#include <cstddef>       // for size_t
+#include <cstdint>       // for uint32_t
+#include <string>        // for string
+#include <sys/socket.h>  // for sockaddr, sockaddr_storage, socklen_t, MSG_NOSIGNAL
+#include <sys/types.h>   // for ssize_t
+#include <sys/uio.h>     // for iovec
+
+#include "ramrod/network_communication/message_buffer.h"
+#include "ramrod/network_communication/socket_options.h"
+
+namespace ramrod {
+  namespace network_communication {
+    /**
+     * @brief One connected TCP (or local) socket, it owns the file descriptor and closes it
+     *        when destroyed
+     *
+     * It is only movable, so there is always one owner and it could be kept in a
+     * `std::vector` or given to another thread without locks. It does not start any
+     * thread, all the functions are executed by the caller, and it has its own buffer for
+     * the messages of `send_message()`. One thread could send while another one receives,
+     * but two threads must not send (or receive) at the same time.
+     *
+     * They are created by `connect()` or by `listener::accept()`.
+     */
+    class connection
+    {
+    public:
+      /**
+       * @brief Creates an empty connection, `is_valid()` returns `false`
+       */
+      connection();
+      /**
+       * @brief Takes the ownership of a connected socket
+       *
+       * @param fd               Connected socket, it is closed by this object
+       * @param peer             Address of the other device, it could be `nullptr`
+       * @param peer_length      Size of `peer`
+       * @param max_message_size Biggest message that `receive_message()` accepts
+       */
+      explicit connection(const int fd, const sockaddr *peer = nullptr,
+                          const socklen_t peer_length = 0,
+                          const std::size_t max_message_size = 65536);
+      ~connection();
+      connection(connection &&other) noexcept;
+      connection &operator=(connection &&other) noexcept;
+      connection(const connection&) = delete;
+      connection &operator=(const connection&) = delete;
+      /**
+       * @brief Closes the socket, the object becomes empty
+       *
+       * @return `false` if it was already empty or `close()` failed (and `errno` will be
+       *         set accordingly)
+       */
+      bool close();
+      /**
+       * @brief Connects to a TCP server, racing all the addresses of the host (see
+       *        `race_connect()`)
+       *
+       * @param ip      IP address or host name, or "unix:" followed by the path of a local
+       *                socket (see `local_prefix`), then the port is ignored
+       * @param port    Port number of the server
+       * @param options Options applied to the socket before connecting
+       * @param timeout Maximum time in milliseconds, a negative value waits until every
+       *                address failed
+       *
+       * @return The connection, it is empty if it failed (and `errno` will be set
+       *         accordingly, `EHOSTUNREACH` if the host could not be resolved)
+       */
+      static connection connect(const std::string &ip, const int port,
+                                const socket_options &options = socket_options(),
+                                const int timeout = -1);
+      /**
+       * @brief Getting the socket, it is still owned by this object
+       *
+       * @return The file descriptor, or -1 if it is empty
+       */
+      int fd() const;
+      /**
+       * @brief Getting the time that one intent of sending or receiving waits for the socket
+       *
+       * @return Waiting time in milliseconds, default is 1000
+       */
+      int io_timeout() const;
+      /**
+       * @brief Setting the time that one intent of sending or receiving waits for the socket
+       *
+       * @param timeout_in_milliseconds New waiting time, a negative value waits forever
+       */
+      void io_timeout(const int timeout_in_milliseconds);
+      /**
+       * @brief Indicates if it owns a socket
+       *
+       * @return `false` if it is empty or it was moved
+       */
+      bool is_valid() const;
+      /**
+       * @brief Getting the biggest message that `receive_message()` accepts
+       *
+       * @return Maximum size in bytes, default is 65536
+       */
+      std::size_t max_message_size();
+      /**
+       * @brief Setting the biggest message that `receive_message()` accepts
+       *
+       * @param new_max_message_size New maximum size in bytes
+       *
+       * @return `false` if the value is 0
+       */
+      bool max_message_size(const std::size_t new_max_message_size);
+      /**
+       * @brief Getting the number of failed intents before a transfer fails
+       *
+       * @return Maximum intents, default is 10
+       */
+      std::uint32_t max_intents() const;
+      /**
+       * @brief Setting the number of failed intents before a transfer fails
+       *
+       * @param new_max_intents New maximum intents
+       */
+      void max_intents(const std::uint32_t new_max_intents);
+      /**
+       * @brief Getting the address of the other device
+       *
+       * @param address Returns the address
+       * @param length  Returns the size of the address
+       *
+       * @return `false` if it is unknown
+       */
+      bool peer_address(sockaddr_storage *address, socklen_t *length) const;
+      /**
+       * @brief Receives the available data, the same as `client::receive()`
+       *
+       * @return Number of bytes received, 0 if the other device disconnected, or -1 on
+       *         error (and `errno` will be set accordingly)
+       */
+      ssize_t receive(void *buffer, const std::size_t size, const int flags = 0);
+      /**
+       * @brief Receives exactly `size` bytes, the same as `client::receive_all()`
+       *
+       * @return Number of bytes received, 0 if the other device disconnected, or -1 on
+       *         error (and `errno` will be set accordingly)
+       */
+      ssize_t receive_all(void *buffer, const std::size_t size, bool *breaker = nullptr,
+                          const int flags = 0);
+      /**
+       * @brief Receives one message sent with `send_message()`, the same as
+       *        `client::receive_message()`
+       *
+       * @return Size of the message, 0 if the other device disconnected, or -1 on error
+       *         (and `errno` will be set accordingly, `EMSGSIZE` if it does not fit)
+       */
+      ssize_t receive_message(void *buffer, const std::size_t size, bool *breaker = nullptr,
+                              const int flags = 0);
+      /**
+       * @brief Receives all the complete messages that arrived, the same as
+       *        `client::receive_messages()`
+       *
+       * @return Number of messages handled, 0 if the other device disconnected, or -1 on
+       *         error (and `errno` will be set accordingly)
+       */
+      int receive_messages(const message_handler &handler, bool *breaker = nullptr,
+                           const int flags = 0);
+      /**
+       * @brief Gives up the ownership of the socket without closing it, the object becomes
+       *        empty
+       *
+       * @return The file descriptor, or -1 if it was empty
+       */
+      int release();
+      /**
+       * @brief Sends as much as the socket accepts, the same as `client::send()`
+       *
+       * @return Number of bytes sent, 0 if the other device disconnected, or -1 on error
+       *         (and `errno` will be set accordingly)
+       */
+      ssize_t send(const void *buffer, const std::size_t size, const int flags = MSG_NOSIGNAL);
+      /**
+       * @brief Sends exactly `size` bytes, the same as `client::send_all()`
+       *
+       * @return Number of bytes sent, 0 if the other device disconnected, or -1 on error
+       *         (and `errno` will be set accordingly)
+       */
+      ssize_t send_all(const void *buffer, const std::size_t size, bool *breaker = nullptr,
+                       const int flags = MSG_NOSIGNAL);
+      /**
+       * @brief Sends all the bytes of several buffers, the same as
+       *        `client::send_all(const iovec*, const std::size_t, bool*, const int)`
+       *
+       * @return Number of bytes sent, 0 if the other device disconnected, or -1 on error
+       *         (and `errno` will be set accordingly)
+       */
+      ssize_t send_all(const iovec *buffers, const std::size_t count, bool *breaker = nullptr,
+                       const int flags = MSG_NOSIGNAL);
+      /**
+       * @brief Sends one message with its header, the same as `client::send_message()`
+       *
+       * @return Number of bytes of the message sent (without the header), 0 if the other
+       *         device disconnected, or -1 on error (and `errno` will be set accordingly)
+       */
+      ssize_t send_message(const void *buffer, const std::uint32_t size, bool *breaker = nullptr,
+                           const int flags = MSG_NOSIGNAL);
+
+    private:
+      int next_message(const std::uint8_t **message, std::uint32_t *size, bool *breaker,
+                       const int flags);
+      bool retry(const short events, std::uint32_t *error_counter);
+
+      int fd_;
+      sockaddr_storage peer_;
+      socklen_t peer_length_;
+      int io_timeout_;
+      std::uint32_t max_intents_;
+      message_buffer messages_;
+    };
+  } // namespace: network_communication
+} // namespace: ramrod
+
+#endif // RAMROD_NETWORK_COMMUNICATION_CONNECTION_H
@@ -0,0 +1,277 @@
+#ifndef RAMROD_NETWORK_COMMUNICATION_CONNECTION_METRICS_H
+#define RAMROD_NETWORK_COMMUNICATION_CONNECTION_METRICS_H
+
+#include <array>         // for array
+#include <atomic>        // for atomic
+#include <cstddef>       // for size_t
+#include <cstdint>       // for uint64_t
+#include <string>        // for string
+#include <sys/types.h>   // for ssize_t
+#include <vector>        // for vector
+
+namespace ramrod {
+  namespace network_communication {
+    /**
+     * @brief Copy of a `latency_histogram`, all the values are in nanoseconds
+     */
+    struct histogram_snapshot {
+      // Number of measurements in every bucket, see `latency_histogram::lowest()`
+      std::vector<std::uint64_t> counts;
+      // Number of measurements
+      std::uint64_t count{0};
+      // Sum of all the measurements
+      std::uint64_t total{0};
+      // Smallest and biggest measurements, both are 0 if there is none
+      std::uint64_t minimum{0};
+      std::uint64_t maximum{0};
+
+      /**
+       * @brief Calculates the average of the measurements
+       *
+       * @return The average, 0 if there are no measurements
+       */
+      double mean() const;
+      /**
+       * @brief Finds the value below which a fraction of the measurements are
+       *
+       * @param fraction Value between 0 and 1, e.g. 0.99 for the 99th percentile
+       *
+       * @return The highest value of the bucket that contains the percentile (limited by
+       *         `maximum`), its relative error is smaller than 1/32
+       */
+      std::uint64_t percentile(const double fraction) const;
+    };
+
+    /**
+     * @brief Histogram of latencies that any thread could update without locks, similar
+     *        to an HDR histogram
+     *
+     * Every power of two is divided into 32 buckets of the same width, so every
+     * measurement is kept with about 3% of precision from 1 nanosecond to more than a
+     * minute, using a fixed array of counters that are incremented with relaxed atomics.
+     */
+    class latency_histogram
+    {
+    public:
+      /**
+       * @brief Number of linear buckets in every power of two, as a power of two too
+       */
+      static constexpr unsigned precision_bits{5};
+      /**
+       * @brief Biggest value stored in its own bucket, about 68 seconds, the bigger ones
+       *        are counted in the last bucket
+       */
+      static constexpr std::uint64_t highest{(std::uint64_t{1} << 36) - 1};
+      /**
+       * @brief Total number of buckets
+       */
+      static constexpr std::size_t buckets{(36 - precision_bits + 1) << precision_bits};
+
+      latency_histogram();
+      /**
+       * @brief Gets the bucket of a value
+       *
+       * @param value Measurement in nanoseconds
+       *
+       * @return Index of the bucket, smaller than `buckets`
+       */
+      static std::size_t bucket(const std::uint64_t value);
+      /**
+       * @brief Gets the smallest value counted in a bucket
+       *
+       * @param index Index of the bucket
+       *
+       * @return The smallest value in nanoseconds
+       */
+      static std::uint64_t lowest(const std::size_t index);
+      /**
+       * @brief Adds one measurement
+       *
+       * @param value Measurement in nanoseconds
+       */
+      void record(const std::uint64_t value);
+      /**
+       * @brief Removes all the measurements, the ones recorded at the same time by other
+       *        threads could be lost
+       */
+      void reset();
+      /**
+       * @brief Copies the current measurements
+       *
+       * @return The copy, other threads could change it while it is copied, so the total
+       *         count could differ slightly from the sum of the buckets
+       */
+      histogram_snapshot snapshot() const;
+
+    private:
+      std::array<std::atomic<std::uint64_t>, buckets> counts_;
+      std::atomic<std::uint64_t> count_;
+      std::atomic<std::uint64_t> total_;
+      std::atomic<std::uint64_t> minimum_;
+      std::atomic<std::uint64_t> maximum_;
+    };
+
+    /**
+     * @brief Copy of the counters of one connection, see `connection_metrics::snapshot()`
+     */
+    struct metrics_snapshot {
+      std::uint64_t bytes_sent{0};
+      std::uint64_t bytes_received{0};
+      // Successful calls of the send and receive functions
+      std::uint64_t sends{0};
+      std::uint64_t receives{0};
+      // Messages of send_message() and receive_message(s)(), and datagrams
+      std::uint64_t messages_sent{0};
+      std::uint64_t messages_received{0};
+      // Transfers that returned -1 after the retries
+      std::uint64_t send_errors{0};
+      std::uint64_t receive_errors{0};
+      // Iterations of the retry loops, after an error or a busy socket
+      std::uint64_t retries{0};
+      // Times that `max_reconnection_intents()` was reached, transferring or connecting
+      std::uint64_t exhausted_intents{0};
+      // Established connections and failed intents to connect
+      std::uint64_t connections{0};
+      std::uint64_t connection_failures{0};
+      // Durations of the transfers and the connections, only if `latencies()` is enabled
+      histogram_snapshot send_latency;
+      histogram_snapshot receive_latency;
+      histogram_snapshot connect_latency;
+
+      /**
+       * @brief Writes the counters with the text format of Prometheus, one value per line
+       *        and the latencies as a summary with the 50th, 90th, 99th and 99.9th
+       *        percentiles in seconds
+       *
+       * @param prefix Added to the name of every value, e.g. "ramrod_camera_"
+       *
+       * @return The text
+       */
+      std::string to_text(const std::string &prefix = "ramrod_") const;
+    };
+
+    /**
+     * @brief Counters and latencies of one connection, updated by the functions of
+     *        `client` and `server`
+     *
+     * All the counters are relaxed atomics and the sending and receiving ones are in
+     * different cache lines, so the threads that send and receive never invalidate each
+     * other's counters. Measuring the latencies reads the clock twice per call, so it is
+     * disabled by default.
+     */
+    class connection_metrics
+    {
+    public:
+      connection_metrics();
+      /**
+       * @brief Counts an established connection
+       *
+       * @param start Value returned by `start()` when connecting began
+       */
+      void connected(const std::uint64_t start);
+      /**
+       * @brief Counts a failed intent to connect
+       */
+      void connection_failed();
+      /**
+       * @brief Counts a transfer that failed after its retries
+       *
+       * @param sending   `true` if it was sending, `false` if it was receiving
+       * @param exhausted `true` if it failed because the maximum number of intents was
+       *                  reached
+       *
+       * @return Always `false`, so it could be used in the return statement
+       */
+      bool failed(const bool sending, const bool exhausted);
+      /**
+       * @brief Counts that the maximum number of intents to connect was reached
+       */
+      void intents_exhausted();
+      /**
+       * @brief Checks if the durations of the transfers are measured
+       *
+       * @return `true` if they are measured, default is `false`
+       */
+      bool latencies() const;
+      /**
+       * @brief Enables or disables measuring the durations of the transfers
+       *
+       * @param enable `true` to measure them
+       */
+      void latencies(const bool enable);
+      /**
+       * @brief Counts received messages
+       *
+       * @param count Number of messages
+       */
+      void messages_received(const std::uint64_t count = 1);
+      /**
+       * @brief Counts sent messages
+       *
+       * @param count Number of messages
+       */
+      void messages_sent(const std::uint64_t count = 1);
+      /**
+       * @brief Counts the result of a receiving function
+       *
+       * @param result Value returned by the function, only positive values are counted
+       * @param start  Value returned by `start()` before receiving
+       *
+       * @return `result`, so it could be used in the return statement
+       */
+      ssize_t received(const ssize_t result, const std::uint64_t start = 0);
+      /**
+       * @brief Sets all the counters and latencies to zero
+       */
+      void reset();
+      /**
+       * @brief Counts one iteration of a retry loop
+       */
+      void retried();
+      /**
+       * @brief Counts the result of a sending function
+       *
+       * @param result Value returned by the function, only positive values are counted
+       * @param start  Value returned by `start()` before sending
+       *
+       * @return `result`, so it could be used in the return statement
+       */
+      ssize_t sent(const ssize_t result, const std::uint64_t start = 0);
+      /**
+       * @brief Copies the current values
+       *
+       * @return The copy
+       */
+      metrics_snapshot snapshot() const;
+      /**
+       * @brief Gets the time when a measured operation starts
+       *
+       * @return Nanoseconds of the monotonic clock, or 0 if the latencies are disabled
+       */
+      std::uint64_t start() const;
+
+    private:
+      // Counters of one direction, every direction is updated by a different thread
+      struct alignas(64) direction {
+        std::atomic<std::uint64_t> bytes{0};
+        std::atomic<std::uint64_t> calls{0};
+        std::atomic<std::uint64_t> messages{0};
+        std::atomic<std::uint64_t> errors{0};
+        latency_histogram latency;
+      };
+
+      void count(direction *counters, const ssize_t result, const std::uint64_t start);
+
+      direction sending_;
+      direction receiving_;
+      alignas(64) std::atomic<bool> latencies_;
+      std::atomic<std::uint64_t> retries_;
+      std::atomic<std::uint64_t> exhausted_intents_;
+      std::atomic<std::uint64_t> connections_;
+      std::atomic<std::uint64_t> connection_failures_;
+      latency_histogram connect_latency_;
+    };
+  } // namespace: network_communication
+} // namespace: ramrod
+
+#endif // RAMROD_NETWORK_COMMUNICATION_CONNECTION_METRICS_H
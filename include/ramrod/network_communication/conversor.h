@@ -1,13 +1,21 @@
 #ifndef RAMROD_NETWORK_COMMUNICATION_CONVERSOR_H
 #define RAMROD_NETWORK_COMMUNICATION_CONVERSOR_H
 
-#include <cstdint>       // for uint32_t, uint16_t
+#include <cstddef>       // for size_t
+#include <cstdint>       // for uint64_t, uint32_t, uint16_t
+#include <cstring>       // for memcpy
 
 namespace ramrod {
   namespace network_communication {
     class conversor
     {
     public:
+      /**
+       * @brief Indicates if this machine already uses the network's endian type (big
+       *        endian), then all the conversions do nothing
+       */
+      static constexpr bool native_network_order{__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__};
+
       conversor() = default;
       /**
        * @brief Converting a 16 bit integer value stored in a big/little endian
@@ -17,7 +25,9 @@ namespace ramrod {
        *
        * @return The 16 bit `host_value` converted into the network's endian type
        */
-      std::uint16_t host_to_network(const std::uint16_t host_value);
+      static constexpr std::uint16_t host_to_network(const std::uint16_t host_value){
+        return native_network_order ? host_value : __builtin_bswap16(host_value);
+      }
       /**
        * @brief Converting a 32 bit integer value stored in a big/little endian
        *        machine into the network's endian type
@@ -26,7 +36,109 @@ namespace ramrod {
        *
        * @return The 32 bit `host_value` converted into the network's endian type
        */
-      std::uint32_t host_to_network(const std::uint32_t host_value);
+      static constexpr std::uint32_t host_to_network(const std::uint32_t host_value){
+        return native_network_order ? host_value : __builtin_bswap32(host_value);
+      }
+      /**
+       * @brief Converting a 64 bit integer value stored in a big/little endian
+       *        machine into the network's endian type
+       *
+       * @param host_value Unsigned 64 bit integer value to be converted
+       *
+       * @return The 64 bit `host_value` converted into the network's endian type
+       */
+      static constexpr std::uint64_t host_to_network(const std::uint64_t host_value){
+        return native_network_order ? host_value : __builtin_bswap64(host_value);
+      }
+      /**
+       * @brief Converting a float into the bits of its network representation
+       *
+       * @param host_value Float value to be converted
+       *
+       * @return The IEEE 754 bits of `host_value` in the network's endian type, decode
+       *         them with `network_to_float()`
+       */
+      static std::uint32_t host_to_network(const float host_value){
+        std::uint32_t bits;
+        std::memcpy(&bits, &host_value, sizeof(bits));
+        return host_to_network(bits);
+      }
+      /**
+       * @brief Converting a double into the bits of its network representation
+       *
+       * @param host_value Double value to be converted
+       *
+       * @return The IEEE 754 bits of `host_value` in the network's endian type, decode
+       *         them with `network_to_double()`
+       */
+      static std::uint64_t host_to_network(const double host_value){
+        std::uint64_t bits;
+        std::memcpy(&bits, &host_value, sizeof(bits));
+        return host_to_network(bits);
+      }
+      /**
+       * @brief Converting an array of 16 bit integers into the network's endian type
+       *
+       * Uses SIMD shuffles when the processor supports them (AVX2 or SSSE3 chosen at run
+       * time, NEON on ARM), and only copies the values when nothing must be converted.
+       *
+       * @param input  Values to be converted
+       * @param output Where the converted values are written, it could be `input` itself
+       *               but the arrays must not overlap otherwise
+       * @param count  Number of values
+       */
+      static void host_to_network(const std::uint16_t *input, std::uint16_t *output,
+                                  const std::size_t count);
+      /**
+       * @brief Converting an array of 32 bit integers into the network's endian type, see
+       *        `host_to_network(const std::uint16_t*, std::uint16_t*, const std::size_t)`
+       */
+      static void host_to_network(const std::uint32_t *input, std::uint32_t *output,
+                                  const std::size_t count);
+      /**
+       * @brief Converting an array of 64 bit integers into the network's endian type, see
+       *        `host_to_network(const std::uint16_t*, std::uint16_t*, const std::size_t)`
+       */
+      static void host_to_network(const std::uint64_t *input, std::uint64_t *output,
+                                  const std::size_t count);
+      /**
+       * @brief Converting an array of floats into the bits of their network
+       *        representation, see `host_to_network(const float)`
+       */
+      static void host_to_network(const float *input, std::uint32_t *output,
+                                  const std::size_t count);
+      /**
+       * @brief Converting an array of doubles into the bits of their network
+       *        representation, see `host_to_network(const double)`
+       */
+      static void host_to_network(const double *input, std::uint64_t *output,
+                                  const std::size_t count);
+      /**
+       * @brief Converting the network representation of a double into its value
+       *
+       * @param network_value IEEE 754 bits in the network's endian type
+       *
+       * @return The decoded double
+       */
+      static double network_to_double(const std::uint64_t network_value){
+        const std::uint64_t bits{network_to_host(network_value)};
+        double host_value;
+        std::memcpy(&host_value, &bits, sizeof(host_value));
+        return host_value;
+      }
+      /**
+       * @brief Converting the network representation of a float into its value
+       *
+       * @param network_value IEEE 754 bits in the network's endian type
+       *
+       * @return The decoded float
+       */
+      static float network_to_float(const std::uint32_t network_value){
+        const std::uint32_t bits{network_to_host(network_value)};
+        float host_value;
+        std::memcpy(&host_value, &bits, sizeof(host_value));
+        return host_value;
+      }
       /**
        * @brief Converting a 16 bit integer value stored in the network's endian type
        *        into the endian type that your computer uses
@@ -35,7 +147,9 @@ namespace ramrod {
        *
        * @return The 16 bit `host_value` converted into your computer's endian type
        */
-      std::uint16_t network_to_host(const std::uint16_t network_value);
+      static constexpr std::uint16_t network_to_host(const std::uint16_t network_value){
+        return host_to_network(network_value);
+      }
       /**
        * @brief Converting a 32 bit integer value stored in the network's endian type
        *        into the endian type that your computer uses
@@ -44,7 +158,50 @@ namespace ramrod {
        *
        * @return The 32 bit `host_value` converted into your computer's endian type
        */
-      std::uint32_t network_to_host(const std::uint32_t network_value);
+      static constexpr std::uint32_t network_to_host(const std::uint32_t network_value){
+        return host_to_network(network_value);
+      }
+      /**
+       * @brief Converting a 64 bit integer value stored in the network's endian type
+       *        into the endian type that your computer uses
+       *
+       * @param network_value Unsigned 64 bit integer value to be converted
+       *
+       * @return The 64 bit `host_value` converted into your computer's endian type
+       */
+      static constexpr std::uint64_t network_to_host(const std::uint64_t network_value){
+        return host_to_network(network_value);
+      }
+      /**
+       * @brief Converting an array of 16 bit integers from the network's endian type, see
+       *        `host_to_network(const std::uint16_t*, std::uint16_t*, const std::size_t)`
+       */
+      static void network_to_host(const std::uint16_t *input, std::uint16_t *output,
+                                  const std::size_t count);
+      /**
+       * @brief Converting an array of 32 bit integers from the network's endian type, see
+       *        `host_to_network(const std::uint16_t*, std::uint16_t*, const std::size_t)`
+       */
+      static void network_to_host(const std::uint32_t *input, std::uint32_t *output,
+                                  const std::size_t count);
+      /**
+       * @brief Converting an array of 64 bit integers from the network's endian type, see
+       *        `host_to_network(const std::uint16_t*, std::uint16_t*, const std::size_t)`
+       */
+      static void network_to_host(const std::uint64_t *input, std::uint64_t *output,
+                                  const std::size_t count);
+      /**
+       * @brief Converting an array of network representations into floats, see
+       *        `network_to_float()`
+       */
+      static void network_to_host(const std::uint32_t *input, float *output,
+                                  const std::size_t count);
+      /**
+       * @brief Converting an array of network representations into doubles, see
+       *        `network_to_double()`
+       */
+      static void network_to_host(const std::uint64_t *input, double *output,
+                                  const std::size_t count);
 
     private:
     };
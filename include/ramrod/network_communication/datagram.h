@@ -0,0 +1,38 @@
+#ifndef RAMROD_NETWORK_COMMUNICATION_DATAGRAM_H
+#define RAMROD_NETWORK_COMMUNICATION_DATAGRAM_H
+
+#include <cstddef>       // for size_t
+#include <sys/socket.h>  // for sockaddr_storage, socklen_t
+
+#include "ramrod/network_communication/timestamping.h"
+
+namespace ramrod {
+  namespace network_communication {
+    /**
+     * @brief Maximum number of datagrams transferred by one system call, bigger arrays are
+     *        sent in several calls and received in several `receive_datagrams()` calls
+     */
+    constexpr std::size_t max_datagram_batch{64};
+
+    /**
+     * @brief One element of the arrays used by `receive_datagrams()` and `send_datagrams()`
+     */
+    struct datagram {
+      // Memory where the datagram is received or that contains the datagram to send
+      void *buffer;
+      // Size in bytes of `buffer` when receiving, or of the datagram when sending
+      std::size_t size;
+      // Number of bytes actually received
+      std::size_t length;
+      // The datagram was bigger than `size` and the rest of it was discarded
+      bool truncated;
+      // Source address of the received datagram
+      sockaddr_storage address;
+      socklen_t address_length;
+      // When the kernel received it, see `socket_options::receive_timestamps`
+      packet_timestamp timestamp;
+    };
+  } // namespace: network_communication
+} // namespace: ramrod
+
+#endif // RAMROD_NETWORK_COMMUNICATION_DATAGRAM_H
@@ -0,0 +1,104 @@
+#ifndef RAMROD_NETWORK_COMMUNICATION_EVENT_LOOP_H
+#define RAMROD_NETWORK_COMMUNICATION_EVENT_LOOP_H
+
+#include <atomic>        // for atomic
+#include <cstdint>       // for uint32_t
+#include <functional>    // for function
+#include <thread>        // for thread
+
+#include "ramrod/network_communication/thread_affinity.h"
+
+namespace ramrod {
+  namespace network_communication {
+    class event_loop
+    {
+    public:
+      /**
+       * @brief Function called from the loop's thread every time a file descriptor
+       *        is ready, `events` contains the `epoll` flags that were triggered
+       */
+      using callback = std::function<void(const int fd, const std::uint32_t events)>;
+
+      event_loop();
+      ~event_loop();
+      /**
+       * @brief Adds a file descriptor to the list of watched descriptors
+       *
+       * @param fd     File descriptor to watch
+       * @param events `epoll` events to watch, for example: `EPOLLIN | EPOLLONESHOT`
+       *
+       * @return `false` if the loop is not created or `epoll_ctl` failed
+       */
+      bool add(const int fd, const std::uint32_t events);
+      /**
+       * @brief Indicates if the loop's thread is running
+       *
+       * @return `true` if the loop is waiting for events
+       */
+      bool is_running();
+      /**
+       * @brief Changes the watched events of a file descriptor, it is also used to
+       *        re-arm descriptors added with `EPOLLONESHOT`
+       *
+       * @param fd     File descriptor previously added
+       * @param events New `epoll` events to watch
+       *
+       * @return `false` if `epoll_ctl` failed
+       */
+      bool modify(const int fd, const std::uint32_t events);
+      /**
+       * @brief Stops watching a file descriptor, it does not close it
+       *
+       * @param fd File descriptor previously added
+       *
+       * @return `false` if `epoll_ctl` failed
+       */
+      bool remove(const int fd);
+      /**
+       * @brief Creates the `epoll` instance and starts waiting for events in a new thread
+       *
+       * @param on_event Function that is called for every triggered event
+       * @param cpu      CPU where the loop's thread will be pinned, a negative value lets
+       *                 the system decide
+       *
+       * @return `false` if the loop is already running or it could not be created
+       */
+      bool start(const callback &on_event, const int cpu = -1);
+      /**
+       * @brief Creates the `epoll` instance and starts waiting for events in a new thread
+       *        configured with `configure_current_thread()`
+       *
+       * @param on_event Function that is called for every triggered event
+       * @param options  CPUs, scheduling policy and name of the loop's thread
+       *
+       * @return `false` if the loop is already running, it was stopped by this same
+       *         callback, or it could not be created
+       */
+      bool start(const callback &on_event, const thread_options &options);
+      /**
+       * @brief Wakes up and finishes the loop's thread, no more callbacks will be called
+       *        after this returns
+       *
+       * The watched file descriptors are kept (and never closed) until the loop is started
+       * again, therefore `modify()` and `remove()` are still safe to call. It could be called
+       * from inside the callback, in that case the thread finishes after the callback
+       * returns and it is joined by the next `start()` (which fails if it is called from
+       * the same callback) or by the destructor.
+       */
+      void stop();
+
+    private:
+      void release();
+      void run();
+
+      int epoll_fd_;
+      int wake_fd_;
+      thread_options options_;
+      std::atomic<bool> running_;
+      callback callback_;
+      std::thread thread_;
+    };
+  } // namespace: network_communication
+} // namespace: ramrod
+
+#endif // RAMROD_NETWORK_COMMUNICATION_EVENT_LOOP_H
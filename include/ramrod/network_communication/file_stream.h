@@ -0,0 +1,100 @@
+#ifndef RAMROD_NETWORK_COMMUNICATION_FILE_STREAM_H
+#define RAMROD_NETWORK_COMMUNICATION_FILE_STREAM_H
+
+#include <cstddef>       // for size_t
+#include <functional>    // for function
+#include <sys/types.h>   // for off_t, ssize_t
+
+namespace ramrod {
+  namespace network_communication {
+    /**
+     * @brief Function called after every chunk of a file is sent, `total` is 0 when the
+     *        size is unknown (a pipe that is sent until its end)
+     */
+    using file_progress = std::function<void(const std::size_t sent, const std::size_t total)>;
+
+    /**
+     * @brief Biggest number of bytes sent by one `file_stream::send()`, so the progress is
+     *        reported and the cancellation is checked regularly
+     */
+    constexpr std::size_t file_chunk_size{1 << 20};
+
+    /**
+     * @brief Part of a file or a pipe that is sent to a socket without copying it through
+     *        user space
+     *
+     * Regular files and block devices are sent with `sendfile()` and pipes with
+     * `splice()`, both move the pages inside the kernel. The offset of the file
+     * descriptor is not changed for files, so the same file could be sent by several
+     * streams at the same time. `SIGPIPE` is blocked while sending, so a disconnected
+     * socket only returns `EPIPE`, the same as `MSG_NOSIGNAL`.
+     */
+    class file_stream
+    {
+    public:
+      file_stream();
+      /**
+       * @brief Getting if everything was sent
+       *
+       * @return `true` when `length` bytes were sent, or the end of the file or pipe was
+       *         reached
+       */
+      bool finished() const;
+      /**
+       * @brief Selects the part of the file that will be sent, the descriptor is not owned
+       *        and it must stay open until the stream finishes
+       *
+       * @param fd     File or pipe to send
+       * @param offset First byte of the file, it must be 0 for pipes
+       * @param length Number of bytes to send, 0 sends until the end of the file or pipe
+       *
+       * @return `false` if it is not a regular file, block device or pipe, or the offset is
+       *         not valid (and `errno` will be set accordingly, `EINVAL` or `ESPIPE`)
+       */
+      bool open(const int fd, const off_t offset = 0, const std::size_t length = 0);
+      /**
+       * @brief Sends the next chunk, up to `file_chunk_size` bytes
+       *
+       * @param socket_fd Connected socket
+       *
+       * @return The number of bytes sent, 0 at the end of the file or pipe, or -1 on error
+       *         (and `errno` will be set accordingly, `EAGAIN` if the socket is
+       *         non-blocking and full or a non-blocking pipe is empty, see `waiting_fd()`)
+       */
+      ssize_t send(const int socket_fd);
+      /**
+       * @brief Getting the number of bytes already sent
+       *
+       * @return Bytes sent since `open()`
+       */
+      std::size_t sent() const;
+      /**
+       * @brief Getting the number of bytes that will be sent
+       *
+       * @return Total bytes, or 0 if it sends until the end of a pipe or device
+       */
+      std::size_t total() const;
+      /**
+       * @brief Getting what must be waited for after a `send()` that failed with `EAGAIN`,
+       *        the socket is writable when the pipe was the empty one
+       *
+       * @param socket_fd Connected socket
+       * @param events    Returns the `poll` events to wait for in the returned descriptor
+       *
+       * @return The pipe if it was empty, otherwise the socket
+       */
+      int waiting_fd(const int socket_fd, short *events) const;
+
+    private:
+      int fd_;
+      off_t offset_;
+      std::size_t total_;
+      std::size_t sent_;
+      bool is_pipe_;
+      bool ended_;
+      bool source_empty_;
+    };
+  } // namespace: network_communication
+} // namespace: ramrod
+
+#endif // RAMROD_NETWORK_COMMUNICATION_FILE_STREAM_H
@@ -0,0 +1,262 @@
+#ifndef RAMROD_NETWORK_COMMUNICATION_IO_RING_H
+#define RAMROD_NETWORK_COMMUNICATION_IO_RING_H
+
+#include <cstddef>       // for size_t
+#include <cstdint>       // for uint32_t, uint64_t, uint16_t, int32_t
+#include <functional>    // for function
+#include <sys/types.h>   // for ssize_t
+#include <sys/uio.h>     // for iovec
+#include <vector>        // for vector
+
+#include "ramrod/network_communication/connection_metrics.h"
+
+struct io_uring_buf;
+struct io_uring_cqe;
+struct io_uring_sqe;
+
+namespace ramrod {
+  namespace network_communication {
+    /**
+     * @brief Function called by `receive_multishot()` for every received chunk, `data`
+     *        points to a buffer of the ring and it is only valid until the function returns
+     */
+    using data_handler = std::function<void(const void *data, const std::size_t size)>;
+
+    /**
+     * @brief Result of one operation of an `io_ring`
+     */
+    struct io_completion {
+      // Value given when the operation was prepared
+      std::uint64_t user_data;
+      // Bytes transferred, or a negative `errno` value
+      std::int32_t result;
+      // IORING_CQE_F_* flags, like IORING_CQE_F_MORE or IORING_CQE_F_BUFFER
+      std::uint32_t flags;
+    };
+
+    /**
+     * @brief Minimal io_uring instance built directly on the system calls (it does not need
+     *        liburing), compiled only with the CMake option `RAMROD_NETWORK_IO_URING`
+     *
+     * The operations are prepared in the submission queue without any system call and
+     * they are all sent to the kernel with one `submit()`. It is not thread-safe, every
+     * thread should use its own ring.
+     */
+    class io_ring
+    {
+    public:
+      /**
+       * @brief Creates the ring, check `is_valid()` afterwards
+       *
+       * @param entries Size of the submission queue, it is rounded up to a power of two
+       */
+      explicit io_ring(const unsigned int entries = 64);
+      ~io_ring();
+      io_ring(const io_ring&) = delete;
+      io_ring &operator=(const io_ring&) = delete;
+      /**
+       * @brief Reads the completed operations without making any system call
+       *
+       * @param completions Array where the results are written
+       * @param count       Size of the array
+       *
+       * @return Number of results written
+       */
+      std::size_t completions(io_completion *completions, const std::size_t count);
+      /**
+       * @brief Indicates if the ring was created, the kernel could not support it
+       *
+       * @return `false` if `io_uring_setup` failed (and `errno` is kept from it)
+       */
+      bool is_valid();
+      /**
+       * @brief Prepares the cancellation of all the operations with a user data
+       *
+       * @param target    User data of the operations to cancel
+       * @param user_data User data of the cancellation itself
+       *
+       * @return `false` if the submission queue is full, call `submit()` first
+       */
+      bool prepare_cancel(const std::uint64_t target, const std::uint64_t user_data);
+      /**
+       * @brief Prepares a `recv`
+       *
+       * @return `false` if the submission queue is full, call `submit()` first
+       */
+      bool prepare_receive(const int fd, void *buffer, const std::size_t size, const int flags,
+                           const std::uint64_t user_data);
+      /**
+       * @brief Prepares a multishot `recv`, it produces one completion for every received
+       *        chunk into a buffer chosen by the kernel from `provide_buffers()`, until an
+       *        error or until it runs out of buffers (then the last completion has no
+       *        `IORING_CQE_F_MORE` flag)
+       *
+       * @return `false` if the submission queue is full or no buffers were provided
+       */
+      bool prepare_receive_multishot(const int fd, const int flags, const std::uint64_t user_data);
+      /**
+       * @brief Prepares a `read` into a buffer registered with `register_buffers()`, the
+       *        kernel does not need to map the memory again
+       *
+       * @return `false` if the submission queue is full, call `submit()` first
+       */
+      bool prepare_read_fixed(const int fd, void *buffer, const std::size_t size,
+                              const std::uint16_t index, const std::uint64_t user_data);
+      /**
+       * @brief Prepares a `send`
+       *
+       * @return `false` if the submission queue is full, call `submit()` first
+       */
+      bool prepare_send(const int fd, const void *buffer, const std::size_t size,
+                        const int flags, const std::uint64_t user_data);
+      /**
+       * @brief Gives to the kernel the buffers used by the multishot receptions (a provided
+       *        buffer ring), only one set of buffers could be provided
+       *
+       * @param buffers Buffers, they must stay valid while the ring exists
+       * @param count   Number of buffers, at most 32768
+       *
+       * @return `false` on error (and `errno` will be set accordingly)
+       */
+      bool provide_buffers(const iovec *buffers, const std::size_t count);
+      /**
+       * @brief Gets the buffer of a multishot completion
+       *
+       * @param completion Completion with the `IORING_CQE_F_BUFFER` flag
+       *
+       * @return Pointer to the buffer, or `nullptr` if the completion has no buffer
+       */
+      void *provided_buffer(const io_completion &completion);
+      /**
+       * @brief Returns a buffer to the kernel after reading the data of a completion
+       *
+       * @param completion Completion with the `IORING_CQE_F_BUFFER` flag
+       */
+      void recycle(const io_completion &completion);
+      /**
+       * @brief Registers buffers for `prepare_read_fixed()`, for example the slabs of a
+       *        `buffer_pool`, the kernel keeps their pages mapped until they are unregistered
+       *
+       * @param buffers Buffers, the index of every one is used by the fixed operations
+       * @param count   Number of buffers
+       *
+       * @return `false` on error (and `errno` will be set accordingly), `EBUSY` if there
+       *         are buffers already registered
+       */
+      bool register_buffers(const iovec *buffers, const std::size_t count);
+      /**
+       * @brief Checks if a buffer is inside one of the registered buffers
+       *
+       * @param buffer Beginning of the memory
+       * @param size   Size of the memory
+       * @param index  Returns the index of the registered buffer that contains it
+       *
+       * @return `true` if the fixed operations could be used with it
+       */
+      bool registered(const void *buffer, const std::size_t size, std::uint16_t *index);
+      /**
+       * @brief Sends all the prepared operations to the kernel with one system call
+       *
+       * @param wait_for Number of completions to wait for, 0 does not wait
+       *
+       * @return Number of submitted operations, or -1 on error (and `errno` will be set
+       *         accordingly)
+       */
+      int submit(const unsigned int wait_for = 0);
+      /**
+       * @brief Removes the buffers registered with `register_buffers()`
+       *
+       * @return `false` on error (and `errno` will be set accordingly)
+       */
+      bool unregister_buffers();
+      /**
+       * @brief Waits until there is at least one completion and reads them
+       *
+       * @param completions Array where the results are written
+       * @param count       Size of the array
+       * @param timeout     Maximum waiting time in milliseconds, a negative value waits
+       *                    forever
+       *
+       * @return Number of results written, 0 if the time expired, or -1 on error (and
+       *         `errno` will be set accordingly)
+       */
+      int wait(io_completion *completions, const std::size_t count, const int timeout = -1);
+
+    private:
+      io_uring_sqe *next();
+      void release();
+
+      int fd_;
+      // Submission queue
+      void *sq_memory_;
+      std::size_t sq_size_;
+      unsigned int *sq_head_;
+      unsigned int *sq_tail_;
+      unsigned int sq_mask_;
+      unsigned int *sq_array_;
+      io_uring_sqe *sqes_;
+      std::size_t sqes_size_;
+      unsigned int pending_;
+      // Completion queue, it could share the memory with the submission queue
+      void *cq_memory_;
+      std::size_t cq_size_;
+      unsigned int *cq_head_;
+      unsigned int *cq_tail_;
+      unsigned int cq_mask_;
+      io_uring_cqe *cqes_;
+      // Provided buffers of the multishot receptions
+      io_uring_buf *buffer_ring_;
+      std::size_t buffer_ring_size_;
+      unsigned int buffer_mask_;
+      std::vector<iovec> provided_;
+      // Buffers of the fixed operations
+      std::vector<iovec> registered_;
+    };
+
+    /**
+     * @brief Receives `size` bytes from a connected socket with one submission per
+     *        reception, the registered memory is read with fixed operations
+     *
+     * The failed receptions are retried like `retry_transfer()` does.
+     *
+     * @param ring                    Ring used only by this thread while receiving
+     * @param fd                      Connected socket
+     * @param buffer                  Is a pointer to where the data will be received
+     * @param size                    Is the number of bytes you want to receive
+     * @param breaker                 Stops the loop when it becomes `true`
+     * @param flags                   The same flags as `recv`
+     * @param timeout_in_milliseconds Maximum waiting time of every retry
+     * @param max_intents             Intents allowed before failing
+     * @param metrics                 Optional counters of the retries and failures
+     *
+     * @return The number of bytes actually received, or 0 when the other device is
+     *         disconnected, or -1 on error (and `errno` will be set accordingly).
+     */
+    ssize_t ring_receive_all(io_ring *ring, const int fd, void *buffer, const std::size_t size,
+                             bool *breaker, const int flags, const int timeout_in_milliseconds,
+                             const std::uint32_t max_intents, connection_metrics *metrics);
+    /**
+     * @brief Sends `size` bytes to a connected socket with one submission per sending
+     *
+     * The failed sendings are retried like `retry_transfer()` does.
+     *
+     * @param ring                    Ring used only by this thread while sending
+     * @param fd                      Connected socket
+     * @param buffer                  Is a pointer to the data you want to send
+     * @param size                    Is the number of bytes you want to send
+     * @param breaker                 Stops the loop when it becomes `true`
+     * @param flags                   The same flags as `send`
+     * @param timeout_in_milliseconds Maximum waiting time of every retry
+     * @param max_intents             Intents allowed before failing
+     * @param metrics                 Optional counters of the retries and failures
+     *
+     * @return The number of bytes actually sent, or 0 when the other device is
+     *         disconnected, or -1 on error (and `errno` will be set accordingly).
+     */
+    ssize_t ring_send_all(io_ring *ring, const int fd, const void *buffer, const std::size_t size,
+                          bool *breaker, const int flags, const int timeout_in_milliseconds,
+                          const std::uint32_t max_intents, connection_metrics *metrics);
+  } // namespace: network_communication
+} // namespace: ramrod
+
+#endif // RAMROD_NETWORK_COMMUNICATION_IO_RING_H
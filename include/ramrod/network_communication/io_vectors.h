@@ -0,0 +1,73 @@
+#ifndef RAMROD_NETWORK_COMMUNICATION_IO_VECTORS_H
+#define RAMROD_NETWORK_COMMUNICATION_IO_VECTORS_H
+
+#include <cstddef>       // for size_t
+#include <sys/uio.h>     // for iovec
+#include <vector>        // for vector
+
+namespace ramrod {
+  namespace network_communication {
+    /**
+     * @brief Working copy of a list of buffers used by `sendmsg()` and `recvmsg()`
+     *
+     * The system calls could transfer only part of the bytes, this class keeps track of
+     * the parts that are still missing without modifying the user's list. Small lists are
+     * copied into an internal array so the common case does not allocate memory.
+     */
+    class io_vectors
+    {
+    public:
+      /**
+       * @brief Copies the list of buffers, the empty buffers are skipped
+       *
+       * @param buffers Array of buffers
+       * @param count   Number of elements in `buffers`
+       */
+      io_vectors(const iovec *buffers, const std::size_t count);
+      io_vectors(const io_vectors&) = delete;
+      io_vectors &operator=(const io_vectors&) = delete;
+      /**
+       * @brief Marks bytes as transferred, moving to the next buffers if necessary
+       *
+       * @param bytes Number of bytes transferred by the last system call
+       */
+      void advance(std::size_t bytes);
+      /**
+       * @brief Getting the number of buffers that the next system call should use, it is
+       *        never bigger than `IOV_MAX`
+       *
+       * @return 0 if all the bytes were transferred
+       */
+      std::size_t count() const;
+      /**
+       * @brief Getting the first buffer that is not completely transferred
+       *
+       * @return Pointer to the buffers that the next system call should use
+       */
+      iovec *data();
+      /**
+       * @brief Checks if all the bytes were transferred
+       *
+       * @return `true` if there is nothing left
+       */
+      bool empty() const;
+      /**
+       * @brief Getting the total number of bytes of all the buffers
+       *
+       * @return Number of bytes
+       */
+      std::size_t total() const;
+
+    private:
+      static constexpr std::size_t local_size_{8};
+
+      iovec local_[local_size_];
+      std::vector<iovec> allocated_;
+      iovec *parts_;
+      std::size_t count_;
+      std::size_t total_;
+    };
+  } // namespace: network_communication
+} // namespace: ramrod
+
+#endif // RAMROD_NETWORK_COMMUNICATION_IO_VECTORS_H
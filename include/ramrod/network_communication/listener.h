@@ -0,0 +1,86 @@
+#ifndef RAMROD_NETWORK_COMMUNICATION_LISTENER_H
+#define RAMROD_NETWORK_COMMUNICATION_LISTENER_H
+
+#include <atomic>        // for atomic
+#include <string>        // for string
+
+#include "ramrod/network_communication/connection.h"
+#include "ramrod/network_communication/socket_options.h"
+
+namespace ramrod {
+  namespace network_communication {
+    /**
+     * @brief Listening TCP (or local) socket that only accepts connections, every accepted
+     *        one is an independent `connection`
+     *
+     * It owns the listening socket and closes it when destroyed, and it is only movable.
+     * Unlike `server`, it does not keep any accepted socket, so one thread could accept
+     * while others use the connections that were already accepted.
+     */
+    class listener
+    {
+    public:
+      listener();
+      ~listener();
+      listener(listener &&other) noexcept;
+      listener &operator=(listener &&other) noexcept;
+      listener(const listener&) = delete;
+      listener &operator=(const listener&) = delete;
+      /**
+       * @brief Waits for one incoming connection
+       *
+       * @param timeout_in_milliseconds Maximum waiting time, a negative value waits forever
+       * @param cancel                  Optional flag that stops the waiting when it
+       *                                becomes `true`
+       *
+       * @return The accepted connection, it is empty if it failed (and `errno` will be set
+       *         accordingly, `ETIMEDOUT` if the time expired or `ECANCELED` if it was
+       *         cancelled)
+       */
+      connection accept(const int timeout_in_milliseconds = -1,
+                        const std::atomic<bool> *cancel = nullptr);
+      /**
+       * @brief Closes the listening socket, the accepted connections are not affected
+       *
+       * @return `false` if it was not open or `close()` failed (and `errno` will be set
+       *         accordingly)
+       */
+      bool close();
+      /**
+       * @brief Getting the listening socket, it is still owned by this object
+       *
+       * @return The file descriptor, or -1 if it is not open
+       */
+      int fd() const;
+      /**
+       * @brief Indicates if it is listening
+       *
+       * @return `true` if `open()` succeeded and it was not closed or moved
+       */
+      bool is_open() const;
+      /**
+       * @brief Binds to the first address that works and starts listening
+       *
+       * @param ip      IP address or host name, or "unix:" followed by the path of a local
+       *                socket (see `local_prefix`), then the port is ignored
+       * @param port    Port number
+       * @param options Options applied to the listening socket and to every accepted one
+       * @param backlog Maximum number of pending connections
+       *
+       * @return `false` if it is already open or it could not bind or listen (and `errno`
+       *         will be set accordingly, `EHOSTUNREACH` if the address could not be
+       *         resolved)
+       */
+      bool open(const std::string &ip, const int port = 1313,
+                const socket_options &options = socket_options(), const int backlog = 10);
+
+    private:
+      int fd_;
+      socket_options options_;
+      // Path of the local socket's file, it is deleted when closing
+      std::string local_path_;
+    };
+  } // namespace: network_communication
+} // namespace: ramrod
+
+#endif // RAMROD_NETWORK_COMMUNICATION_LISTENER_H
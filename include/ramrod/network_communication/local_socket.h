@@ -0,0 +1,50 @@
+#ifndef RAMROD_NETWORK_COMMUNICATION_LOCAL_SOCKET_H
+#define RAMROD_NETWORK_COMMUNICATION_LOCAL_SOCKET_H
+
+#include <string>        // for string
+#include <sys/socket.h>  // for sockaddr, socklen_t
+#include <sys/un.h>      // for sockaddr_un
+
+namespace ramrod {
+  namespace network_communication {
+    /**
+     * @brief Prefix of the addresses that use an `AF_UNIX` socket instead of IP, like
+     *        "unix:/tmp/sensor.sock" (a file) or "unix:@sensor" (abstract namespace)
+     */
+    constexpr char local_prefix[]{"unix:"};
+
+    /**
+     * @brief Checks if an address uses an `AF_UNIX` socket, see `local_prefix`
+     *
+     * @param host Address given to `client::connect()` or `server::connect()`
+     *
+     * @return `true` if it starts with "unix:"
+     */
+    bool is_local_address(const std::string &host);
+    /**
+     * @brief Converts a "unix:" address into a `sockaddr_un`, an initial '@' selects the
+     *        abstract namespace (it has no file and disappears with the last socket)
+     *
+     * @param host    Address that starts with "unix:"
+     * @param address Returns the socket's address
+     * @param length  Returns the size of the address
+     *
+     * @return `false` if it is not a "unix:" address or the path is empty or too long
+     */
+    bool make_local_address(const std::string &host, sockaddr_un *address, socklen_t *length);
+    /**
+     * @brief Deletes the file of an `AF_UNIX` socket that nobody is listening to, so a
+     *        restarted server can bind to the same path
+     *
+     * @param address Address that will be bound
+     * @param length  Size of the address
+     *
+     * @return `true` if the file was deleted, `false` if it does not exist, some process
+     *         is still listening to it, or it is not a socket (regular files, directories
+     *         and symbolic links are never deleted)
+     */
+    bool remove_stale_local_socket(const sockaddr *address, const socklen_t length);
+  } // namespace: network_communication
+} // namespace: ramrod
+
+#endif // RAMROD_NETWORK_COMMUNICATION_LOCAL_SOCKET_H
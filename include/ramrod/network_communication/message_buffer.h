@@ -0,0 +1,108 @@
+#ifndef RAMROD_NETWORK_COMMUNICATION_MESSAGE_BUFFER_H
+#define RAMROD_NETWORK_COMMUNICATION_MESSAGE_BUFFER_H
+
+#include <cstddef>       // for size_t
+#include <cstdint>       // for uint8_t, uint32_t
+#include <functional>    // for function
+#include <vector>        // for vector
+
+namespace ramrod {
+  namespace network_communication {
+    /**
+     * @brief Function called for every received message, `message` points to the internal
+     *        buffer and it is only valid until the function returns
+     */
+    using message_handler = std::function<void(const void *message, const std::uint32_t size)>;
+
+    /**
+     * @brief Receiving buffer that splits a stream of bytes into length-prefixed messages
+     *
+     * Every message is preceded by a header of `header_size` bytes that contains the size
+     * of the message as an unsigned 32 bit integer in the network's endian type. The bytes
+     * are received directly at `tail()`, then every complete message is read with `next()`
+     * without copying it. When there is no more space at the end, the incomplete message
+     * is moved to the beginning, so the messages are always contiguous in memory.
+     */
+    class message_buffer
+    {
+    public:
+      /**
+       * @brief Size in bytes of the header that precedes each message
+       */
+      static constexpr std::size_t header_size{4};
+      /**
+       * @brief Creates an empty buffer, the memory is reserved the first time is used
+       *
+       * @param max_message_size Biggest message that can be received
+       */
+      explicit message_buffer(const std::size_t max_message_size = 65536);
+      /**
+       * @brief Discards all the received bytes
+       */
+      void clear();
+      /**
+       * @brief Indicates how many bytes were written at `tail()`
+       *
+       * @param size Number of new bytes, it must not be bigger than the value that
+       *             `reserve()` returned
+       */
+      void commit(const std::size_t size);
+      /**
+       * @brief Getting the biggest message that can be received
+       *
+       * @return Maximum message size in bytes, default is 65536
+       */
+      std::size_t max_message_size();
+      /**
+       * @brief Setting the biggest message that can be received, all the received bytes
+       *        are discarded
+       *
+       * @param new_max_message_size New maximum message size in bytes
+       *
+       * @return `false` if the value is zero
+       */
+      bool max_message_size(const std::size_t new_max_message_size);
+      /**
+       * @brief Reads the next complete message
+       *
+       * @param message Returns a pointer to the message inside the buffer, it is valid
+       *                until the next call to `reserve()`
+       * @param size    Returns the message's size
+       *
+       * @return 1 if there is a message, 0 if more bytes are needed, or -1 if the next
+       *         message is bigger than `max_message_size()`
+       */
+      int next(const std::uint8_t **message, std::uint32_t *size);
+      /**
+       * @brief Prepares the space where the next received bytes will be written
+       *
+       * It could move the incomplete message to the beginning of the buffer, therefore
+       * the pointers returned by `next()` and `tail()` are invalid after calling it.
+       *
+       * @return Number of bytes that could be written at `tail()`
+       */
+      std::size_t reserve();
+      /**
+       * @brief Getting the position where the next received bytes should be written
+       *
+       * @return Pointer to the free space, call `reserve()` before it
+       */
+      std::uint8_t *tail();
+      /**
+       * @brief Writes the header of a message
+       *
+       * @param header Pointer to `header_size` bytes where the header will be written
+       * @param size   Size of the message that follows the header
+       */
+      static void write_header(std::uint8_t *header, const std::uint32_t size);
+
+    private:
+      std::vector<std::uint8_t> data_;
+      std::size_t head_;
+      std::size_t tail_;
+      std::size_t max_message_size_;
+    };
+  } // namespace: network_communication
+} // namespace: ramrod
+
+#endif // RAMROD_NETWORK_COMMUNICATION_MESSAGE_BUFFER_H
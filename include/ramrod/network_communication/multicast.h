@@ -0,0 +1,70 @@
+#ifndef RAMROD_NETWORK_COMMUNICATION_MULTICAST_H
+#define RAMROD_NETWORK_COMMUNICATION_MULTICAST_H
+
+#include <string>        // for string
+#include <sys/socket.h>  // for sockaddr_storage
+
+namespace ramrod {
+  namespace network_communication {
+    /**
+     * @brief Options of the UDP sockets that publish to a multicast group, see
+     *        `client::multicast()`
+     */
+    struct multicast_options {
+      // IP_MULTICAST_TTL or IPV6_MULTICAST_HOPS, 1 keeps the datagrams in the local network
+      int ttl{1};
+      // IP_MULTICAST_LOOP, delivers the datagrams to the subscribers in this same device
+      bool loopback{true};
+      // Outgoing interface, its name (like "eth0") or its IPv4 address, empty lets the
+      // system decide
+      std::string interface;
+    };
+
+    /**
+     * @brief Applies the multicast options to a UDP socket, every option is tried even
+     *        if a previous one failed
+     *
+     * @param fd      Socket to configure, IPv4 or IPv6
+     * @param options Options to apply
+     *
+     * @return `false` if any option could not be applied (and `errno` will be set
+     *         according to the last failure)
+     */
+    bool apply_multicast_options(const int fd, const multicast_options &options);
+    /**
+     * @brief Checks if an address belongs to a multicast group
+     *
+     * @param address IPv4 or IPv6 address
+     *
+     * @return `true` if it is in 224.0.0.0/4 or ff00::/8
+     */
+    bool is_multicast(const sockaddr_storage &address);
+    /**
+     * @brief Subscribes a UDP socket to a multicast group with `IP_ADD_MEMBERSHIP` or
+     *        `IPV6_JOIN_GROUP`, the socket must be bound to the group's port
+     *
+     * @param fd        Socket bound to the group's port
+     * @param group     Numeric address of the group, of the same family as the socket
+     * @param interface Interface where the group is joined, its name or its IPv4 address,
+     *                  empty lets the system decide
+     *
+     * @return `false` on error (and `errno` will be set accordingly, `EINVAL` if the group
+     *         is not a multicast address of the socket's family)
+     */
+    bool join_multicast_group(const int fd, const std::string &group,
+                              const std::string &interface = std::string());
+    /**
+     * @brief Unsubscribes a UDP socket from a multicast group, see `join_multicast_group()`
+     *
+     * @param fd        Subscribed socket
+     * @param group     Numeric address of the group
+     * @param interface Interface used to join the group
+     *
+     * @return `false` on error (and `errno` will be set accordingly)
+     */
+    bool leave_multicast_group(const int fd, const std::string &group,
+                               const std::string &interface = std::string());
+  } // namespace: network_communication
+} // namespace: ramrod
+
+#endif // RAMROD_NETWORK_COMMUNICATION_MULTICAST_H
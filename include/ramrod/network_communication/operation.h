@@ -0,0 +1,137 @@
+#ifndef RAMROD_NETWORK_COMMUNICATION_OPERATION_H
+#define RAMROD_NETWORK_COMMUNICATION_OPERATION_H
+
+#include <atomic>        // for atomic
+#include <cstddef>       // for size_t
+#include <functional>    // for function
+#include <future>        // for promise, shared_future
+#include <memory>        // for shared_ptr
+#include <sys/types.h>   // for ssize_t
+
+namespace ramrod {
+  namespace network_communication {
+    /**
+     * @brief Handle to an asynchronous send or receive task
+     *
+     * It is returned by the `*_async()` functions of `client` and `server`, copies of the
+     * same operation share its state. The buffer given to the task must stay alive until
+     * `is_ready()` returns `true`, `get()` returns or the completion function is called.
+     */
+    class operation
+    {
+    public:
+      /**
+       * @brief Function called by the worker thread when the task finishes, it receives
+       *        the same value that `get()` returns
+       */
+      using completion = std::function<void(const ssize_t result)>;
+      /**
+       * @brief Creates an empty operation, `is_valid()` will return `false`
+       */
+      operation();
+      /**
+       * @brief Creates a pending operation, used by the classes that perform the task
+       *
+       * @param on_complete Function to call when the task finishes, it could be empty
+       */
+      explicit operation(const completion &on_complete);
+      /**
+       * @brief Requests the cancellation of the task
+       *
+       * A task that did not start yet will not be executed and one in progress stops at
+       * its next intent, in both cases the result will be the number of bytes transferred
+       * before cancelling, or -1 with `errno` set to `ECANCELED` if nothing was transferred.
+       *
+       * @return `false` if the task was already finished or the operation is empty
+       */
+      bool cancel();
+      /**
+       * @brief Pointer to the cancellation flag, used by the classes that perform the task
+       *
+       * @return Pointer to a flag that is `true` after calling `cancel()`, `nullptr` if
+       *         the operation is empty
+       */
+      const std::atomic<bool> *cancellation() const;
+      /**
+       * @brief Getting the error of a failed task, `errno` belongs to the worker thread
+       *        so it cannot be read by the thread that waits for the result
+       *
+       * @return The value of `errno` when the task finished with -1, otherwise 0
+       */
+      int error() const;
+      /**
+       * @brief Sets the result of the task, calls the completion function and then wakes up
+       *        anybody waiting, used by the classes that perform the task
+       *
+       * Only the first call has an effect. When `result` is -1 the current value of `errno`
+       * is saved and returned later by `error()`.
+       *
+       * @param result Number of bytes transferred, 0 when disconnected or -1 on error
+       */
+      void finish(const ssize_t result);
+      /**
+       * @brief Waits until the task finishes
+       *
+       * @return The number of bytes actually transferred, or 0 when the other device is
+       *         disconnected, or -1 on error (see `error()`) or if the operation is empty
+       */
+      ssize_t get() const;
+      /**
+       * @brief Indicates if `cancel()` was called
+       *
+       * @return `true` if the cancellation was requested
+       */
+      bool is_cancelled() const;
+      /**
+       * @brief Indicates if the task finished, the buffer can be reused after this
+       *        returns `true`
+       *
+       * @return `true` if the result is available
+       */
+      bool is_ready() const;
+      /**
+       * @brief Indicates if this operation is related to a task
+       *
+       * @return `false` if it was created with the default constructor
+       */
+      bool is_valid() const;
+      /**
+       * @brief Getting the number of bytes transferred while the task is running, only
+       *        the tasks that report it update it (like `client::send_file_async()`)
+       *
+       * @return Bytes transferred until now, 0 if it was not reported
+       */
+      std::size_t progress() const;
+      /**
+       * @brief Sets the number of bytes transferred until now, used by the classes that
+       *        perform the task
+       *
+       * @param transferred Bytes transferred
+       */
+      void progress(const std::size_t transferred);
+      /**
+       * @brief Waits until the task finishes or some time passes
+       *
+       * @param timeout_in_milliseconds Maximum time to wait
+       *
+       * @return `true` if the task finished
+       */
+      bool wait_for(const int timeout_in_milliseconds) const;
+
+    private:
+      struct state {
+        std::atomic<bool> cancelled;
+        std::atomic<bool> finished;
+        std::atomic<std::size_t> progress;
+        int error;
+        std::promise<ssize_t> promise;
+        completion on_complete;
+      };
+
+      std::shared_ptr<state> state_;
+      std::shared_future<ssize_t> result_;
+    };
+  } // namespace: network_communication
+} // namespace: ramrod
+
+#endif // RAMROD_NETWORK_COMMUNICATION_OPERATION_H
@@ -0,0 +1,120 @@
+#ifndef RAMROD_NETWORK_COMMUNICATION_PEER_TABLE_H
+#define RAMROD_NETWORK_COMMUNICATION_PEER_TABLE_H
+
+#include <cstddef>       // for size_t
+#include <cstdint>       // for uint32_t, int32_t
+#include <sys/socket.h>  // for sockaddr_storage, socklen_t
+#include <vector>        // for vector
+
+namespace ramrod {
+  namespace network_communication {
+    /**
+     * @brief Table of the UDP peers of a server, every address receives a numeric
+     *        identifier that is used to send datagrams back to it
+     *
+     * It is an open-addressing hash map with linear probing, the slots only contain the
+     * hash and the identifier (8 bytes), so a lookup usually reads one cache line and
+     * compares the full address once. Only IPv4 and IPv6 addresses are accepted, they
+     * are normalized (family, port, address and IPv6 scope) before hashing them.
+     *
+     * It is not thread-safe, `server` protects it with a mutex.
+     */
+    class peer_table
+    {
+    public:
+      /**
+       * @brief Creates an empty table
+       *
+       * @param max_peers Maximum number of peers that could be added
+       */
+      explicit peer_table(const std::size_t max_peers = 4096);
+      /**
+       * @brief Getting the identifier of an address, adding it if it is new
+       *
+       * @param address Address of the peer, as returned by `recvfrom`
+       * @param length  Size of the address
+       *
+       * @return Identifier of the peer, or -1 if the table is full or the family is not
+       *         `AF_INET` or `AF_INET6`
+       */
+      int add(const sockaddr_storage &address, const socklen_t length);
+      /**
+       * @brief Removes all the peers
+       */
+      void clear();
+      /**
+       * @brief Getting the identifier of an address
+       *
+       * @param address Address of the peer
+       * @param length  Size of the address
+       *
+       * @return Identifier of the peer, or -1 if it is not in the table
+       */
+      int find(const sockaddr_storage &address, const socklen_t length) const;
+      /**
+       * @brief Getting the address of a peer
+       *
+       * @param peer    Identifier of the peer
+       * @param address Returns the peer's address
+       * @param length  Returns the size of the address
+       *
+       * @return `false` if there is no peer with such identifier
+       */
+      bool get(const int peer, sockaddr_storage *address, socklen_t *length) const;
+      /**
+       * @brief Getting the maximum number of peers
+       *
+       * @return Maximum number of peers, default is 4096
+       */
+      std::size_t max_peers() const;
+      /**
+       * @brief Setting the maximum number of peers, the current ones are kept
+       *
+       * @param new_max_peers New maximum number of peers
+       *
+       * @return `false` if the value is zero
+       */
+      bool max_peers(const std::size_t new_max_peers);
+      /**
+       * @brief Removes a peer, its identifier could be given to another address later
+       *
+       * @param peer Identifier of the peer
+       *
+       * @return `false` if there is no peer with such identifier
+       */
+      bool remove(const int peer);
+      /**
+       * @brief Getting the number of peers
+       *
+       * @return Number of peers in the table
+       */
+      std::size_t size() const;
+
+    private:
+      // Empty slots have a negative peer
+      struct slot {
+        std::uint32_t hash;
+        std::int32_t peer;
+      };
+
+      struct entry {
+        sockaddr_storage address;
+        socklen_t length;
+        std::uint32_t hash;
+        bool used;
+      };
+
+      void grow();
+      std::size_t locate(const sockaddr_storage &address, const socklen_t length,
+                         const std::uint32_t hash) const;
+
+      std::vector<slot> slots_;
+      std::vector<entry> peers_;
+      std::vector<int> free_;
+      std::size_t size_;
+      std::size_t max_peers_;
+    };
+  } // namespace: network_communication
+} // namespace: ramrod
+
+#endif // RAMROD_NETWORK_COMMUNICATION_PEER_TABLE_H
@@ -0,0 +1,65 @@
+#ifndef RAMROD_NETWORK_COMMUNICATION_RECONNECTION_POLICY_H
+#define RAMROD_NETWORK_COMMUNICATION_RECONNECTION_POLICY_H
+
+#include <atomic>        // for atomic
+#include <chrono>        // for milliseconds
+#include <cstdint>       // for uint32_t
+
+namespace ramrod {
+  namespace network_communication {
+    /**
+     * @brief Waiting times between the failed intents of `client` and `server` to connect
+     *
+     * The n-th retry waits `initial_delay * multiplier^(n - 1)` milliseconds, limited by
+     * `maximum_delay`, minus a random part of up to `jitter` times that value. In this way
+     * many devices that lost the connection at the same time do not retry in lockstep.
+     */
+    struct reconnection_policy {
+      // Waiting time before the first retry in milliseconds
+      int initial_delay{5000};
+      // Every retry waits this value times the previous waiting, 1 waits always the same
+      double multiplier{2.0};
+      // Biggest waiting time in milliseconds
+      int maximum_delay{60000};
+      // Randomized fraction of every waiting, 0 waits exactly, 1 waits between 0 and the delay
+      double jitter{0.5};
+      // Milliseconds that the resolved addresses are reused, 0 resolves them again in every
+      // intent and a negative value keeps them until the IP or port change
+      int address_ttl{30000};
+    };
+
+    /**
+     * @brief Calculates the waiting time before a retry
+     *
+     * @param policy Policy to follow
+     * @param intent Number of the failed intent, starting at 1
+     *
+     * @return Waiting time including the random jitter
+     */
+    std::chrono::milliseconds backoff_delay(const reconnection_policy &policy,
+                                            const std::uint32_t intent);
+    /**
+     * @brief Checks if the values of a policy make sense
+     *
+     * @param policy Policy to check
+     *
+     * @return `false` if any delay is negative, `maximum_delay` is smaller than
+     *         `initial_delay`, `multiplier` is smaller than 1 or `jitter` is not
+     *         between 0 and 1
+     */
+    bool is_valid(const reconnection_policy &policy);
+    /**
+     * @brief Sleeps before a retry, waking up every 50 milliseconds to check if it was
+     *        cancelled
+     *
+     * @param delay  Waiting time
+     * @param cancel Flag that stops the waiting when it becomes `true`
+     *
+     * @return `false` if it was cancelled
+     */
+    bool wait_to_reconnect(const std::chrono::milliseconds &delay,
+                           const std::atomic<bool> &cancel);
+  } // namespace: network_communication
+} // namespace: ramrod
+
+#endif // RAMROD_NETWORK_COMMUNICATION_RECONNECTION_POLICY_H
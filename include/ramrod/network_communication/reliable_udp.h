@@ -0,0 +1,262 @@
+#ifndef RAMROD_NETWORK_COMMUNICATION_RELIABLE_UDP_H
+#define RAMROD_NETWORK_COMMUNICATION_RELIABLE_UDP_H
+
+#include <cstddef>       // for size_t
+#include <cstdint>       // for uint8_t, uint32_t, uint64_t
+#include <deque>         // for deque
+#include <functional>    // for function
+#include <map>           // for map
+#include <mutex>         // for mutex
+#include <vector>        // for vector
+
+#include "ramrod/network_communication/datagram.h"
+
+namespace ramrod {
+  namespace network_communication {
+    /**
+     * @brief How a message of `reliable_session` is delivered
+     */
+    enum class delivery : std::uint8_t {
+      // Retransmitted until it is acknowledged and delivered in order
+      reliable  = 1,
+      // Sent only once, the receiver discards it if a newer one was already delivered
+      sequenced = 2
+    };
+
+    /**
+     * @brief Bytes added to every datagram: its type, sequence number and the selective
+     *        acknowledgement of the other direction
+     */
+    constexpr std::size_t reliable_header_size{14};
+
+    /**
+     * @brief Maximum number of datagrams read or written at once by client and server
+     */
+    constexpr std::size_t reliable_batch{16};
+
+    struct reliable_options {
+      // Biggest message, one message is one datagram so it should not be fragmented by IP
+      std::size_t max_payload{1200};
+      // Congestion window when the session starts and after a timeout, in datagrams
+      std::size_t initial_window{4};
+      // Biggest congestion window, it is also the reception window of the other device
+      std::size_t max_window{256};
+      // Bytes of the messages that wait for room in the window
+      std::size_t max_queued_bytes{4 * 1024 * 1024};
+      // Retransmission timeout before the first round trip is measured, and its limits
+      int initial_timeout{200};
+      int min_timeout{20};
+      int max_timeout{2000};
+      // The session fails after retransmitting the same datagram this number of times
+      std::uint32_t max_retransmissions{10};
+      // Spreads the window over the round trip instead of sending it in one burst
+      bool pacing{true};
+    };
+
+    struct reliable_statistics {
+      // Congestion window in datagrams
+      std::size_t window{0};
+      // Reliable datagrams sent and not acknowledged yet
+      std::size_t in_flight{0};
+      // Bytes waiting for room in the window
+      std::size_t queued_bytes{0};
+      std::uint64_t retransmissions{0};
+      // Smoothed round trip time and current retransmission timeout, in microseconds
+      std::uint64_t round_trip{0};
+      std::uint64_t timeout{0};
+    };
+
+    /**
+     * @brief Function called for every delivered message, the pointer is only valid until
+     *        it returns
+     */
+    using reliable_handler = std::function<void(const void *message, const std::uint32_t size,
+                                                const delivery mode)>;
+    /**
+     * @brief Function that sends or receives an array of datagrams with one system call, like
+     *        `send_datagrams()` and `receive_datagrams()` of client and server
+     */
+    using datagram_batch = std::function<int(datagram *datagrams, const std::size_t count)>;
+
+    /**
+     * @brief Reliable and ordered delivery of messages over datagrams, without the
+     *        head-of-line blocking of TCP for the messages sent as `delivery::sequenced`
+     *
+     * It does not touch any socket: `send()` queues messages, `next()` gives the datagrams
+     * to transmit (new messages, retransmissions and acknowledgements) and `receive()`
+     * takes the datagrams of the other device. Every datagram has a sequence number and
+     * acknowledges the other direction cumulatively plus a bitmap of the next 32 ones, so
+     * a single loss only retransmits that datagram. The retransmission timeout follows the
+     * measured round trip (RFC 6298) and the window grows and halves like TCP Reno.
+     */
+    class reliable_session
+    {
+    public:
+      explicit reliable_session(const reliable_options &options = reliable_options());
+      reliable_session(const reliable_session&) = delete;
+      reliable_session &operator=(const reliable_session&) = delete;
+      /**
+       * @brief Gives the messages received in order to the handler, it is called without
+       *        any lock so it could send more messages
+       *
+       * @param handler Function called for every message
+       *
+       * @return Number of delivered messages
+       */
+      int deliver(const reliable_handler &handler);
+      /**
+       * @brief Getting if a datagram could not be delivered after all its retransmissions,
+       *        the other device is considered lost until `reset()`
+       *
+       * @return `true` if the session failed
+       */
+      bool failed() const;
+      /**
+       * @brief Takes the next datagram that must be sent now
+       *
+       * @param packet   Where the datagram is written
+       * @param capacity Size of `packet`, at least `max_payload + reliable_header_size`
+       *
+       * @return Size of the datagram, or 0 if nothing has to be sent now
+       */
+      std::size_t next(std::uint8_t *packet, const std::size_t capacity);
+      /**
+       * @brief Getting the current options
+       *
+       * @return Options of the session
+       */
+      reliable_options options() const;
+      /**
+       * @brief Setting new options, it also resets the session
+       *
+       * @param new_options New options
+       *
+       * @return `false` if the sizes or the windows are 0, or the initial window is bigger
+       *         than the maximum (and `errno` will be `EINVAL`)
+       */
+      bool options(const reliable_options &new_options);
+      /**
+       * @brief Processes one datagram of the other device
+       *
+       * @param packet Received datagram
+       * @param size   Size of the datagram
+       *
+       * @return `false` if it is not a datagram of a session (and `errno` will be `EPROTO`)
+       */
+      bool receive(const std::uint8_t *packet, const std::size_t size);
+      /**
+       * @brief Discards every message and starts again from the first sequence number,
+       *        both devices must reset at the same time, in a new connection
+       */
+      void reset();
+      /**
+       * @brief Queues a message, see `next()`
+       *
+       * @param buffer Message to send, it is copied
+       * @param size   Size of the message
+       * @param mode   How it is delivered
+       *
+       * @return `false` if it is bigger than `max_payload` (and `errno` will be `EMSGSIZE`),
+       *         there are too many queued bytes (`ENOBUFS`) or the session failed
+       *         (`ETIMEDOUT`)
+       */
+      bool send(const void *buffer, const std::size_t size, const delivery mode);
+      /**
+       * @brief Getting the state of the congestion control
+       *
+       * @return Current values
+       */
+      reliable_statistics statistics() const;
+      /**
+       * @brief Getting the time until `next()` has something to send
+       *
+       * @return Milliseconds, 0 if something must be sent now or -1 if it only waits for
+       *         the other device
+       */
+      int wait_time() const;
+
+    private:
+      struct outgoing {
+        std::uint32_t sequence;
+        std::vector<std::uint8_t> packet;
+        std::uint64_t sent_at;
+        std::uint32_t transmissions;
+        bool acknowledged;
+        bool lost;
+      };
+
+      struct incoming {
+        delivery mode;
+        std::vector<std::uint8_t> data;
+      };
+
+      void acknowledge(const std::uint32_t cumulative, const std::uint32_t selective,
+                       const std::uint64_t current);
+      bool can_send(const std::uint64_t current) const;
+      void clear();
+      void measure(const std::uint64_t sample);
+      void sent(const std::uint64_t current);
+      void write_header(std::uint8_t *packet, const std::uint8_t type,
+                        const std::uint32_t sequence);
+
+      mutable std::mutex mutex_;
+      reliable_options options_;
+      bool failed_;
+
+      // Sending direction
+      std::uint32_t next_sequence_;
+      std::uint32_t next_sequenced_;
+      std::deque<outgoing> in_flight_;
+      // Sequenced messages do not wait for the window, so they never queue behind it
+      std::deque<std::vector<std::uint8_t>> reliable_queue_;
+      std::deque<std::vector<std::uint8_t>> sequenced_queue_;
+      bool sequenced_turn_;
+      std::size_t queued_bytes_;
+      std::size_t window_;
+      std::size_t threshold_;
+      std::size_t acknowledged_in_window_;
+      // Losses of the same window reduce it only once
+      std::uint32_t recovery_;
+      bool recovering_;
+      std::uint64_t round_trip_;
+      std::uint64_t variation_;
+      std::uint64_t timeout_;
+      std::uint64_t next_send_;
+      std::uint64_t retransmissions_;
+
+      // Receiving direction
+      std::uint32_t expected_;
+      std::uint32_t last_sequenced_;
+      bool any_sequenced_;
+      std::map<std::uint32_t, std::vector<std::uint8_t>> out_of_order_;
+      std::deque<incoming> ready_;
+      bool acknowledge_;
+    };
+
+    /**
+     * @brief Sends every datagram that the window and the pacing of a session allow, in
+     *        batches of `reliable_batch` datagrams
+     *
+     * @param session Session that produces the datagrams
+     * @param buffer  Memory of the datagrams, it grows when the session's payload grows
+     * @param send    Sends one batch, a datagram that could not be sent is lost and its
+     *                timer will send it again
+     */
+    void send_reliable_batches(reliable_session *session, std::vector<std::uint8_t> *buffer,
+                               const datagram_batch &send);
+    /**
+     * @brief Receives one batch of datagrams for a session, the ones that were truncated or
+     *        do not belong to a session are ignored
+     *
+     * @param session Session that consumes the datagrams
+     * @param buffer  Memory of the datagrams, it grows when the session's payload grows
+     * @param receive Receives one batch
+     *
+     * @return `false` if `receive` failed (and `errno` will be set accordingly)
+     */
+    bool receive_reliable_batch(reliable_session *session, std::vector<std::uint8_t> *buffer,
+                                const datagram_batch &receive);
+  } // namespace: network_communication
+} // namespace: ramrod
+
+#endif // RAMROD_NETWORK_COMMUNICATION_RELIABLE_UDP_H
@@ -0,0 +1,157 @@
+#ifndef RAMROD_NETWORK_COMMUNICATION_SEND_QUEUE_H
+#define RAMROD_NETWORK_COMMUNICATION_SEND_QUEUE_H
+
+#include <atomic>        // for atomic
+#include <cstddef>       // for size_t
+#include <functional>    // for function
+#include <mutex>         // for mutex
+#include <sys/uio.h>     // for iovec
+#include <vector>        // for vector
+
+namespace ramrod {
+  namespace network_communication {
+    /**
+     * @brief Function called when the queued bytes reach the high watermark (`high` is
+     *        `true`) and when they fall to the low watermark again (`high` is `false`)
+     */
+    using watermark_handler = std::function<void(const bool high)>;
+
+    /**
+     * @brief Lock-free queue of messages waiting to be sent by one connection, many
+     *        threads could add messages and only one thread (the writer) takes them
+     *
+     * Every message is copied into its own node, the producers link it with only one
+     * atomic exchange, so they never wait for the writer or for each other. The writer
+     * takes several messages at once as an array of `iovec`, in this way many small
+     * messages are sent with only one `writev()`, in the same order they were added.
+     *
+     * The producers could be warned before the queue is full with two watermarks: the
+     * handler is called once when the queued bytes reach the high one, so they could
+     * slow down or skip stale messages, and once more when the writer drained the queue
+     * down to the low one.
+     */
+    class send_queue
+    {
+    public:
+      /**
+       * @brief Maximum number of messages returned by one `take()`
+       */
+      static constexpr std::size_t max_batch{64};
+
+      /**
+       * @brief Creates an empty queue
+       *
+       * @param max_bytes Limit of bytes waiting in the queue
+       */
+      explicit send_queue(const std::size_t max_bytes = 64 * 1024 * 1024);
+      ~send_queue();
+      send_queue(const send_queue&) = delete;
+      send_queue &operator=(const send_queue&) = delete;
+      /**
+       * @brief Adds a message, it is copied so the buffers could be reused immediately
+       *
+       * @param header      Optional bytes sent before the message, like a frame's header
+       * @param header_size Size of `header`, 0 if there is none
+       * @param buffer      Message to be sent
+       * @param size        Size of the message
+       * @param start       Returns `true` if the writer was not working, then the caller
+       *                    must start it, the writer calls `take()` until `keep_writing()`
+       *                    returns `false`
+       *
+       * @return `false` if the message does not fit in `max_bytes()` (`errno` will be
+       *         `ENOBUFS`) or the memory could not be allocated (`ENOMEM`)
+       */
+      bool add(const void *header, const std::size_t header_size, const void *buffer,
+               const std::size_t size, bool *start);
+      /**
+       * @brief Getting the number of bytes waiting to be sent
+       *
+       * @return Bytes added and not released yet
+       */
+      std::size_t bytes() const;
+      /**
+       * @brief Checks if the writer must keep taking messages, only called by the writer
+       *
+       * @return `false` if the queue is empty, the next `add()` will ask for a new writer
+       */
+      bool keep_writing();
+      /**
+       * @brief Getting the limit of bytes waiting in the queue
+       *
+       * @return Maximum bytes, default is 64 MiB
+       */
+      std::size_t max_bytes() const;
+      /**
+       * @brief Setting the limit of bytes waiting in the queue, the messages already added
+       *        are not removed
+       *
+       * @param new_max_bytes New maximum bytes
+       */
+      void max_bytes(const std::size_t new_max_bytes);
+      /**
+       * @brief Frees the messages returned by the last `take()`, only called by the writer
+       */
+      void release();
+      /**
+       * @brief Getting if the queued bytes reached the high watermark and did not fall to
+       *        the low one yet
+       *
+       * @return `true` between the two calls of the watermark handler
+       */
+      bool saturated() const;
+      /**
+       * @brief Takes the oldest messages, only called by the writer
+       *
+       * @param parts Array of at least `max_batch` elements where the messages are written
+       *
+       * @return Number of elements written in `parts`, they are valid until `release()`
+       */
+      std::size_t take(iovec *parts);
+      /**
+       * @brief Setting the watermarks, the handler is called by the thread that crossed
+       *        them (a producer for the high one and the writer for the low one)
+       *
+       * The calls never overlap and always alternate between `true` and `false`, in the
+       * same order as `saturated()` changes.
+       *
+       * @param high    Bytes that call the handler with `true`, 0 disables the watermarks
+       * @param low     Bytes that call the handler with `false` after reaching `high`
+       * @param handler Function to call, it must not add messages to this queue
+       *
+       * @return `false` if `low` is not smaller than `high`
+       */
+      bool watermarks(const std::size_t high, const std::size_t low,
+                      const watermark_handler &handler);
+
+    private:
+      struct node {
+        std::atomic<node*> next;
+        std::size_t size;
+      };
+
+      void notify(const bool high);
+      node *pop();
+      void push(node *message);
+      void transition(const bool high);
+
+      // Producers link their nodes at the head, the writer unlinks them from the tail
+      std::atomic<node*> head_;
+      node *tail_;
+      node stub_;
+      std::vector<node*> taken_;
+      std::atomic<std::size_t> bytes_;
+      std::atomic<std::size_t> max_bytes_;
+      std::atomic<bool> writing_;
+      // The handler is only read when a watermark is crossed
+      std::atomic<std::size_t> high_watermark_;
+      std::atomic<std::size_t> low_watermark_;
+      std::atomic<bool> saturated_;
+      // Held while the flag changes and the handler runs, so the calls keep their order
+      std::mutex transition_mutex_;
+      std::mutex handler_mutex_;
+      watermark_handler handler_;
+    };
+  } // namespace: network_communication
+} // namespace: ramrod
+
+#endif // RAMROD_NETWORK_COMMUNICATION_SEND_QUEUE_H
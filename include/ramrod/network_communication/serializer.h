@@ -0,0 +1,285 @@
+#ifndef RAMROD_NETWORK_COMMUNICATION_SERIALIZER_H
+#define RAMROD_NETWORK_COMMUNICATION_SERIALIZER_H
+
+#include <array>         // for array
+#include <cerrno>        // for errno, EBADMSG
+#include <cstddef>       // for size_t
+#include <cstdint>       // for uint8_t, uint16_t, uint32_t, uint64_t
+#include <cstring>       // for memcpy
+#include <sys/socket.h>  // for MSG_NOSIGNAL
+#include <sys/types.h>   // for ssize_t
+#include <type_traits>   // for conditional_t, enable_if_t, is_arithmetic, is_enum...
+
+#include "ramrod/network_communication/conversor.h"
+
+namespace ramrod {
+  namespace network_communication {
+    /**
+     * @brief Unsigned integer with the same size as a field, used to convert its bytes
+     */
+    template<std::size_t bytes>
+    using wire_bits = std::conditional_t<bytes == 1, std::uint8_t,
+                      std::conditional_t<bytes == 2, std::uint16_t,
+                      std::conditional_t<bytes == 4, std::uint32_t, std::uint64_t>>>;
+
+    template<typename T>
+    constexpr bool unsupported_field{false};
+
+    /**
+     * @brief Network representation of one field, specialize it to serialize other types
+     *
+     * Every specialization has the number of bytes that the field uses in the network,
+     * `size`, and the functions `encode(const T&, std::uint8_t*)` and
+     * `decode(const std::uint8_t*, T*)` that write and read exactly `size` bytes.
+     */
+    template<typename T, typename = void>
+    struct field_codec {
+      static_assert(unsupported_field<T>, "The field type cannot be serialized, use integers, "
+                                          "enums, floats, doubles or arrays of them");
+    };
+
+    /**
+     * @brief Integers, booleans, enums, floats and doubles, every one is sent with its
+     *        size in the network's endian type (IEEE 754 bits for the floating points)
+     */
+    template<typename T>
+    struct field_codec<T, std::enable_if_t<std::is_arithmetic<T>::value || std::is_enum<T>::value>> {
+      static_assert(sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8,
+                    "Only fields of 1, 2, 4 or 8 bytes can be serialized");
+
+      static constexpr std::size_t size{sizeof(T)};
+
+      static void encode(const T &value, std::uint8_t *buffer){
+        wire_bits<size> bits;
+        std::memcpy(&bits, &value, size);
+        if constexpr(size > 1) bits = conversor::host_to_network(bits);
+        std::memcpy(buffer, &bits, size);
+      }
+
+      static void decode(const std::uint8_t *buffer, T *value){
+        wire_bits<size> bits;
+        std::memcpy(&bits, buffer, size);
+        if constexpr(std::is_same<T, bool>::value){
+          // Any byte other than zero is true, copying it would create an invalid bool
+          *value = bits != 0;
+        }else{
+          if constexpr(size > 1) bits = conversor::network_to_host(bits);
+          std::memcpy(value, &bits, size);
+        }
+      }
+    };
+
+    /**
+     * @brief Fixed arrays, their elements are sent one after the other, the arrays of
+     *        numbers are converted with the bulk functions of `conversor`
+     */
+    template<typename E, std::size_t N>
+    struct array_codec {
+      static constexpr std::size_t size{N * field_codec<E>::size};
+
+      static void encode(const E *values, std::uint8_t *buffer){
+        if constexpr(bulk){
+          conversor::host_to_network(reinterpret_cast<const wire_bits<sizeof(E)>*>(values),
+                                     reinterpret_cast<wire_bits<sizeof(E)>*>(buffer), N);
+        }else if constexpr(bytes){
+          std::memcpy(buffer, values, size);
+        }else{
+          for(std::size_t i = 0; i < N; ++i)
+            field_codec<E>::encode(values[i], buffer + i * field_codec<E>::size);
+        }
+      }
+
+      static void decode(const std::uint8_t *buffer, E *values){
+        if constexpr(bulk){
+          conversor::network_to_host(reinterpret_cast<const wire_bits<sizeof(E)>*>(buffer),
+                                     reinterpret_cast<wire_bits<sizeof(E)>*>(values), N);
+        }else if constexpr(bytes){
+          std::memcpy(values, buffer, size);
+        }else{
+          for(std::size_t i = 0; i < N; ++i)
+            field_codec<E>::decode(buffer + i * field_codec<E>::size, &values[i]);
+        }
+      }
+
+    private:
+      // Numbers whose memory is exactly their network representation once converted
+      static constexpr bool number{(std::is_arithmetic<E>::value || std::is_enum<E>::value)
+                                   && !std::is_same<E, bool>::value};
+      static constexpr bool bytes{number && sizeof(E) == 1};
+      static constexpr bool bulk{number && sizeof(E) > 1};
+    };
+
+    template<typename E, std::size_t N>
+    struct field_codec<E[N]> : array_codec<E, N> {
+      static void encode(const E (&values)[N], std::uint8_t *buffer){
+        array_codec<E, N>::encode(values, buffer);
+      }
+
+      static void decode(const std::uint8_t *buffer, E (*values)[N]){
+        array_codec<E, N>::decode(buffer, *values);
+      }
+    };
+
+    template<typename E, std::size_t N>
+    struct field_codec<std::array<E, N>> : array_codec<E, N> {
+      static void encode(const std::array<E, N> &values, std::uint8_t *buffer){
+        array_codec<E, N>::encode(values.data(), buffer);
+      }
+
+      static void decode(const std::uint8_t *buffer, std::array<E, N> *values){
+        array_codec<E, N>::decode(buffer, values->data());
+      }
+    };
+
+    template<typename Member>
+    struct member_traits;
+
+    template<typename Class, typename Field>
+    struct member_traits<Field Class::*> {
+      using owner = Class;
+      using type = Field;
+    };
+
+    /**
+     * @brief Converts a struct from/to its network representation, the fields are
+     *        described once as a list of pointers to members
+     *
+     * Everything is resolved when compiling, the fields are written one after the other
+     * in the order of the list without padding:
+     *
+     *     struct position { std::uint32_t id; double x, y; std::array<float, 3> speed; };
+     *     using position_serializer = serializer<position, &position::id, &position::x,
+     *                                            &position::y, &position::speed>;
+     *
+     *     position_serializer::send(client, current);
+     *
+     * @tparam Type   Struct to be serialized
+     * @tparam Fields Pointers to the members of `Type` that are sent
+     */
+    template<typename Type, auto... Fields>
+    class serializer
+    {
+      static_assert(sizeof...(Fields) > 0, "A serializer needs at least one field");
+      static_assert((std::is_base_of<typename member_traits<decltype(Fields)>::owner,
+                                     Type>::value && ...),
+                    "Every field must be a member of the serialized type");
+
+    public:
+      using type = Type;
+
+      /**
+       * @brief Number of bytes used by the network representation
+       */
+      static constexpr std::size_t size{
+        (field_codec<typename member_traits<decltype(Fields)>::type>::size + ...)
+      };
+
+      /**
+       * @brief Reads the network representation of a value
+       *
+       * @param buffer Memory with at least `size` bytes
+       * @param value  Where the fields are written, the other members are not modified
+       *
+       * @return Number of bytes read, always `size`
+       */
+      static std::size_t decode(const void *buffer, Type *value){
+        const std::uint8_t *position{static_cast<const std::uint8_t*>(buffer)};
+        (decode_field<Fields>(&position, value), ...);
+        return size;
+      }
+      /**
+       * @brief Reads a message received with `receive_message()` or `receive_messages()`
+       *
+       * @param message      Received message
+       * @param message_size Size of the received message
+       * @param value        Where the fields are written
+       *
+       * @return `false` if the size is not `size`, then `value` is not modified
+       */
+      static bool decode(const void *message, const std::size_t message_size, Type *value){
+        if(message_size != size) return false;
+        decode(message, value);
+        return true;
+      }
+      /**
+       * @brief Writes the network representation of a value
+       *
+       * @param value  Value to be converted
+       * @param buffer Memory with at least `size` bytes, for example the send buffer
+       *
+       * @return Number of bytes written, always `size`
+       */
+      static std::size_t encode(const Type &value, void *buffer){
+        std::uint8_t *position{static_cast<std::uint8_t*>(buffer)};
+        (encode_field<Fields>(value, &position), ...);
+        return size;
+      }
+      /**
+       * @brief Receives one value sent with `send()`, see `receive_message()`
+       *
+       * @param connection `client` or `server` that receives the message
+       * @param value      Where the fields are written
+       * @param breaker    The same as `receive_message()`
+       * @param flags      The same as `receive_message()`
+       *
+       * @return The size of the message, or 0 when the other side is disconnected, or -1
+       *         on error (and `errno` will be set accordingly, `EBADMSG` if the message
+       *         does not have `size` bytes, `EMSGSIZE` if it is bigger)
+       */
+      template<typename Connection>
+      static ssize_t receive(Connection &connection, Type *value, bool *breaker = nullptr,
+                             const int flags = 0){
+        std::uint8_t payload[size];
+        const ssize_t received{connection.receive_message(payload, size, breaker, flags)};
+        if(received <= 0) return received;
+
+        if(!decode(payload, static_cast<std::size_t>(received), value)){
+          errno = EBADMSG;
+          return -1;
+        }
+        return received;
+      }
+      /**
+       * @brief Sends one value as a message of `send_message()`, the fields are written in
+       *        a buffer of the stack and sent with the header in only one system call
+       *
+       * It uses the same framing as `send_message()`, so the message is also compressed
+       * when the connection negotiated it.
+       *
+       * @param connection `client` or `server` that sends the message
+       * @param value      Value to be sent
+       * @param breaker    The same as `send_message()`
+       * @param flags      The same as `send_message()`
+       *
+       * @return The number of bytes of the message sent, or 0 when the other side is
+       *         disconnected, or -1 on error (and `errno` will be set accordingly)
+       */
+      template<typename Connection>
+      static ssize_t send(Connection &connection, const Type &value, bool *breaker = nullptr,
+                          const int flags = MSG_NOSIGNAL){
+        std::uint8_t payload[size];
+        encode(value, payload);
+        return connection.send_message(static_cast<const void*>(payload),
+                                       static_cast<std::uint32_t>(size), breaker, flags);
+      }
+
+    private:
+      template<auto Field>
+      using codec = field_codec<typename member_traits<decltype(Field)>::type>;
+
+      template<auto Field>
+      static void decode_field(const std::uint8_t **position, Type *value){
+        codec<Field>::decode(*position, &(value->*Field));
+        *position += codec<Field>::size;
+      }
+
+      template<auto Field>
+      static void encode_field(const Type &value, std::uint8_t **position){
+        codec<Field>::encode(value.*Field, *position);
+        *position += codec<Field>::size;
+      }
+    };
+  } // namespace: network_communication
+} // namespace: ramrod
+
+#endif // RAMROD_NETWORK_COMMUNICATION_SERIALIZER_H
@@ -1,25 +1,133 @@
 #ifndef RAMROD_NETWORK_COMMUNICATION_SERVER_H
 #define RAMROD_NETWORK_COMMUNICATION_SERVER_H
 
-#include <atomic>        // for atomic
-#include <chrono>        // for duration
-#include <cstdint>       // for uint32_t, uint16_t
-#include <ratio>         // for milli
-#include <string>        // for string
-#include <sys/socket.h>  // for recv, send, MSG_NOSIGNAL, accept
-#include <sys/types.h>   // for ssize_t
+#include <atomic>         // for atomic
+#include <cstddef>        // for size_t
+#include <cstdint>        // for uint32_t, uint16_t
+#include <functional>     // for function
+#include <memory>         // for unique_ptr
+#include <mutex>          // for mutex
+#include <netdb.h>        // for addrinfo
+#include <string>         // for string
+#include <sys/socket.h>   // for recv, send, MSG_NOSIGNAL, accept
+#include <sys/types.h>    // for ssize_t
+#include <sys/uio.h>      // for iovec
+#include <unordered_map>  // for unordered_map
+#include <utility>        // for pair
+#include <vector>         // for vector
 
+#include "ramrod/network_communication/address_cache.h"
+#include "ramrod/network_communication/buffer_pool.h"
+#include "ramrod/network_communication/channels.h"
+#include "ramrod/network_communication/compression.h"
+#include "ramrod/network_communication/connection_metrics.h"
 #include "ramrod/network_communication/conversor.h"
-
-struct addrinfo;
+#include "ramrod/network_communication/datagram.h"
+#include "ramrod/network_communication/file_stream.h"
+#ifdef RAMROD_NETWORK_IO_URING
+#include "ramrod/network_communication/io_ring.h"
+#endif
+#include "ramrod/network_communication/message_buffer.h"
+#include "ramrod/network_communication/multicast.h"
+#include "ramrod/network_communication/operation.h"
+#include "ramrod/network_communication/peer_table.h"
+#include "ramrod/network_communication/reconnection_policy.h"
+#include "ramrod/network_communication/reliable_udp.h"
+#include "ramrod/network_communication/send_queue.h"
+#include "ramrod/network_communication/socket_options.h"
+#include "ramrod/network_communication/thread_affinity.h"
+#include "ramrod/network_communication/timestamping.h"
+#include "ramrod/network_communication/event_loop.h"
+#include "ramrod/network_communication/worker_pool.h"
+#include "ramrod/network_communication/zero_copy.h"
 
 namespace ramrod {
   namespace network_communication {
+    /**
+     * @brief Functions called by a server working in multi-client mode (see `server::listen()`),
+     *        all of them are executed in the server's worker threads and receive the file
+     *        descriptor of the client that triggered the event. Any of them could be empty.
+     *
+     * A client is never handled by two threads at the same time, so there is no need to
+     * synchronize the code that reads or writes the same client.
+     */
+    struct connection_handlers {
+      // Called once after a new client is accepted and before any other event of that client
+      std::function<void(const int client_fd)> connected;
+      // There is data waiting to be read with `server::receive_from()`
+      std::function<void(const int client_fd)> readable;
+      // The client can accept more data, only called if `server::notify_writable()` was enabled
+      std::function<void(const int client_fd)> writable;
+      // The client closed the connection, the descriptor is closed after this returns
+      std::function<void(const int client_fd)> disconnected;
+    };
+
     class server : public conversor
     {
     public:
       server();
       ~server();
+      /**
+       * @brief Getting the priority of a logical channel, see `send_channel()`
+       *
+       * @param channel Channel to read
+       *
+       * @return Its priority, 0 is the most urgent one and the default
+       */
+      std::uint8_t channel_priority(const std::uint8_t channel);
+      /**
+       * @brief Setting the priority of a logical channel, the next chunk sent is always
+       *        from the most urgent channel with queued messages
+       *
+       * Messages already queued keep their previous priority.
+       *
+       * @param channel  Channel to change
+       * @param priority New priority, smaller than `channel_priorities`
+       *
+       * @return `false` if the priority is not valid (and `errno` will be `EINVAL`)
+       */
+      bool channel_priority(const std::uint8_t channel, const std::uint8_t priority);
+      /**
+       * @brief Getting the number of clients connected while working in multi-client mode
+       *
+       * @return Number of connected clients
+       */
+      std::size_t clients();
+      /**
+       * @brief Closes the connection with one client while working in multi-client mode
+       *
+       * The closing is performed by the worker threads, therefore the `disconnected`
+       * handler will be called after this function returns.
+       *
+       * @param client_fd File descriptor of the client
+       *
+       * @return `false` if the client does not exist
+       */
+      bool close_client(const int client_fd);
+      /**
+       * @brief Getting the compression of the messages, see
+       *        `compression(const compression_options&)`
+       *
+       * @return Current options, the algorithm is `none` by default
+       */
+      compression_options compression();
+      /**
+       * @brief Setting the compression of `send_message()`, `send_message_queued()`,
+       *        `receive_message()` and `receive_messages()`, it is used from the next
+       *        connection
+       *
+       * When the algorithm is not `none`, both devices exchange their algorithms just after
+       * connecting and the messages are compressed only if both have one in common, see
+       * `negotiated_compression()`. The client must enable it too, otherwise the connection
+       * fails. Messages smaller than the threshold or that do not get smaller are sent as
+       * they are, with only one more byte. The other sends are never compressed.
+       *
+       * @param new_options New options
+       *
+       * @return `false` if the algorithm was not compiled (and `errno` will be
+       *         `EPROTONOSUPPORT`)
+       */
+      bool compression(const compression_options &new_options);
       /**
        * @brief Makes a TCP socket stream connection to an specific IP and port
        *
@@ -27,7 +135,8 @@ namespace ramrod {
        * one to another network's device, so the main thread will be not interrupted
        * because is waiting for the device with our selected IP address to connect.
        *
-       * @param ip          Selected IP address to connect
+       * @param ip          Selected IP address to connect, or "unix:" followed by the path
+       *                    of a local socket (see `local_prefix`), then the port is ignored
        * @param port        Port number to where the connection will be made
        * @param socket_type Defines the type of connection TCP or UDP, options:
        *                      SOCK_STREAM   Creates a TCP socket
@@ -47,6 +156,93 @@ namespace ramrod {
        * @return `false` if the connection cannot be closed
        */
       bool disconnect();
+      /**
+       * @brief Indicates if one client is connected to this server in multi-client mode
+       *
+       * @param client_fd File descriptor of the client
+       *
+       * @return `true` until the worker closes the client
+       */
+      bool has_client(const int client_fd);
+      /**
+       * @brief Getting the options of the threads created by this object
+       *
+       * @return Current options, by default the threads inherit everything
+       */
+      thread_options io_threads();
+      /**
+       * @brief Setting the CPUs, scheduling policy and name of the threads created by this
+       *        object, so they could be kept away from the CPUs of the real-time work
+       *
+       * They are the (re)connection thread, the ones that execute the *_concurrently()
+       * tasks and the queued sends, and the one of the zero copy notifications. Every name
+       * adds the role of its thread to the one of the options (like "net-send"). Running
+       * threads apply them before their next task and the connection thread from the next
+       * connection.
+       *
+       * The threads of `listen()` use them from the next `listen()`, its `cpu` replaces
+       * their CPUs.
+       *
+       * @param new_options New options
+       *
+       * @return `false` if the options are not valid (and `errno` will be `EINVAL`)
+       */
+      bool io_threads(const thread_options &new_options);
+      /**
+       * @brief Getting the maximum time that a send or receive waits for the socket to be
+       *        ready before counting it as a failed intent
+       *
+       * @return Waiting time in milliseconds, -1 means forever, default is 1000
+       */
+      int io_timeout();
+      /**
+       * @brief Setting the maximum time that a send or receive waits for the socket to be
+       *        ready before counting it as a failed intent
+       *
+       * When a `send()` or `receive()` cannot be completed (`EAGAIN` in non-blocking mode,
+       * or any error), the retry happens as soon as `poll` reports that the socket is
+       * ready, instead of sleeping a fixed time. Every expired waiting counts as one of
+       * the `max_reconnection_intents()`.
+       *
+       * @param timeout_in_milliseconds New waiting time, a negative value waits forever
+       */
+      void io_timeout(const int timeout_in_milliseconds);
+#ifdef RAMROD_NETWORK_IO_URING
+      /**
+       * @brief Checks if `send_all()` and `receive_all()` use io_uring, see
+       *        `io_uring(const bool)`
+       *
+       * @return `true` if it is enabled, default is enabled when the kernel supports it
+       */
+      bool io_uring();
+      /**
+       * @brief Enables or disables the io_uring backend of `send_all()` and `receive_all()`
+       *
+       * Only TCP connections use it, every transfer is submitted and waited for with one
+       * system call. The results, the retries and the `breaker` behave the same as the
+       * normal system calls, so both backends could be compared on the same connection.
+       *
+       * @param enable `true` to use io_uring
+       *
+       * @return `false` if the kernel does not support io_uring, the normal system calls
+       *         will be used
+       */
+      bool io_uring(const bool enable);
+      /**
+       * @brief Registers the memory of a pool in the io_uring backend, then `receive_all()`
+       *        reads into its buffers without mapping them again in every reception
+       *
+       * Only the slabs already mapped are registered, call it again after the pool grows.
+       * The pool must stay alive while it is registered, a `nullptr` unregisters it. The
+       * `flags` of `receive_all()` are ignored when the buffer is registered.
+       *
+       * @param pool Pool whose buffers will be received
+       *
+       * @return `false` if io_uring is not enabled or the registration failed (and `errno`
+       *         will be set accordingly)
+       */
+      bool io_uring_buffers(const buffer_pool *pool);
+#endif
       /**
        * @brief Getting the current IP address
        *
@@ -59,6 +255,124 @@ namespace ramrod {
        * @return `true` if there is an open connection
        */
       bool is_connected();
+      /**
+       * @brief Subscribes this UDP server to a multicast group
+       *
+       * Start it in multi-peer mode with `listen_peers()` bound to the group's address (or
+       * to any address) and port, then every datagram that is published to the group is
+       * received with `receive_from_peer()`. The groups are joined again every time it
+       * binds, and if it is not bound yet they are joined when it does.
+       *
+       * @param group     Numeric address of the group, like 239.0.0.1 or ff02::1
+       * @param interface Interface where the group is joined, its name (like "eth0") or
+       *                  its IPv4 address, empty lets the system decide
+       *
+       * @return `false` if it is a TCP server or the current socket could not join the
+       *         group (and `errno` will be set accordingly)
+       */
+      bool join_group(const std::string &group, const std::string &interface = std::string());
+      /**
+       * @brief Checks if the durations of the transfers and connections are measured,
+       *        see `metrics()`
+       *
+       * @return `true` if they are measured, default is `false`
+       */
+      bool latency_metrics();
+      /**
+       * @brief Enables or disables measuring the durations of the transfers and
+       *        connections, it reads the clock twice in every call
+       *
+       * @param enable `true` to record the latencies in the histograms of `metrics()`
+       */
+      void latency_metrics(const bool enable);
+      /**
+       * @brief Unsubscribes this UDP server from a multicast group, see `join_group()`
+       *
+       * @param group     Numeric address of the group
+       * @param interface Interface used to join the group
+       *
+       * @return `false` if the group was not joined or the current socket could not leave
+       *         it (and `errno` will be set accordingly)
+       */
+      bool leave_group(const std::string &group, const std::string &interface = std::string());
+      /**
+       * @brief Starts a TCP server that accepts multiple clients (multi-client mode)
+       *
+       * This will disconnect any previous connection. One `epoll` event loop watches the
+       * listening socket and every accepted client, when a client is ready the corresponding
+       * function of `handlers` is executed by a small pool of worker threads. All the client
+       * sockets are non-blocking, so read them inside the `readable` handler with
+       * `receive_from()` until it returns -1 with `errno` set to `EAGAIN`.
+       *
+       * @param ip         Selected IP address to bind, or "unix:" followed by the path of a
+       *                   local socket (see `local_prefix`), then the port is ignored
+       * @param handlers   Functions that will handle the clients' events
+       * @param port       Port number to where the connection will be made
+       * @param workers    Number of threads that will execute the handlers
+       * @param concurrent Indicates if the binding should be made in a different thread, in
+       *                   this way the main thread should not await for the port to be free
+       * @param cpu        CPU where the event loop and the workers will be pinned, a negative
+       *                   value lets the system decide
+       *
+       * @return `false` if there is already a pending connection open, call `disconnect()`
+       *         to cancel such connection
+       */
+      bool listen(const std::string &ip, const connection_handlers &handlers,
+                  const int port = 1313, const std::size_t workers = 2,
+                  const bool concurrent = true, const int cpu = -1);
+      /**
+       * @brief Starts a UDP server that exchanges datagrams with many peers (multi-peer mode)
+       *
+       * This will disconnect any previous connection. There is no "identifier" handshake,
+       * every received datagram registers its sender in a table of peers (up to
+       * `max_peers()`), see `receive_from_peer()`, and the replies are sent with
+       * `send_to_peer()`. The single-client functions like `receive()` accept the
+       * datagrams of any peer and `send()` fails with `EDESTADDRREQ`.
+       *
+       * @param ip         Selected IP address to bind
+       * @param port       Port number to where the connection will be made
+       * @param concurrent Indicates if the binding should be made in a different thread, in
+       *                   this way the main thread should not await for the port to be free
+       *
+       * @return `false` if there is already a pending connection open, call `disconnect()`
+       *         to cancel such connection
+       */
+      bool listen_peers(const std::string &ip, const int port = 1313,
+                        const bool concurrent = true);
+      /**
+       * @brief Getting the biggest message that `receive_message()` and `receive_messages()`
+       *        accept
+       *
+       * @return Maximum message size in bytes, default is 65536
+       */
+      std::size_t max_message_size();
+      /**
+       * @brief Setting the biggest message that `receive_message()` and `receive_messages()`
+       *        accept, the internal receiving buffer uses twice this size
+       *
+       * Any message that was partially received is discarded, call it before connecting.
+       *
+       * @param new_max_message_size New maximum message size in bytes
+       *
+       * @return `false` if the value is zero
+       */
+      bool max_message_size(const std::size_t new_max_message_size);
+      /**
+       * @brief Getting the maximum number of peers in multi-peer mode, see `listen_peers()`
+       *
+       * @return Maximum number of peers, default is 4096
+       */
+      std::size_t max_peers();
+      /**
+       * @brief Setting the maximum number of peers in multi-peer mode, the datagrams of
+       *        new peers are still received when the table is full but they get no
+       *        identifier, the current peers are kept
+       *
+       * @param new_max_peers New maximum number of peers
+       *
+       * @return `false` if the value is zero
+       */
+      bool max_peers(const std::size_t new_max_peers);
       /**
        * @brief Getting how many pending connections you can have before the
        *        kernel starts rejecting new ones.
@@ -75,6 +389,21 @@ namespace ramrod {
        * @return `false` if the value is negative
        */
       bool max_queue(const int new_max_queue);
+      /**
+       * @brief Getting the limit of bytes waiting in the queue of `send_queued()`
+       *
+       * @return Maximum bytes, default is 64 MiB
+       */
+      std::size_t max_queued_bytes();
+      /**
+       * @brief Setting the limit of bytes waiting in the queue of `send_queued()`, the
+       *        messages already queued are not removed
+       *
+       * @param new_max_queued_bytes New maximum bytes
+       *
+       * @return `false` if the value is 0
+       */
+      bool max_queued_bytes(const std::size_t new_max_queued_bytes);
       /**
        * @brief Getting the maximum number of intents to connect to another network's device
        *
@@ -87,12 +416,141 @@ namespace ramrod {
        * @param new_max_intents New number of maximum reconnection intents
        */
       void max_reconnection_intents(const std::uint32_t new_max_intents);
+      /**
+       * @brief Getting when the bytes that completed the last message of
+       *        `receive_message()` or `receive_messages()` were received
+       *
+       * Every message that one reception completed has the same timestamp, so it is also
+       * valid for all the messages given to the handler of `receive_messages()`.
+       *
+       * @return Timestamps of the last reception of the message functions, both are 0 if
+       *         `socket_options::receive_timestamps` is disabled
+       */
+      packet_timestamp message_timestamp();
+      /**
+       * @brief Getting the counters of all the clients of this server: bytes, messages, errors, retries,
+       *        exhausted intents, connections and the latency histograms
+       *
+       * All the functions update them with relaxed atomics, so reading them does not stop
+       * any transfer, use `metrics_snapshot::to_text()` to export them.
+       *
+       * The server does not measure the latency of the connections.
+       *
+       * @return Copy of the current values
+       */
+      metrics_snapshot metrics();
+      /**
+       * @brief Getting the algorithm agreed with the other device for the current
+       *        connection, see `compression()`
+       *
+       * @return The algorithm that compresses the messages, or `none`
+       */
+      compression_algorithm negotiated_compression();
+      /**
+       * @brief Indicates if the socket is in non-blocking mode
+       *
+       * @return `true` if the `O_NONBLOCK` flag is used, default is `false`
+       */
+      bool non_blocking();
+      /**
+       * @brief Enables or disables the non-blocking mode
+       *
+       * In non-blocking mode the socket has the `O_NONBLOCK` flag, `send()` and `receive()`
+       * never block inside the kernel and all the waiting is made with `poll` using the
+       * `io_timeout()`, in this way any waiting can be cancelled. The change is applied to
+       * the current connection and to the following ones.
+       *
+       * @param enable `true` to use the non-blocking mode
+       *
+       * @return `false` if the current connection could not be changed
+       */
+      bool non_blocking(const bool enable);
+      /**
+       * @brief Enables or disables the `writable` handler of one client while working in
+       *        multi-client mode
+       *
+       * Enable it when `send_to()` could not send everything because the client's buffer
+       * is full, and disable it when all the pending data was sent, otherwise the handler
+       * will be called continuously.
+       *
+       * @param client_fd File descriptor of the client
+       * @param enable    `true` to receive the `writable` events
+       *
+       * @return `false` if the client does not exist
+       */
+      bool notify_writable(const int client_fd, const bool enable);
+      /**
+       * @brief Getting the socket options, see `socket_options`
+       *
+       * In multi-client mode the listening socket is read and every accepted client receives
+       * the options.
+       *
+       * @return The values reported by the kernel for the current connection, or the
+       *         configured values if there is no connection
+       */
+      socket_options options();
+      /**
+       * @brief Setting the socket options, they are applied before binding every new
+       *        socket (the buffer sizes must be set before establishing the connection)
+       *
+       * @param new_options Options for the current connection and the next ones
+       *
+       * @return `false` if any option could not be applied to the current connection
+       */
+      bool options(const socket_options &new_options);
+      /**
+       * @brief Getting the address of a peer in multi-peer mode
+       *
+       * @param peer    Identifier returned by `receive_from_peer()`
+       * @param address Returns the peer's address
+       * @param length  Returns the size of the address
+       *
+       * @return `false` if there is no peer with such identifier
+       */
+      bool peer_address(const int peer, sockaddr_storage *address, socklen_t *length);
+      /**
+       * @brief Getting the number of peers in multi-peer mode
+       *
+       * @return Number of peers that sent at least one datagram and were not removed
+       */
+      std::size_t peers();
       /**
        * @brief Getting the current port
        *
        * @return Port's value
        */
       int port();
+      /**
+       * @brief Getting if the queue of `send_queued()` reached the high watermark and was
+       *        not drained to the low one yet, see `queue_watermarks()`
+       *
+       * @return `true` while the client does not keep up with the queued messages
+       */
+      bool queue_saturated();
+      /**
+       * @brief Setting the watermarks of the queue of `send_queued()` and
+       *        `send_message_queued()`, so the producers know that the client does not
+       *        keep up before the queue is full and the messages are rejected
+       *
+       * The handler is called with `true` by the producer whose message reached `high`
+       * bytes, then the producers could slow down or skip stale messages, and with `false`
+       * by the sending thread when the queue was drained down to `low` bytes.
+       *
+       * @param high    Queued bytes that call the handler with `true`, 0 disables them
+       * @param low     Queued bytes that call the handler with `false` after reaching `high`
+       * @param handler Function to call, it must not queue messages itself
+       *
+       * @return `false` if `low` is not smaller than `high` (and `errno` will be `EINVAL`)
+       */
+      bool queue_watermarks(const std::size_t high, const std::size_t low,
+                            const watermark_handler &handler);
+      /**
+       * @brief Getting the number of bytes queued by `send_queued()` or
+       *        `send_message_queued()` that were not sent yet
+       *
+       * @return Bytes waiting in the queue, including the messages' headers
+       */
+      std::size_t queued_bytes();
       /**
        * @brief Receives data from a TCP socket stream
        *
@@ -119,6 +577,21 @@ namespace ramrod {
        *         size=0, or -1 on error (and `errno` will be set accordingly).
        */
       ssize_t receive(void *buffer, const std::size_t size, const int flags = 0);
+      /**
+       * @brief Receives data into several buffers with only one `recvmsg()`
+       *
+       * The buffers are filled in order, this avoids receiving into a staging buffer and
+       * copying the parts to their final place.
+       *
+       * @param buffers Array of buffers where the data will be received, it is not modified
+       * @param count   Number of elements in `buffers`
+       * @param flags   Allows you to specify more information about how the data is to be
+       *                received, the same as `receive()`
+       *
+       * @return The number of bytes actually received, or 0 when the client is disconnected,
+       *         or -1 on error (and `errno` will be set accordingly).
+       */
+      ssize_t receive(const iovec *buffers, const std::size_t count, const int flags = 0);
       /**
        * @brief Receives all required sized data from a TCP socket stream
        *
@@ -151,10 +624,76 @@ namespace ramrod {
        */
       ssize_t receive_all(void *buffer, const std::size_t size, bool *breaker = nullptr,
                           const int flags = 0);
+      /**
+       * @brief Receives data into several buffers until all of them are full
+       *
+       * This will loop until the total size of the buffers has been received, see
+       * `receive_all()`.
+       *
+       * @param buffers Array of buffers where the data will be received, it is not modified
+       * @param count   Number of elements in `buffers`
+       * @param breaker Is a pointer to a boolean variable that will break the infinite loop
+       *                when is set to `true`, if left as `nullptr` then it will keep waiting for
+       *                data until the size is fullfilled
+       * @param flags   Allows you to specify more information about how the data is to be
+       *                received, the same as `receive()`
+       *
+       * @return The number of bytes actually received, or 0 when the client is disconnected,
+       *         or -1 on error (and `errno` will be set accordingly).
+       */
+      ssize_t receive_all(const iovec *buffers, const std::size_t count, bool *breaker = nullptr,
+                          const int flags = 0);
+      /**
+       * @brief Receives all required sized data from a TCP socket stream without blocking
+       *
+       * The task is executed by this object's receiving thread, the returned operation
+       * tells when it finishes and allows to cancel it, several operations could be
+       * pending at the same time and they are executed in order.
+       *
+       * @param buffer      Is a pointer to the data you want to receive, it must stay alive
+       *                    until the operation finishes
+       * @param size        Is the number of bytes you want to receive
+       * @param on_complete Function called by the worker thread with the result when the
+       *                    task finishes, it could be empty
+       * @param flags       Allows you to specify more information about how the data is to
+       *                    be received, the same as `receive()`
+       *
+       * @return Operation whose result is the number of bytes actually received, or 0 when
+       *         the client is disconnected, or -1 on error (see `operation::error()`).
+       */
+      operation receive_all_async(void *buffer, const std::size_t size,
+                                  const operation::completion &on_complete = nullptr,
+                                  const int flags = 0);
+      /**
+       * @brief Receives all required sized data into a buffer leased from a pool without
+       *        blocking
+       *
+       * The same as the other `receive_all_async()` but the buffer is leased by the
+       * receiving thread when the task starts, then it is given to `on_complete` which
+       * becomes its owner, in this way the caller does not allocate a buffer per message.
+       *
+       * @param pool        Pool from where the buffer is leased, it must stay alive until the
+       *                    operation finishes
+       * @param size        Is the number of bytes you want to receive, it must not be bigger
+       *                    than `pool->buffer_size()`
+       * @param on_complete Function called by the worker thread with the buffer and the
+       *                    result when the task finishes, it could be empty
+       * @param flags       Allows you to specify more information about how the data is to
+       *                    be received, the same as `receive()`
+       *
+       * @return Operation whose result is the number of bytes actually received, or 0 when
+       *         the client is disconnected, or -1 on error (see `operation::error()`,
+       *         `EMSGSIZE` if `size` is bigger than the pool's buffers or `ENOMEM` if there
+       *         was no memory for a new buffer).
+       */
+      operation receive_all_async(buffer_pool *pool, const std::size_t size,
+                                  const lease_completion &on_complete, const int flags = 0);
       /**
        * @brief Receives all required sized data from a TCP socket stream in a different thread
        *
-       * This will loop until all the specified data's size has been received
+       * This will loop until all the specified data's size has been received. The task is
+       * executed by this object's receiving thread, which is created once and reused, tasks
+       * posted by several calls are executed one after the other in the same order.
        *
        * @param buffer  Is a pointer to the data you want to receive
        * @param size    Is a pointer to the number of bytes you want to receive, when the task is
@@ -186,7 +725,72 @@ namespace ramrod {
       bool receive_all_concurrently(void *buffer, std::size_t *size, bool *breaker = nullptr,
                                     const int flags = 0);
       /**
-       * @brief Receives all required sized data from a TCP socket stream
+       * @brief Receives data from a TCP socket stream without blocking
+       *
+       * The task is executed by this object's receiving thread, the returned operation
+       * tells when it finishes and allows to cancel it, several operations could be
+       * pending at the same time and they are executed in order.
+       *
+       * @param buffer      Is a pointer to the data you want to receive, it must stay alive
+       *                    until the operation finishes
+       * @param size        Is the number of bytes you want to receive
+       * @param on_complete Function called by the worker thread with the result when the
+       *                    task finishes, it could be empty
+       * @param flags       Allows you to specify more information about how the data is to
+       *                    be received, the same as `receive()`
+       *
+       * @return Operation whose result is the number of bytes actually received, or 0 when
+       *         the client is disconnected, or -1 on error (see `operation::error()`).
+       */
+      operation receive_async(void *buffer, const std::size_t size,
+                              const operation::completion &on_complete = nullptr,
+                              const int flags = 0);
+      /**
+       * @brief Receives data into a buffer leased from a pool without blocking
+       *
+       * The same as the other `receive_async()` but the buffer is leased by the receiving
+       * thread when the task starts, then it is given to `on_complete` which becomes its
+       * owner, in this way the caller does not allocate a buffer per message.
+       *
+       * @param pool        Pool from where the buffer is leased, it must stay alive until the
+       *                    operation finishes, up to `pool->buffer_size()` bytes are received
+       * @param on_complete Function called by the worker thread with the buffer and the
+       *                    result when the task finishes, it could be empty
+       * @param flags       Allows you to specify more information about how the data is to
+       *                    be received, the same as `receive()`
+       *
+       * @return Operation whose result is the number of bytes actually received, or 0 when
+       *         the client is disconnected, or -1 on error (see `operation::error()`, `ENOMEM`
+       *         if there was no memory for a new buffer).
+       */
+      operation receive_async(buffer_pool *pool, const lease_completion &on_complete,
+                              const int flags = 0);
+      /**
+       * @brief Receives the messages sent with `send_channel()` by the other device
+       *
+       * It waits until at least one message of any channel is complete, then `handler` is
+       * called for it and for every other message completed by the chunks that arrived
+       * together. The chunks of incomplete messages are kept until the next call.
+       *
+       * @param handler Function called for every message with its channel, the pointer it
+       *                receives is only valid until it returns
+       * @param breaker Is a pointer to a boolean variable that will break the infinite loop
+       *                when is set to `true`, if left as `nullptr` then it will keep waiting
+       *                until a complete message arrives
+       * @param flags   Allows you to specify more information about how the data is to be
+       *                received, the same as `receive()`
+       *
+       * @return The number of messages, or 0 when the client is disconnected, or -1 on error
+       *         (and `errno` will be set accordingly, `EPROTO` if a chunk was not sent by
+       *         `send_channel()`)
+       */
+      int receive_channels(const channel_handler &handler, bool *breaker = nullptr,
+                           const int flags = 0);
+      /**
+       * @brief Receives data from a TCP socket stream in a different thread
+       *
+       * The task is executed by this object's receiving thread, in the same order as the
+       * other receiving tasks.
        *
        * @param buffer Is a pointer to the data you want to receive
        * @param size   Is a pointer to the number of bytes you want to receive, when the task is
@@ -213,6 +817,161 @@ namespace ramrod {
        * @return `false` if there is no open connection, or if size=0
        */
       bool receive_concurrently(void *buffer, std::size_t *size, const int flags = 0);
+      /**
+       * @brief Receives several UDP datagrams with only one `recvmmsg()`
+       *
+       * It waits until at least one datagram arrives, then it returns every datagram that
+       * was already waiting up to `count` (or `max_datagram_batch`), the length and source
+       * address of each one are written in its element of `datagrams`.
+       *
+       * Only the datagrams that come from the connected client are kept, they are moved to
+       * the beginning of the array (swapping the whole elements, buffers included).
+       *
+       * @param datagrams Array where the datagrams will be received, `buffer` and `size`
+       *                  must be set in every element
+       * @param count     Number of elements in `datagrams`
+       * @param flags     Allows you to specify more information about how the data is to be
+       *                  received, the same as `receive()`
+       *
+       * @return The number of datagrams received, or 0 when the client is disconnected, or -1
+       *         on error (and `errno` will be set accordingly, `EOPNOTSUPP` with TCP).
+       */
+      int receive_datagrams(datagram *datagrams, const std::size_t count, const int flags = 0);
+      /**
+       * @brief Receives data from one client while working in multi-client mode
+       *
+       * The client sockets are non-blocking, this will not wait if there is no data.
+       *
+       * @param client_fd File descriptor of the client
+       * @param buffer    Is a pointer to the data you want to receive
+       * @param size      Is the number of bytes you want to receive
+       * @param flags     Allows you to specify more information about how the data is to be
+       *                  received, the same as `receive()`
+       *
+       * @return The number of bytes actually received, or 0 when the client is disconnected,
+       *         or -1 on error (and `errno` will be set accordingly, `EAGAIN` if there is
+       *         no more data to read).
+       */
+      ssize_t receive_from(const int client_fd, void *buffer, const std::size_t size,
+                           const int flags = 0);
+      /**
+       * @brief Receives one datagram from any peer while working in multi-peer mode
+       *
+       * It waits for the datagram unless the socket is non-blocking. The sender is looked
+       * up in the table of peers, and added if it is new.
+       *
+       * @param buffer Is a pointer to the data you want to receive
+       * @param size   Is the number of bytes you want to receive, the rest of the datagram
+       *               is discarded
+       * @param peer   Returns the identifier of the sender, or -1 if the table was full
+       * @param flags  Allows you to specify more information about how the data is to be
+       *               received, the same as `receive()`
+       *
+       * @return The number of bytes actually received, or 0 when the server is
+       *         disconnected, or -1 on error (and `errno` will be set accordingly,
+       *         `EOPNOTSUPP` if it is not in multi-peer mode).
+       */
+      ssize_t receive_from_peer(void *buffer, const std::size_t size, int *peer,
+                                const int flags = 0);
+      /**
+       * @brief Receives one message sent with `send_message()`
+       *
+       * The bytes are received into an internal buffer, so one `receive()` could bring
+       * several messages, the following calls return them without receiving again.
+       *
+       * @param buffer  Is a pointer to where the message will be copied
+       * @param size    Is the size of `buffer`
+       * @param breaker Is a pointer to a boolean variable that will break the infinite loop
+       *                when is set to `true`, if left as `nullptr` then it will keep waiting
+       *                until a complete message arrives
+       * @param flags   Allows you to specify more information about how the data is to be
+       *                received, the same as `receive()`
+       *
+       * @return The size of the message, or 0 when the client is disconnected, or -1 on error
+       *         (and `errno` will be set accordingly, `EMSGSIZE` if the message is bigger
+       *         than `size` or than `max_message_size()`, the message is lost in the first
+       *         case and the whole stream in the second one, so reconnect)
+       */
+      ssize_t receive_message(void *buffer, const std::size_t size, bool *breaker = nullptr,
+                              const int flags = 0);
+      /**
+       * @brief Receives all the messages sent with `send_message()` that arrived together
+       *
+       * It waits until at least one complete message is received, then `handler` is called
+       * for it and for every other complete message that came in the same `receive()`, in
+       * this way small messages are processed in batches without copying them.
+       *
+       * @param handler Function called for every message, the pointer it receives is only
+       *                valid until it returns
+       * @param breaker Is a pointer to a boolean variable that will break the infinite loop
+       *                when is set to `true`, if left as `nullptr` then it will keep waiting
+       *                until a complete message arrives
+       * @param flags   Allows you to specify more information about how the data is to be
+       *                received, the same as `receive()`
+       *
+       * @return The number of messages, or 0 when the client is disconnected, or -1 on error
+       *         (and `errno` will be set accordingly, `EMSGSIZE` if a message is bigger than
+       *         `max_message_size()`, the stream cannot be recovered so reconnect)
+       */
+      int receive_messages(const message_handler &handler, bool *breaker = nullptr,
+                           const int flags = 0);
+#ifdef RAMROD_NETWORK_IO_URING
+      /**
+       * @brief Receives data with an io_uring multishot reception, one request keeps
+       *        receiving into buffers leased from the pool until it is stopped
+       *
+       * There is no system call per reception, the kernel chooses a free buffer for every
+       * chunk of the TCP stream and gives it back to the pool after `handler` is called.
+       *
+       * @param pool    Pool that provides the buffers, their size is the biggest chunk
+       * @param handler Function called with every received chunk, in order
+       * @param breaker Is a pointer to a boolean variable that stops the reception when
+       *                is set to `true`, it is checked at least every 50 milliseconds
+       * @param flags   Allows you to specify more information about how the data is to be
+       *                received, the same as `receive()`
+       *
+       * @return The number of bytes received when it was stopped, or 0 when the client is
+       *         disconnected, or -1 on error (and `errno` will be set accordingly).
+       */
+      ssize_t receive_multishot(buffer_pool *pool, const data_handler &handler,
+                                bool *breaker = nullptr, const int flags = 0);
+#endif
+      /**
+       * @brief Receives the messages sent with `send_reliable()` by the other device, only
+       *        for UDP
+       *
+       * While it waits, it also sends the acknowledgements and the retransmissions, so one
+       * thread should keep calling it (even if this device only sends) or the lost
+       * datagrams will not be sent again until the next `send_reliable()`.
+       *
+       * @param handler Function called for every message in order, the pointer it receives
+       *                is only valid until it returns
+       * @param breaker Is a pointer to a boolean variable that will break the infinite loop
+       *                when is set to `true`, if left as `nullptr` then it will keep waiting
+       *                until a message arrives
+       *
+       * @return The number of messages, or 0 when the client is disconnected, or -1 on error
+       *         (and `errno` will be set accordingly, `ETIMEDOUT` if a datagram was not
+       *         acknowledged after all its retransmissions, `EOPNOTSUPP` for TCP)
+       */
+      int receive_reliable(const reliable_handler &handler, bool *breaker = nullptr);
+      /**
+       * @brief Receives data like `receive()` and the time when the kernel received it
+       *
+       * The timestamps are only reported when `socket_options::receive_timestamps` is
+       * enabled. In a TCP stream they belong to the last segment whose bytes were received.
+       *
+       * @param buffer    Is a pointer to the data you want to receive
+       * @param size      Is the number of bytes you want to receive
+       * @param timestamp Returns the timestamps, both are 0 if they were not reported
+       * @param flags     Allows you to specify more information about how the data is to be
+       *                  received, the same as `receive()`
+       *
+       * @return The number of bytes actually received, or 0 when the client is disconnected,
+       *         or -1 on error (and `errno` will be set accordingly).
+       */
+      ssize_t receive_timestamped(void *buffer, const std::size_t size,
+                                  packet_timestamp *timestamp, const int flags = 0);
       /**
        * @brief Reconnecting again
        *
@@ -228,6 +987,56 @@ namespace ramrod {
        *          there is an open pending connection, or already waiting for connection
        */
       bool reconnect(const bool concurrent = true);
+      /**
+       * @brief Getting the waiting times between the failed intents to connect and how
+       *        long the resolved addresses are reused
+       *
+       * @return Current reconnection policy
+       */
+      reconnection_policy reconnection();
+      /**
+       * @brief Setting the waiting times between the failed intents to connect and how
+       *        long the resolved addresses are reused, it is used from the next intent
+       *
+       * @param new_policy New reconnection policy
+       *
+       * @return `false` if the policy is not valid, see `is_valid()`
+       */
+      bool reconnection(const reconnection_policy &new_policy);
+      /**
+       * @brief Removes a peer from the table in multi-peer mode, if it sends again it
+       *        could receive another identifier
+       *
+       * @param peer Identifier of the peer
+       *
+       * @return `false` if there is no peer with such identifier
+       */
+      bool remove_peer(const int peer);
+      /**
+       * @brief Getting the options of `send_reliable()`
+       *
+       * @return Current options
+       */
+      reliable_options reliable_udp();
+      /**
+       * @brief Setting the options of `send_reliable()`, it discards the messages that were
+       *        not delivered yet
+       *
+       * @param new_options New options, both devices should use the same `max_payload`
+       *
+       * @return `false` if the options are not valid (and `errno` will be `EINVAL`)
+       */
+      bool reliable_udp(const reliable_options &new_options);
+      /**
+       * @brief Getting the state of the congestion control of `send_reliable()`
+       *
+       * @return Window, datagrams in flight, retransmissions and round trip time
+       */
+      reliable_statistics reliable_udp_statistics();
+      /**
+       * @brief Sets all the counters and latencies of `metrics()` to zero
+       */
+      void reset_metrics();
       /**
        * @brief Sends data to a TCP socket stream
        *
@@ -252,6 +1061,21 @@ namespace ramrod {
        *         client address information, or -1 on error (and `errno` will be set accordingly).
        */
       ssize_t send(const void *buffer, const std::size_t size, const int flags = MSG_NOSIGNAL);
+      /**
+       * @brief Sends several buffers with only one `sendmsg()`
+       *
+       * The buffers are sent in order as if they were contiguous, e.g. a small header and
+       * a big payload can be sent without copying them into a staging buffer.
+       *
+       * @param buffers Array of buffers you want to send, it is not modified
+       * @param count   Number of elements in `buffers`
+       * @param flags   Allows you to specify more information about how the data is to be
+       *                sent, the same as `send()`
+       *
+       * @return The number of bytes actually sent, or 0 when the client is disconnected,
+       *         or -1 on error (and `errno` will be set accordingly).
+       */
+      ssize_t send(const iovec *buffers, const std::size_t count, const int flags = MSG_NOSIGNAL);
       /**
        * @brief Sends all required sized data to a TCP socket stream
        *
@@ -282,10 +1106,59 @@ namespace ramrod {
        */
       ssize_t send_all(const void *buffer, const std::size_t size, bool *breaker = nullptr,
                        const int flags = MSG_NOSIGNAL);
+      /**
+       * @brief Sends several buffers until all of them are completely sent
+       *
+       * This will loop until the total size of the buffers has been sent, see `send_all()`.
+       *
+       * @param buffers Array of buffers you want to send, it is not modified
+       * @param count   Number of elements in `buffers`
+       * @param breaker Is a pointer to a boolean variable that will break the infinite loop
+       *                when is set to `true`, if left as `nullptr` then it will keep waiting for
+       *                data until the size is fullfilled
+       * @param flags   Allows you to specify more information about how the data is to be
+       *                sent, the same as `send()`
+       *
+       * @return The number of bytes actually sent, or 0 when the client is disconnected,
+       *         or -1 on error (and `errno` will be set accordingly).
+       */
+      ssize_t send_all(const iovec *buffers, const std::size_t count, bool *breaker = nullptr,
+                       const int flags = MSG_NOSIGNAL);
+      /**
+       * @brief Sends all required sized data to a TCP socket stream without blocking
+       *
+       * The task is executed by this object's sending thread, the returned operation
+       * tells when it finishes and allows to cancel it, several operations could be
+       * pending at the same time and they are executed in order.
+       *
+       * When `zero_copy()` is enabled, buffers of at least `zero_copy_minimum_size` bytes
+       * are sent without copying them into the kernel, then the operation finishes when
+       * the kernel does not use the buffer anymore, which could be after the data was
+       * acknowledged by the other device. The completion function is then called by a
+       * different thread of this object. If the connection is closed or broken before the
+       * kernel notifies it, the operation finishes with `ECANCELED` and the buffer could
+       * still be in use, it is only safe to reuse after a successful result.
+       *
+       * @param buffer      Is a pointer to the data you want to send, it must stay alive
+       *                    until the operation finishes
+       * @param size        Is the number of bytes you want to send
+       * @param on_complete Function called by the worker thread with the result when the
+       *                    task finishes, it could be empty
+       * @param flags       Allows you to specify more information about how the data is to
+       *                    be sent, the same as `send()`
+       *
+       * @return Operation whose result is the number of bytes actually sent, or 0 when
+       *         the client is disconnected, or -1 on error (see `operation::error()`).
+       */
+      operation send_all_async(const void *buffer, const std::size_t size,
+                               const operation::completion &on_complete = nullptr,
+                               const int flags = MSG_NOSIGNAL);
       /**
        * @brief Sends all required sized data to a TCP socket stream in a different thread
        *
-       * This will loop until all the specified data's size has been sent
+       * This will loop until all the specified data's size has been sent. The task is
+       * executed by this object's sending thread, which is created once and reused, tasks
+       * posted by several calls are executed one after the other in the same order.
        *
        * @param buffer Is a pointer to the data you want to send
        * @param size   Is a pointer to the number of bytes you want to send, when the task is
@@ -314,9 +1187,57 @@ namespace ramrod {
        */
       bool send_all_concurrently(const void *buffer, std::size_t *size, bool *breaker = nullptr,
                                  const int flags = MSG_NOSIGNAL);
+      /**
+       * @brief Sends data to a TCP socket stream without blocking
+       *
+       * The task is executed by this object's sending thread, the returned operation
+       * tells when it finishes and allows to cancel it, several operations could be
+       * pending at the same time and they are executed in order.
+       *
+       * @param buffer      Is a pointer to the data you want to send, it must stay alive
+       *                    until the operation finishes
+       * @param size        Is the number of bytes you want to send
+       * @param on_complete Function called by the worker thread with the result when the
+       *                    task finishes, it could be empty
+       * @param flags       Allows you to specify more information about how the data is to
+       *                    be sent, the same as `send()`
+       *
+       * @return Operation whose result is the number of bytes actually sent, or 0 when
+       *         the client is disconnected, or -1 on error (see `operation::error()`).
+       */
+      operation send_async(const void *buffer, const std::size_t size,
+                           const operation::completion &on_complete = nullptr,
+                           const int flags = MSG_NOSIGNAL);
+      /**
+       * @brief Queues one message of a logical channel, the channels share this connection
+       *        and the messages of the most urgent ones are sent first
+       *
+       * The message is copied and sent by a background task in chunks of
+       * `channel_chunk_size` bytes, after every chunk the writer takes the next one of the
+       * most urgent channel with queued messages. So a small control message does not wait
+       * until a big transfer of another channel ends, only until its current chunk (and the
+       * bytes already in the socket's sending buffer, reduce `send_buffer` in
+       * `options()` for a shorter wait). The messages of one channel keep their order.
+       *
+       * The other device must receive them with `receive_channels()` and its
+       * `max_message_size()` must be at least `channel_chunk_size + channel_header_size`,
+       * do not mix them with other kind of sends in the same connection.
+       *
+       * @param channel Logical channel of the message, see `channel_priority()`
+       * @param buffer  Is a pointer to the message you want to send, it is copied
+       * @param size    Is the size of the message
+       *
+       * @return `false` if the client is disconnected or the message could not be queued
+       *         (and `errno` will be set accordingly, `ENOBUFS` if there are too many bytes
+       *         waiting)
+       */
+      bool send_channel(const std::uint8_t channel, const void *buffer, const std::size_t size);
       /**
        * @brief Sends data to a TCP socket stream in a different thread
        *
+       * The task is executed by this object's sending thread, in the same order as the
+       * other sending tasks.
+       *
        * @param buffer Is a pointer to the data you want to send
        * @param size   Is a pointer to the number of bytes you want to send, when the task is
        *               finished it will return the total number of bytes actually sent, or 0
@@ -340,32 +1261,266 @@ namespace ramrod {
        *         you have not yet received a packet to obtain client address information.
        */
       bool send_concurrently(const void *buffer, std::size_t *size, const int flags = MSG_NOSIGNAL);
+      /**
+       * @brief Sends several UDP datagrams with `sendmmsg()`, up to `max_datagram_batch` of
+       *        them with only one system call
+       *
+       * All the datagrams are sent to the connected client, `length` and `address` are ignored.
+       *
+       * @param datagrams Array of datagrams, `buffer` and `size` must be set in every element
+       * @param count     Number of elements in `datagrams`
+       * @param flags     Allows you to specify more information about how the data is to be
+       *                  sent, the same as `send()`
+       *
+       * @return The number of datagrams sent, or 0 when the client is disconnected, or -1 on
+       *         error before sending any of them (and `errno` will be set accordingly,
+       *         `EOPNOTSUPP` with TCP).
+       */
+      int send_datagrams(const datagram *datagrams, const std::size_t count,
+                         const int flags = MSG_NOSIGNAL);
+      /**
+       * @brief Sends part of a file or a pipe to a TCP socket stream without copying it
+       *        through user space
+       *
+       * Regular files and block devices are sent with `sendfile()` and pipes with
+       * `splice()`, it loops until `length` bytes or the end of the file or pipe are sent,
+       * see `file_stream`.
+       *
+       * @param file_fd Is the file or pipe you want to send, it is not closed
+       * @param offset  Is the first byte of the file that will be sent, it must be 0 for
+       *                pipes, the offset of `file_fd` is not changed
+       * @param length  Is the number of bytes you want to send, 0 sends until the end
+       * @param breaker Is a pointer to a boolean variable that will break the infinite loop
+       *                when is set to `true`, if left as `nullptr` then it will keep sending
+       *                until everything is sent
+       *
+       * @return The number of bytes actually sent, or 0 when the client is disconnected
+       *         or there was nothing to send, or -1 on error (and `errno` will be set
+       *         accordingly, `EOPNOTSUPP` with UDP).
+       */
+      ssize_t send_file(const int file_fd, const off_t offset = 0, const std::size_t length = 0,
+                        bool *breaker = nullptr);
+      /**
+       * @brief Sends part of a file or a pipe without blocking, like `send_file()`
+       *
+       * The task is executed by this object's sending thread, in order with the other
+       * asynchronous sends. It sends chunks of up to `file_chunk_size` bytes, after every
+       * one `operation::progress()` is updated and `on_progress` is called.
+       *
+       * @param file_fd     Is the file or pipe you want to send, it must stay open until
+       *                    the operation finishes
+       * @param offset      Is the first byte of the file, it must be 0 for pipes
+       * @param length      Is the number of bytes you want to send, 0 sends until the end
+       * @param on_complete Function called by the worker thread with the result when the
+       *                    task finishes, it could be empty
+       * @param on_progress Function called by the worker thread after every chunk, it
+       *                    could be empty
+       *
+       * @return Operation whose result is the number of bytes actually sent, or 0 when
+       *         the client is disconnected, or -1 on error (see `operation::error()`).
+       */
+      operation send_file_async(const int file_fd, const off_t offset = 0,
+                                const std::size_t length = 0,
+                                const operation::completion &on_complete = nullptr,
+                                const file_progress &on_progress = nullptr);
+      /**
+       * @brief Sends one message that will be received complete by `receive_message()` or
+       *        `receive_messages()` in the other device
+       *
+       * A header with the message's size is sent before it, both are sent together by
+       * the same `sendmsg()` without copying them into another buffer.
+       *
+       * @param buffer  Is a pointer to the message you want to send
+       * @param size    Is the size of the message, it must not be bigger than the
+       *                `max_message_size()` of the other device
+       * @param breaker Is a pointer to a boolean variable that will break the infinite loop
+       *                when is set to `true`, if left as `nullptr` then it will keep trying
+       *                until the complete message is sent
+       * @param flags   Allows you to specify more information about how the data is to be
+       *                sent, the same as `send()`
+       *
+       * @return The number of bytes of the message actually sent (without the header),
+       *         or 0 when the client is disconnected, or -1 on error (and `errno` will be set
+       *         accordingly).
+       */
+      ssize_t send_message(const void *buffer, const std::uint32_t size,
+                           bool *breaker = nullptr, const int flags = MSG_NOSIGNAL);
+      /**
+       * @brief Queues one message that will be received complete by `receive_message()` or
+       *        `receive_messages()` in the other device, see `send_queued()`
+       *
+       * The header is copied together with the message, so both are written by the same
+       * `writev()` and the messages of different threads are never mixed.
+       *
+       * @param buffer Is a pointer to the message you want to send, it is copied
+       * @param size   Is the size of the message, it must not be bigger than the
+       *               `max_message_size()` of the other device
+       *
+       * @return `false` if the client is disconnected or the message could not be queued
+       *         (and `errno` will be set accordingly)
+       */
+      bool send_message_queued(const void *buffer, const std::uint32_t size);
+      /**
+       * @brief Queues bytes to be sent by a background task, any number of threads could
+       *        call it at the same time without waiting for each other or for the socket
+       *
+       * The data is copied into a lock-free queue and only one task of the sending worker
+       * writes it, then all the messages waiting are sent together with one `writev()`
+       * of up to `send_queue::max_batch` parts, in the same order they were queued. Do not
+       * mix it with the other send functions while the queue is not empty, their bytes
+       * could be written in the middle. The messages are discarded if sending them fails.
+       *
+       * @param buffer Is a pointer to the data you want to send, it is copied
+       * @param size   Is the size of the data
+       *
+       * @return `false` if the client is disconnected, or the queue already has
+       *         `max_queued_bytes()` (`errno` will be `ENOBUFS`), or the memory could not
+       *         be allocated (`ENOMEM`)
+       */
+      bool send_queued(const void *buffer, const std::size_t size);
+      /**
+       * @brief Queues one message over UDP with sequence numbers, selective
+       *        acknowledgements and congestion control, see `reliable_session`
+       *
+       * A `delivery::reliable` message is retransmitted until it is acknowledged and the
+       * other device receives it in order with `receive_reliable()`, a lost datagram only
+       * holds the reliable messages sent after it. A `delivery::sequenced` message is sent
+       * only once and the old ones that arrive late are discarded, for data where only the
+       * newest value matters. Every message is one datagram, up to `max_payload` bytes of
+       * `reliable_udp()`, and they must not be mixed with other receptions in the socket.
+       *
+       * It sends what the window and the pacing allow and reads the acknowledgements that
+       * already arrived if no thread is in `receive_reliable()`.
+       *
+       * @param buffer Is a pointer to the message you want to send, it is copied
+       * @param size   Is the size of the message
+       * @param mode   Reliable and ordered, or only sequenced
+       *
+       * @return `false` if the client is disconnected or the message could not be queued
+       *         (and `errno` will be set accordingly, `EMSGSIZE` if it is bigger than
+       *         `max_payload`, `ENOBUFS` if too many bytes are waiting, `ETIMEDOUT` if the
+       *         other device stopped acknowledging, `EOPNOTSUPP` for TCP)
+       */
+      bool send_reliable(const void *buffer, const std::size_t size,
+                         const delivery mode = delivery::reliable);
+      /**
+       * @brief Sends data to one client while working in multi-client mode
+       *
+       * The client sockets are non-blocking, this will send only what fits in the socket's
+       * buffer, use `notify_writable()` to know when more data can be sent.
+       *
+       * @param client_fd File descriptor of the client
+       * @param buffer    Is a pointer to the data you want to send
+       * @param size      Is the number of bytes you want to send
+       * @param flags     Allows you to specify more information about how the data is to be
+       *                  sent, the same as `send()`
+       *
+       * @return The number of bytes actually sent, or -1 on error (and `errno` will be set
+       *         accordingly, `EAGAIN` if the client's buffer is full).
+       */
+      ssize_t send_to(const int client_fd, const void *buffer, const std::size_t size,
+                      const int flags = MSG_NOSIGNAL);
+      /**
+       * @brief Sends one datagram to a peer while working in multi-peer mode
+       *
+       * @param peer   Identifier returned by `receive_from_peer()`
+       * @param buffer Is a pointer to the data you want to send
+       * @param size   Is the number of bytes you want to send
+       * @param flags  Allows you to specify more information about how the data is to be
+       *               sent, the same as `send()`
+       *
+       * @return The number of bytes actually sent, or 0 when the server is disconnected,
+       *         or -1 on error (and `errno` will be set accordingly, `ENOENT` if there is
+       *         no such peer or `EOPNOTSUPP` if it is not in multi-peer mode).
+       */
+      ssize_t send_to_peer(const int peer, const void *buffer, const std::size_t size,
+                           const int flags = MSG_NOSIGNAL);
       /**
        * @brief Gettting the current time that this device will wait to try to connect
        *        again if the previous intent to establish a connection failed
        *
-       * @return Current time that this device awaits
+       * @return Waiting time before the first retry, see `reconnection_policy::initial_delay`
        */
       int time_to_reconnect();
       /**
        * @brief Settting the current time that this device will wait to try to connect
        *        again if the previous intent to establish a connection failed
        *
-       * @param waiting_time_in_milliseconds New Current time that this device will wait
+       * The next retries wait longer according to `reconnection()`, the maximum delay is
+       * raised if it is smaller than this time.
+       *
+       * @param waiting_time_in_milliseconds New waiting time before the first retry
        */
       void time_to_reconnect(const int waiting_time_in_milliseconds);
+      /**
+       * @brief Checks if zero-copy sending is enabled, see `zero_copy(const bool)`
+       *
+       * @return `true` if it was requested, even if the current socket does not support it
+       */
+      bool zero_copy();
+      /**
+       * @brief Enables or disables zero-copy sending (`MSG_ZEROCOPY`) in `send_all_async()`
+       *
+       * Only TCP connections use it, it is applied to the current connection and to the
+       * next ones, default is disabled.
+       *
+       * @param enable `true` to send big buffers without copying them
+       *
+       * @return `false` if the kernel does not support it for the current socket, the
+       *         asynchronous sends will copy the data
+       */
+      bool zero_copy(const bool enable);
 
     private:
       bool close();
       bool close_child();
+      sockaddr *destination() const;
+      socklen_t destination_length() const;
+      void flush_reliable();
+      bool from_client(const sockaddr_storage &address, const socklen_t length);
+      thread_options io_thread(const char *role);
+      bool negotiate();
+      int next_message(const std::uint8_t **message, std::uint32_t *size, bool *breaker,
+                       const int flags);
+      bool receive_reliable_datagrams();
+      bool retry(const int fd, const short events, std::uint32_t *error_counter,
+                 const std::atomic<bool> *cancel);
 
       void concurrent_connector(const bool wait = false);
       void concurrent_connection();
 
-      void concurrent_receive(void *buffer, std::size_t *size, const int flags);
-      void concurrent_receive_all(void *buffer, std::size_t *size, bool *breaker, const int flags);
-      void concurrent_send(const void *buffer, std::size_t *size, const int flags);
-      void concurrent_send_all(const void *buffer, std::size_t *size, bool *breaker, const int flags);
+      ssize_t concurrent_receive(void *buffer, const std::size_t size,
+                                 const std::atomic<bool> *cancel, const int flags);
+      ssize_t concurrent_receive_all(void *buffer, const std::size_t size, bool *breaker,
+                                     const std::atomic<bool> *cancel, const int flags);
+      void concurrent_receive_leased(buffer_pool *pool, const std::size_t size, const bool all,
+                                     operation task, const lease_completion &on_complete,
+                                     const int flags);
+      ssize_t concurrent_send(const void *buffer, const std::size_t size,
+                              const std::atomic<bool> *cancel, const int flags);
+      ssize_t concurrent_send_all(const void *buffer, const std::size_t size, bool *breaker,
+                                  const std::atomic<bool> *cancel, const int flags,
+                                  std::uint32_t *sends = nullptr);
+      void concurrent_send_channels();
+      void concurrent_send_file(file_stream *stream, operation task,
+                                const file_progress &on_progress);
+      void concurrent_send_queue();
+      void concurrent_send_zero_copy(const void *buffer, const std::size_t size, operation task,
+                                     const int flags);
+      void concurrent_zero_copy_reaper();
+
+      void reactor_accept();
+      void reactor_close_all();
+      void reactor_dispatch(const int client_fd);
+      void reactor_event(const int fd, const std::uint32_t events);
+      bool reactor_start();
+
+      struct client_state {
+        std::uint32_t interest;
+        std::uint32_t pending;
+        bool busy;
+        bool fresh;
+      };
 
       std::string ip_;
       int port_;
@@ -380,10 +1535,80 @@ namespace ramrod {
       std::atomic<bool> connected_;
       std::atomic<bool> connecting_;
       bool is_tcp_;
-      addrinfo *client_;
-      addrinfo *results_;
-      struct sockaddr incoming_;
-      std::chrono::duration<long, std::milli> reconnection_time_;
+      const addrinfo *client_;
+      addrinfo peer_;
+      sockaddr_storage peer_address_;
+      sockaddr_storage incoming_;
+      reconnection_policy reconnection_;
+      address_cache addresses_;
+
+      bool reactor_;
+      std::size_t reactor_workers_;
+      int reactor_cpu_;
+      connection_handlers handlers_;
+      event_loop loop_;
+      std::unique_ptr<worker_pool> reactor_pool_;
+      std::mutex clients_mutex_;
+      std::unordered_map<int, client_state> clients_;
+
+      bool multi_peer_;
+      std::mutex peers_mutex_;
+      peer_table peers_;
+      std::mutex groups_mutex_;
+      std::vector<std::pair<std::string, std::string>> groups_;
+      std::string local_path_;
+
+      bool non_blocking_;
+      int io_timeout_;
+      socket_options options_;
+      message_buffer messages_;
+      // Timestamps of the last reception of next_message()
+      packet_timestamp message_timestamp_;
+      // Compression of the framed messages, negotiated with every new connection
+      compression_options compression_;
+      compression_algorithm negotiated_compression_;
+      // Only one message is compressed at a time, the decompression is of the receiver
+      std::mutex compression_mutex_;
+      compression_context compression_context_;
+#ifdef RAMROD_NETWORK_IO_URING
+
+      // Rings of send_all() and receive_all(), only one thread could use each one
+      std::atomic<bool> io_uring_;
+      std::mutex send_ring_mutex_;
+      std::unique_ptr<io_ring> send_ring_;
+      std::mutex receive_ring_mutex_;
+      std::unique_ptr<io_ring> receive_ring_;
+#endif
+
+      // Options of every thread created by this object, see io_threads()
+      std::mutex io_threads_mutex_;
+      thread_options io_threads_;
+
+      // Long-lived threads that execute the *_concurrently() tasks
+      worker_pool receive_worker_;
+      worker_pool send_worker_;
+
+      // Operations sent with MSG_ZEROCOPY that wait for their buffers to be released
+      std::atomic<bool> zero_copy_;
+      zero_copy_tracker zero_copy_sends_;
+      worker_pool zero_copy_worker_;
+
+      // Messages of send_queued(), only one task of send_worker_ writes them at a time
+      send_queue send_queue_;
+
+      // Messages of send_channel() by priority and the chunks of receive_channels()
+      channel_scheduler channels_;
+      channel_assembler channel_messages_;
+
+      // Messages of send_reliable(), one thread reads and one writes the socket at a time
+      reliable_session reliable_;
+      std::mutex reliable_receive_mutex_;
+      std::mutex reliable_send_mutex_;
+      std::vector<std::uint8_t> reliable_incoming_;
+      std::vector<std::uint8_t> reliable_outgoing_;
+
+      // Counters updated by every transfer, see metrics()
+      connection_metrics metrics_;
     };
 
     void signal_children_handler(const int signal);
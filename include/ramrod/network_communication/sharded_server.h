@@ -0,0 +1,191 @@
+#ifndef RAMROD_NETWORK_COMMUNICATION_SHARDED_SERVER_H
+#define RAMROD_NETWORK_COMMUNICATION_SHARDED_SERVER_H
+
+#include <cstddef>       // for size_t
+#include <memory>        // for unique_ptr
+#include <string>        // for string
+#include <sys/socket.h>  // for MSG_NOSIGNAL
+#include <sys/types.h>   // for ssize_t
+#include <thread>        // for thread
+#include <vector>        // for vector
+
+#include "ramrod/network_communication/server.h"
+#include "ramrod/network_communication/socket_options.h"
+#include "ramrod/network_communication/thread_affinity.h"
+
+namespace ramrod {
+  namespace network_communication {
+    /**
+     * @brief Several multi-client servers listening on the same port, one per CPU
+     *
+     * Every shard is a `server` in multi-client mode (see `server::listen()`) with its own
+     * listening socket bound with `SO_REUSEPORT`, its own event loop and its own workers,
+     * all of them pinned to the same CPU. The kernel spreads the incoming connections
+     * among the listening sockets, so the clients are handled by all the cores without
+     * sharing any lock between shards.
+     */
+    class sharded_server
+    {
+    public:
+      sharded_server();
+      ~sharded_server();
+      /**
+       * @brief Getting the number of connected clients of all the shards
+       *
+       * @return Number of clients
+       */
+      std::size_t clients();
+      /**
+       * @brief Closes the connection with one client, see `server::close_client()`
+       *
+       * @param client_fd File descriptor of the client
+       *
+       * @return `false` if the client does not exist in any shard
+       */
+      bool close_client(const int client_fd);
+      /**
+       * @brief Disconnects all the shards and closes all their clients, it waits for the
+       *        shards that are still binding after a concurrent `listen()`
+       *
+       * @return `false` if any shard could not be disconnected
+       */
+      bool disconnect();
+      /**
+       * @brief Getting the options of the threads of all the shards
+       *
+       * @return Current options
+       */
+      thread_options io_threads();
+      /**
+       * @brief Setting the options of the threads of all the shards, see
+       *        `server::io_threads()`
+       *
+       * When its CPUs are not empty, the next `listen()` distributes the shards over them
+       * instead of over all the CPUs allowed for this process.
+       *
+       * @param new_options Options for the current shards and the next ones
+       *
+       * @return `false` if the options are not valid (and `errno` will be `EINVAL`)
+       */
+      bool io_threads(const thread_options &new_options);
+      /**
+       * @brief Indicates if all the shards are listening
+       *
+       * @return `true` if every shard has an open listening socket
+       */
+      bool is_connected();
+      /**
+       * @brief Starts the shards, this will disconnect any previous ones
+       *
+       * @param ip         Selected IP address to bind
+       * @param handlers   Functions that will handle the clients' events, they are shared
+       *                   by all the shards so they could be called by several threads at
+       *                   the same time (but never for the same client)
+       * @param port       Port number where all the shards will listen
+       * @param shards     Number of shards, 0 creates one per CPU allowed for this process
+       *                   (or per CPU of `io_threads()`)
+       * @param workers    Number of threads of every shard that will execute the handlers
+       * @param pin        Indicates if the threads of every shard should be pinned to one
+       *                   CPU, the shards are distributed over the allowed CPUs in order
+       * @param concurrent Indicates if the binding should be made in a different thread,
+       *                   see `server::listen()`
+       *
+       * @return `false` if any shard could not start, a concurrent `listen()` returns `true`
+       *         without waiting for the shards, `is_connected()` tells when all of them
+       *         are listening
+       */
+      bool listen(const std::string &ip, const connection_handlers &handlers,
+                  const int port = 1313, const std::size_t shards = 0,
+                  const std::size_t workers = 1, const bool pin = true,
+                  const bool concurrent = true);
+      /**
+       * @brief Enables or disables the `writable` handler of one client, see
+       *        `server::notify_writable()`
+       *
+       * @param client_fd File descriptor of the client
+       * @param enable    `true` to be notified when the client can receive more data
+       *
+       * @return `false` if the client does not exist in any shard
+       */
+      bool notify_writable(const int client_fd, const bool enable);
+      /**
+       * @brief Getting the socket options of the first shard, see `server::options()`
+       *
+       * @return The options read from the kernel, or the configured ones
+       */
+      socket_options options();
+      /**
+       * @brief Setting the socket options of all the shards, `reuse_port` is always enabled
+       *
+       * @param new_options Options for the current shards and the next ones
+       *
+       * @return `false` if any option could not be applied to any current shard
+       */
+      bool options(const socket_options &new_options);
+      /**
+       * @brief Receives data from one client through the shard that accepted it, see
+       *        `server::receive_from()`
+       *
+       * @param client_fd File descriptor of the client
+       * @param buffer    Is a pointer to where the data will be received
+       * @param size      Is the number of bytes you want to receive
+       * @param flags     Allows you to specify more information about how the data is to
+       *                  be received, the same as `server::receive()`
+       *
+       * @return The number of bytes actually received, or 0 when the client is disconnected,
+       *         or -1 on error (and `errno` will be set accordingly, `ENOTCONN` if the
+       *         client does not exist in any shard).
+       */
+      ssize_t receive_from(const int client_fd, void *buffer, const std::size_t size,
+                           const int flags = 0);
+      /**
+       * @brief Sends data to one client through the shard that accepted it, see
+       *        `server::send_to()`
+       *
+       * @param client_fd File descriptor of the client
+       * @param buffer    Is a pointer to the data you want to send
+       * @param size      Is the number of bytes you want to send
+       * @param flags     Allows you to specify more information about how the data is to
+       *                  be sent, the same as `server::send()`
+       *
+       * @return The number of bytes actually sent, or -1 on error (and `errno` will be set
+       *         accordingly, `ENOTCONN` if the client does not exist in any shard).
+       */
+      ssize_t send_to(const int client_fd, const void *buffer, const std::size_t size,
+                      const int flags = MSG_NOSIGNAL);
+      /**
+       * @brief Getting one shard to use its other functions
+       *
+       * @param index Number of the shard, from 0 to `shards() - 1`
+       *
+       * @return Pointer to the shard, `nullptr` if it does not exist
+       */
+      server *shard(const std::size_t index);
+      /**
+       * @brief Getting the number of shards
+       *
+       * @return Number of shards, 0 before calling `listen()`
+       */
+      std::size_t shards();
+
+    private:
+      /**
+       * @brief Finding the shard that accepted one client
+       *
+       * @param client_fd File descriptor of the client
+       *
+       * @return Pointer to the shard, `nullptr` (and `errno` will be `ENOTCONN`) if no shard
+       *         knows the client
+       */
+      server *owner(const int client_fd);
+
+      std::vector<std::unique_ptr<server>> shards_;
+      socket_options options_;
+      thread_options io_threads_;
+      // Threads of the concurrent listen(), the shards are alive until they are joined
+      std::vector<std::thread> binders_;
+    };
+  } // namespace: network_communication
+} // namespace: ramrod
+
+#endif // RAMROD_NETWORK_COMMUNICATION_SHARDED_SERVER_H
@@ -0,0 +1,103 @@
+#ifndef RAMROD_NETWORK_COMMUNICATION_SHARED_RING_H
+#define RAMROD_NETWORK_COMMUNICATION_SHARED_RING_H
+
+#include <cstddef>       // for size_t
+#include <string>        // for string
+#include <sys/types.h>   // for ssize_t
+
+namespace ramrod {
+  namespace network_communication {
+    /**
+     * @brief One-way channel between two processes of the same device through a ring of
+     *        shared memory, without any system call while there is data or space
+     *
+     * One process calls `create()` and the other one `open()` with the same name, then
+     * exactly one of them sends and the other one receives (single producer, single
+     * consumer), use two rings for a bidirectional channel. The bytes are copied directly
+     * into the shared memory, the waiting side sleeps in a futex of the shared memory and
+     * it is only woken up when it is actually sleeping.
+     */
+    class shared_ring
+    {
+    public:
+      shared_ring();
+      ~shared_ring();
+      shared_ring(const shared_ring&) = delete;
+      shared_ring &operator=(const shared_ring&) = delete;
+      /**
+       * @brief Getting the size of the ring
+       *
+       * @return Number of bytes that could wait in the ring, 0 if it is not open
+       */
+      std::size_t capacity();
+      /**
+       * @brief Closes the ring, the other side receives the pending bytes and then 0, and
+       *        its sends fail with `EPIPE`. The creator also deletes the name.
+       */
+      void close();
+      /**
+       * @brief Creates a new ring in the shared memory
+       *
+       * @param name     Name of the shared memory object, like "sensor" (it appears in
+       *                 /dev/shm), it must not exist
+       * @param capacity Size of the ring in bytes, it is rounded up to a power of two
+       *
+       * @return `false` on error (and `errno` will be set accordingly)
+       */
+      bool create(const std::string &name, const std::size_t capacity = 1048576);
+      /**
+       * @brief Indicates if the ring is open
+       *
+       * @return `true` after a successful `create()` or `open()`
+       */
+      bool is_open();
+      /**
+       * @brief Opens a ring created by another process with `create()`
+       *
+       * @param name Name given to `create()`
+       *
+       * @return `false` on error (and `errno` will be set accordingly, `EINVAL` if it is
+       *         not a ring)
+       */
+      bool open(const std::string &name);
+      /**
+       * @brief Receives the bytes that are in the ring, waiting until there is at least one
+       *
+       * @param buffer  Is a pointer to the data you want to receive
+       * @param size    Is the maximum number of bytes you want to receive
+       * @param timeout Maximum waiting time in milliseconds, a negative value waits forever
+       *
+       * @return The number of bytes actually received, or 0 when the ring is empty and the
+       *         other side closed it, or -1 on error (and `errno` will be set accordingly,
+       *         `ETIMEDOUT` if the time expired)
+       */
+      ssize_t receive(void *buffer, const std::size_t size, const int timeout = -1);
+      /**
+       * @brief Sends as many bytes as fit in the ring, waiting until there is space for at
+       *        least one
+       *
+       * @param buffer  Is a pointer to the data you want to send
+       * @param size    Is the number of bytes you want to send
+       * @param timeout Maximum waiting time in milliseconds, a negative value waits forever
+       *
+       * @return The number of bytes actually sent, or -1 on error (and `errno` will be set
+       *         accordingly, `ETIMEDOUT` if the time expired or `EPIPE` if the other side
+       *         closed it)
+       */
+      ssize_t send(const void *buffer, const std::size_t size, const int timeout = -1);
+
+    private:
+      struct control;
+
+      bool map(const int fd, const std::size_t size);
+
+      control *control_;
+      unsigned char *data_;
+      std::size_t mapped_size_;
+      std::string name_;
+      bool creator_;
+    };
+  } // namespace: network_communication
+} // namespace: ramrod
+
+#endif // RAMROD_NETWORK_COMMUNICATION_SHARED_RING_H
@@ -0,0 +1,66 @@
+#ifndef RAMROD_NETWORK_COMMUNICATION_SOCKET_OPTIONS_H
+#define RAMROD_NETWORK_COMMUNICATION_SOCKET_OPTIONS_H
+
+namespace ramrod {
+  namespace network_communication {
+    /**
+     * @brief Options applied to the sockets of `client` and `server`, the default values
+     *        keep the system's configuration (except `reuse_address`)
+     *
+     * The boolean options other than `reuse_address` are only written when they are
+     * `true`, so `false` keeps the current value of the socket instead of clearing it. The
+     * TCP options are ignored by UDP sockets and `type_of_service` uses `IPV6_TCLASS` for
+     * IPv6 sockets.
+     */
+    struct socket_options {
+      // SO_REUSEADDR, allows binding to a port that was recently used
+      bool reuse_address{true};
+      // SO_REUSEPORT, allows several sockets to bind to the same port
+      bool reuse_port{false};
+      // SO_SNDBUF in bytes, 0 keeps the default (the kernel doubles the value)
+      int send_buffer{0};
+      // SO_RCVBUF in bytes, 0 keeps the default (the kernel doubles the value)
+      int receive_buffer{0};
+      // TCP_NODELAY, disables Nagle's algorithm so small messages are sent immediately
+      bool no_delay{false};
+      // TCP_QUICKACK, sends the acknowledgments immediately, it is not permanent: Linux
+      // disables it again, so it only affects the start of the connection
+      bool quick_ack{false};
+      // SO_BUSY_POLL in microseconds, 0 keeps the default (bigger values could need
+      // CAP_NET_ADMIN)
+      int busy_poll{0};
+      // SO_PRIORITY of the sent packets, a negative value keeps the default
+      int priority{-1};
+      // IP_TOS (or IPV6_TCLASS) of the sent packets, a negative value keeps the default
+      int type_of_service{-1};
+      // SO_TIMESTAMPING, reports when every packet was received, see `packet_timestamp`
+      bool receive_timestamps{false};
+      // Adds the network card's timestamps, the card must be configured to generate them
+      bool hardware_timestamps{false};
+    };
+
+    /**
+     * @brief Applies the options to a socket, every option is tried even if a previous
+     *        one failed
+     *
+     * @param fd      Socket to configure
+     * @param options Options to apply, the ones with default values are not changed
+     *
+     * @return `false` if any option could not be applied (and `errno` will be set
+     *         according to the last failure)
+     */
+    bool apply_socket_options(const int fd, const socket_options &options);
+    /**
+     * @brief Reads the current options of a socket
+     *
+     * @param fd Socket to read
+     *
+     * @return The values reported by the kernel, the TCP options are `false` for UDP sockets
+     *         and the buffer sizes are halved, so applying them again keeps the same
+     *         buffers
+     */
+    socket_options read_socket_options(const int fd);
+  } // namespace: network_communication
+} // namespace: ramrod
+
+#endif // RAMROD_NETWORK_COMMUNICATION_SOCKET_OPTIONS_H
@@ -0,0 +1,60 @@
+#ifndef RAMROD_NETWORK_COMMUNICATION_SOCKET_WAIT_H
+#define RAMROD_NETWORK_COMMUNICATION_SOCKET_WAIT_H
+
+#include <atomic>        // for atomic
+#include <cstdint>       // for uint32_t
+
+#include "ramrod/network_communication/connection_metrics.h"
+
+namespace ramrod {
+  namespace network_communication {
+    /**
+     * @brief Enables or disables the `O_NONBLOCK` flag of a file descriptor
+     *
+     * @param fd     File descriptor to modify
+     * @param enable `true` to make it non-blocking
+     *
+     * @return `false` if `fcntl` failed
+     */
+    bool set_non_blocking(const int fd, const bool enable);
+    /**
+     * @brief Waits until a socket is ready with `poll`
+     *
+     * @param fd                      Socket to watch
+     * @param events                  `poll` events to wait for, `POLLIN` or `POLLOUT`
+     * @param timeout_in_milliseconds Maximum waiting time, a negative value waits forever
+     * @param cancel                  Optional flag that stops the waiting when it becomes
+     *                                `true`, it is checked at least every 50 milliseconds
+     *
+     * @return 1 when the socket is ready (or it has an error or was hung up, the next
+     *         `recv`/`send` will tell which one), 0 when the time expired, or -1 on error
+     *         (and `errno` will be set accordingly, `ECANCELED` if it was cancelled)
+     */
+    int wait_for_socket(const int fd, const short events, const int timeout_in_milliseconds,
+                        const std::atomic<bool> *cancel = nullptr);
+    /**
+     * @brief Decides if a transfer that failed with the current `errno` will be made again,
+     *        waiting until the socket is ready
+     *
+     * Signal interruptions are retried immediately. Every other iteration counts at most
+     * one intent, when it was an error or when the socket was not ready in time.
+     *
+     * @param fd                      Socket to watch
+     * @param events                  `poll` events to wait for, `POLLIN` or `POLLOUT`
+     * @param timeout_in_milliseconds Maximum waiting time, see `wait_for_socket()`
+     * @param max_intents             Intents allowed before failing
+     * @param error_counter           Intents of this transfer, increased by this function
+     * @param cancel                  Optional flag that stops the waiting, see
+     *                                `wait_for_socket()`
+     * @param metrics                 Optional counters of the retries and failures
+     *
+     * @return `false` if the transfer must fail (and `errno` will be set accordingly)
+     */
+    bool retry_transfer(const int fd, const short events, const int timeout_in_milliseconds,
+                        const std::uint32_t max_intents, std::uint32_t *error_counter,
+                        const std::atomic<bool> *cancel = nullptr,
+                        connection_metrics *metrics = nullptr);
+  } // namespace: network_communication
+} // namespace: ramrod
+
+#endif // RAMROD_NETWORK_COMMUNICATION_SOCKET_WAIT_H
@@ -0,0 +1,81 @@
+#ifndef RAMROD_NETWORK_COMMUNICATION_THREAD_AFFINITY_H
+#define RAMROD_NETWORK_COMMUNICATION_THREAD_AFFINITY_H
+
+#include <string>        // for string
+#include <vector>        // for vector
+
+namespace ramrod {
+  namespace network_communication {
+    /**
+     * @brief Where and how the threads created by this library run, so they could be kept
+     *        away from the CPUs of the real-time work
+     */
+    struct thread_options {
+      // CPUs where the threads may run, see `node_cpus()`, empty keeps the inherited ones
+      std::vector<int> cpus;
+      // SCHED_OTHER, SCHED_BATCH, SCHED_IDLE, SCHED_FIFO or SCHED_RR, a negative value
+      // keeps the inherited one
+      int policy{-1};
+      // From 1 to 99 for SCHED_FIFO and SCHED_RR, the other policies only accept 0
+      int priority{0};
+      // Prefix of the names, every thread adds its role (like "-send"), empty keeps the
+      // inherited name
+      std::string name;
+    };
+
+    /**
+     * @brief Getting the CPUs where this process is allowed to run
+     *
+     * @return Ordered list of CPU numbers, empty if `sched_getaffinity` failed
+     */
+    std::vector<int> allowed_cpus();
+    /**
+     * @brief Applies the options to the calling thread, everything is tried even if one
+     *        of them fails
+     *
+     * @param options Options to apply, the name is truncated to 15 characters
+     *
+     * @return `false` if any of them could not be applied (and `errno` will be set
+     *         accordingly, `EPERM` if a real-time policy needs `CAP_SYS_NICE`)
+     */
+    bool configure_current_thread(const thread_options &options);
+    /**
+     * @brief Getting the CPUs of a NUMA node, to keep the threads close to the memory and
+     *        the network card they use
+     *
+     * @param node NUMA node number
+     *
+     * @return Ordered list of CPU numbers, empty if the node does not exist
+     */
+    std::vector<int> node_cpus(const int node);
+    /**
+     * @brief Pins the calling thread to one CPU
+     *
+     * @param cpu CPU number, a negative value does nothing
+     *
+     * @return `false` if the CPU does not exist or it is not allowed for this process
+     */
+    bool pin_current_thread(const int cpu);
+    /**
+     * @brief Getting the options of a thread with one role, its name is the one of the
+     *        options followed by the role
+     *
+     * @param options Options of all the threads
+     * @param role    Short description of what the thread does
+     *
+     * @return Same options with the name of the thread
+     */
+    thread_options thread_role(const thread_options &options, const char *role);
+    /**
+     * @brief Checking the options before any thread uses them
+     *
+     * @param options Options to check
+     *
+     * @return `false` if a CPU, the policy or its priority are out of range (and `errno`
+     *         will be `EINVAL`)
+     */
+    bool validate_thread_options(const thread_options &options);
+  } // namespace: network_communication
+} // namespace: ramrod
+
+#endif // RAMROD_NETWORK_COMMUNICATION_THREAD_AFFINITY_H
@@ -0,0 +1,70 @@
+#ifndef RAMROD_NETWORK_COMMUNICATION_TIMESTAMPING_H
+#define RAMROD_NETWORK_COMMUNICATION_TIMESTAMPING_H
+
+#include <cstddef>       // for size_t
+#include <cstdint>       // for int64_t
+#include <ctime>         // for timespec
+#include <sys/socket.h>  // for msghdr, CMSG_SPACE
+
+namespace ramrod {
+  namespace network_communication {
+    /**
+     * @brief Times when the kernel received a packet, reported by `SO_TIMESTAMPING`
+     *
+     * Both are 0 when the socket does not have `socket_options::receive_timestamps`
+     * enabled, or when the kernel did not report them (the hardware one needs a network
+     * card that supports it).
+     */
+    struct packet_timestamp {
+      // System time (CLOCK_REALTIME) when the packet entered the network stack
+      timespec software{0, 0};
+      // Time of the network card's clock when the packet arrived, not synchronized with
+      // the system time unless it runs PTP
+      timespec hardware{0, 0};
+
+      /**
+       * @brief Converts the software time into nanoseconds
+       *
+       * @return Nanoseconds since the epoch, 0 if it was not reported
+       */
+      std::int64_t software_nanoseconds() const;
+      /**
+       * @brief Converts the hardware time into nanoseconds
+       *
+       * @return Nanoseconds of the network card's clock, 0 if it was not reported
+       */
+      std::int64_t hardware_nanoseconds() const;
+    };
+
+    /**
+     * @brief Size of the control buffer that receives one `SCM_TIMESTAMPING` message
+     */
+    constexpr std::size_t timestamp_control_size{CMSG_SPACE(3 * sizeof(timespec))};
+
+    /**
+     * @brief Enables or disables the receiving timestamps of a socket
+     *
+     * The hardware timestamps are only reported after the network card was configured to
+     * generate them (`SIOCSHWTSTAMP`, e.g. with `hwstamp_ctl`), which needs `CAP_NET_ADMIN`.
+     *
+     * @param fd       Socket to configure
+     * @param enable   `true` to report the software timestamps of every received packet
+     * @param hardware `true` to report the hardware timestamps too
+     *
+     * @return `false` if `setsockopt` failed (and `errno` will be set accordingly)
+     */
+    bool enable_timestamping(const int fd, const bool enable, const bool hardware);
+    /**
+     * @brief Reads the timestamps from the control messages returned by `recvmsg()`
+     *
+     * @param header    Header given to `recvmsg()`, with a control buffer of at least
+     *                  `timestamp_control_size` bytes
+     * @param timestamp Returns the timestamps, they are set to 0 when not found
+     *
+     * @return `true` if there was a `SCM_TIMESTAMPING` message
+     */
+    bool read_timestamp(const msghdr &header, packet_timestamp *timestamp);
+  } // namespace: network_communication
+} // namespace: ramrod
+
+#endif // RAMROD_NETWORK_COMMUNICATION_TIMESTAMPING_H
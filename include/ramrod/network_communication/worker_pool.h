@@ -0,0 +1,96 @@
+#ifndef RAMROD_NETWORK_COMMUNICATION_WORKER_POOL_H
+#define RAMROD_NETWORK_COMMUNICATION_WORKER_POOL_H
+
+#include <condition_variable>  // for condition_variable
+#include <cstddef>             // for size_t
+#include <cstdint>             // for uint64_t
+#include <deque>               // for deque
+#include <functional>          // for function
+#include <mutex>               // for mutex
+#include <thread>              // for thread
+#include <vector>              // for vector
+
+#include "ramrod/network_communication/thread_affinity.h"
+
+namespace ramrod {
+  namespace network_communication {
+    class worker_pool
+    {
+    public:
+      /**
+       * @brief Creates a pool of long-lived threads that execute posted tasks
+       *
+       * The threads are not created until the first task is posted, in this way an
+       * unused pool does not cost anything.
+       *
+       * @param threads Number of threads that will execute the tasks, values smaller
+       *                than 1 will be changed to 1
+       * @param cpu     CPU where all the threads will be pinned, a negative value lets the
+       *                system decide
+       */
+      explicit worker_pool(const std::size_t threads = 1, const int cpu = -1);
+      /**
+       * @brief Creates a pool whose threads are configured with `configure_current_thread()`
+       *
+       * @param threads Number of threads that will execute the tasks, values smaller
+       *                than 1 will be changed to 1
+       * @param options CPUs, scheduling policy and name of all the threads
+       */
+      worker_pool(const std::size_t threads, const thread_options &options);
+      ~worker_pool();
+      /**
+       * @brief Getting the options of the threads
+       *
+       * @return Current options
+       */
+      thread_options options();
+      /**
+       * @brief Setting the options of the threads, every thread applies them before
+       *        executing its next task so the running tasks are not interrupted
+       *
+       * @param new_options New options, see `validate_thread_options()`
+       */
+      void options(const thread_options &new_options);
+      /**
+       * @brief Queues a task to be executed by one of the pool's threads
+       *
+       * Tasks are taken in the same order they were posted, with only one thread the
+       * tasks are also finished in that order.
+       *
+       * @param task Function to execute
+       *
+       * @return `false` if the pool is stopping or the task is empty
+       */
+      bool post(std::function<void()> task);
+      /**
+       * @brief Getting the number of threads used by this pool
+       *
+       * @return Number of threads
+       */
+      std::size_t size();
+      /**
+       * @brief Stops all the threads after executing the tasks that are still pending
+       *
+       * After this the pool can be used again, the threads will be created with the
+       * next posted task.
+       */
+      void stop();
+
+    private:
+      void start();
+      void work();
+
+      std::size_t size_;
+      thread_options options_;
+      // Incremented by every change of the options, so the threads know when to apply them
+      std::uint64_t generation_;
+      bool stopping_;
+      std::vector<std::thread> threads_;
+      std::deque<std::function<void()>> tasks_;
+      std::mutex mutex_;
+      std::condition_variable condition_;
+    };
+  } // namespace: network_communication
+} // namespace: ramrod
+
+#endif // RAMROD_NETWORK_COMMUNICATION_WORKER_POOL_H
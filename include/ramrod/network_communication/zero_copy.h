@@ -0,0 +1,124 @@
+#ifndef RAMROD_NETWORK_COMMUNICATION_ZERO_COPY_H
+#define RAMROD_NETWORK_COMMUNICATION_ZERO_COPY_H
+
+#include <cstddef>       // for size_t
+#include <cstdint>       // for uint32_t
+#include <deque>         // for deque
+#include <mutex>         // for mutex
+#include <sys/types.h>   // for ssize_t
+
+#include "ramrod/network_communication/operation.h"
+
+namespace ramrod {
+  namespace network_communication {
+    /**
+     * @brief Smallest buffer sent with `MSG_ZEROCOPY`, pinning the pages and reading the
+     *        notification costs more than copying smaller buffers
+     */
+    constexpr std::size_t zero_copy_minimum_size{16384};
+
+    /**
+     * @brief Enables or disables the `SO_ZEROCOPY` option of a socket
+     *
+     * @param fd     Socket to modify
+     * @param enable `true` to allow `MSG_ZEROCOPY` sends
+     *
+     * @return `false` if `setsockopt` failed (e.g. the kernel does not support it)
+     */
+    bool set_zero_copy(const int fd, const bool enable);
+
+    /**
+     * @brief Keeps the asynchronous operations whose buffers are still used by the kernel
+     *        after being sent with `MSG_ZEROCOPY`
+     *
+     * The kernel numbers every successful zero-copy `send()` of a socket, starting from
+     * zero, and reports ranges of those numbers in the socket's error queue when the pages
+     * are not needed anymore. An operation is finished when all of its sends were reported.
+     */
+    class zero_copy_tracker
+    {
+    public:
+      zero_copy_tracker();
+      ~zero_copy_tracker();
+      /**
+       * @brief Checks if zero-copy sends can be used in the current connection
+       *
+       * @return `true` if `SO_ZEROCOPY` is enabled in the socket
+       */
+      bool active() const;
+      /**
+       * @brief Registers an operation after sending its buffer
+       *
+       * @param task   Operation to finish when the buffer can be reused
+       * @param result Value returned by the sending loop
+       * @param error  Value of `errno` if `result` is -1
+       * @param sends  Number of successful `MSG_ZEROCOPY` sends done by the loop, if it is
+       *               zero the operation is finished immediately
+       *
+       * @return `true` if there was no pending operation and therefore the caller must
+       *         start executing `reap()` until `keep_reaping()` returns `false`
+       */
+      bool add(operation task, const ssize_t result, const int error, const std::uint32_t sends);
+      /**
+       * @brief Checks if the reaper must keep reading notifications
+       *
+       * @return `false` if there are no pending operations, the next `add()` will ask
+       *         for a new reaper
+       */
+      bool keep_reaping();
+      /**
+       * @brief Reads all the notifications waiting in the error queue without blocking and
+       *        finishes the operations whose sends were completed
+       *
+       * @param fd Socket used to send
+       *
+       * @return 1 if a notification was read, 0 if there was none, or -1 on error (and
+       *         `errno` will be set accordingly, also with the socket's pending error)
+       */
+      int reap(const int fd);
+      /**
+       * @brief Finishes all the pending operations with -1 and `ECANCELED`, used when the
+       *        socket is closed or broken and their notifications will never be read
+       *
+       * The kernel could still be transmitting from their buffers after `close()`, a
+       * buffer is only safe to reuse after its operation finished successfully.
+       */
+      void release();
+      /**
+       * @brief Prepares the tracker for a new connection, the numbering starts again
+       *
+       * @param active `true` if `SO_ZEROCOPY` was enabled in the new socket
+       */
+      void reset(const bool active);
+      /**
+       * @brief Changes if zero-copy sends are used without resetting the numbering, the
+       *        pending operations still wait for their notifications
+       *
+       * @param active `true` if `SO_ZEROCOPY` is enabled in the socket
+       */
+      void set_active(const bool active);
+
+    private:
+      struct pending {
+        operation task;
+        ssize_t result;
+        int error;
+        // Number of the last send that uses the operation's buffer
+        std::uint32_t last;
+      };
+
+      void finish(std::deque<pending> *finished);
+
+      mutable std::mutex mutex_;
+      std::deque<pending> pending_;
+      bool active_;
+      bool reaping_;
+      // Number that the kernel will give to the next zero-copy send
+      std::uint32_t next_;
+      // All the sends before this number were reported
+      std::uint32_t completed_;
+    };
+  } // namespace: network_communication
+} // namespace: ramrod
+
+#endif // RAMROD_NETWORK_COMMUNICATION_ZERO_COPY_H
@@ -0,0 +1,85 @@
+#include "ramrod/network_communication/address_cache.h"
+
+#include <cstring>                     // for memset
+#include <netdb.h>                     // for addrinfo, freeaddrinfo, getaddrinfo
+
+#include "ramrod/network_communication/local_socket.h"
+
+namespace ramrod {
+  namespace network_communication {
+    address_cache::address_cache() :
+      host_(),
+      port_{0},
+      socket_type_{0},
+      flags_{0},
+      results_{nullptr},
+      resolved_(),
+      local_{false},
+      local_info_(),
+      local_address_()
+    {}
+
+    address_cache::~address_cache(){
+      clear();
+    }
+
+    void address_cache::clear(){
+      if(results_ && !local_) ::freeaddrinfo(results_);
+      results_ = nullptr;
+      local_ = false;
+    }
+
+    const addrinfo *address_cache::resolve(const std::string &host, const int port,
+                                           const int socket_type, const int flags,
+                                           const int ttl, int *status){
+      *status = 0;
+      const auto now = std::chrono::steady_clock::now();
+
+      if(results_ != nullptr && ttl != 0 && host == host_ && port == port_
+         && socket_type == socket_type_ && flags == flags_
+         && (ttl < 0 || now - resolved_ < std::chrono::milliseconds(ttl)))
+        return results_;
+
+      clear();
+
+      if(is_local_address(host)){
+        socklen_t length;
+        if(socket_type != SOCK_STREAM){
+          *status = EAI_SOCKTYPE;
+          return nullptr;
+        }
+        if(!make_local_address(host, &local_address_, &length)){
+          *status = EAI_NONAME;
+          return nullptr;
+        }
+
+        local_info_ = addrinfo();
+        local_info_.ai_family = AF_UNIX;
+        local_info_.ai_socktype = socket_type;
+        local_info_.ai_addr = reinterpret_cast<sockaddr*>(&local_address_);
+        local_info_.ai_addrlen = length;
+        local_ = true;
+        results_ = &local_info_;
+      }else{
+        struct addrinfo hints;
+        std::memset(&hints, 0, sizeof(addrinfo));  // make sure the struct is empty
+        hints.ai_family   = AF_UNSPEC;             // don't care if IPv4 or IPv6
+        hints.ai_socktype = socket_type;           // UDP or TCP socket
+        hints.ai_flags    = flags;
+
+        if((*status = ::getaddrinfo(host.c_str(), std::to_string(port).c_str(),
+                                    &hints, &results_)) != 0){
+          results_ = nullptr;
+          return nullptr;
+        }
+      }
+
+      host_ = host;
+      port_ = port;
+      socket_type_ = socket_type;
+      flags_ = flags;
+      resolved_ = now;
+      return results_;
+    }
+  } // namespace: network_communication
+} // namespace: ramrod
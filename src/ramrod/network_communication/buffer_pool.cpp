@@ -0,0 +1,202 @@
+#include "ramrod/network_communication/buffer_pool.h"
+
+#include <cerrno>                      // for errno, ENOMEM
+#include <linux/mempolicy.h>           // for MPOL_PREFERRED
+#include <new>                         // for bad_alloc
+#include <sys/mman.h>                  // for mmap, munmap, MAP_ANONYMOUS
+#include <sys/syscall.h>               // for SYS_mbind
+#include <unistd.h>                    // for syscall
+#include <utility>                     // for move, swap
+#include <vector>                      // for vector
+
+#include "ramrod/console/perror.h"     // for perror, perror_stream
+
+namespace ramrod {
+  namespace network_communication {
+    struct buffer_lease::shared {
+      struct slab {
+        void *memory;
+        std::size_t length;
+      };
+
+      ~shared(){
+        for(const slab &mapped : slabs)
+          ::munmap(mapped.memory, mapped.length);
+      }
+
+      bool grow(){
+        // release() runs in destructors and noexcept moves, it must find room for every
+        // buffer of every slab, there is no non-throwing reserve()
+        try{
+          slabs.reserve(slabs.size() + 1);
+          free.reserve(total + slab_buffers);
+        }catch(const std::bad_alloc&){
+          errno = ENOMEM;
+          rr::perror("Reserving buffer pool");
+          return false;
+        }
+
+        const std::size_t length{stride * slab_buffers};
+        void *memory = ::mmap(nullptr, length, PROT_READ | PROT_WRITE,
+                              MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if(memory == MAP_FAILED){
+          rr::perror("Mapping buffer pool");
+          return false;
+        }
+
+        // Only a preference, the kernel will use other nodes if this one is full
+        if(numa_node >= 0){
+          const std::size_t word_bits{sizeof(unsigned long) * 8};
+          const std::size_t node{static_cast<std::size_t>(numa_node)};
+          std::vector<unsigned long> node_mask(node / word_bits + 1, 0);
+          node_mask.back() = 1UL << (node % word_bits);
+          // The kernel ignores the last bit of maxnode, hence the extra one
+          if(::syscall(SYS_mbind, memory, length, MPOL_PREFERRED, node_mask.data(),
+                       node_mask.size() * word_bits + 1, 0) == -1)
+            rr::perror("Binding buffer pool to NUMA node");
+        }
+
+        slabs.push_back(slab{memory, length});
+        std::uint8_t *first{static_cast<std::uint8_t*>(memory)};
+        for(std::size_t i{slab_buffers}; i > 0; --i)
+          free.push_back(first + (i - 1) * stride);
+        total += slab_buffers;
+        return true;
+      }
+
+      std::mutex mutex;
+      std::vector<slab> slabs;
+      std::vector<std::uint8_t*> free;
+      std::size_t buffer_size;
+      std::size_t stride;
+      std::size_t slab_buffers;
+      std::size_t total;
+      int numa_node;
+    };
+
+    buffer_lease::buffer_lease() :
+      pool_(),
+      data_{nullptr},
+      capacity_{0},
+      size_{0}
+    {}
+
+    buffer_lease::buffer_lease(buffer_lease &&other) noexcept :
+      pool_(std::move(other.pool_)),
+      data_{other.data_},
+      capacity_{other.capacity_},
+      size_{other.size_}
+    {
+      other.data_ = nullptr;
+      other.capacity_ = 0;
+      other.size_ = 0;
+    }
+
+    buffer_lease &buffer_lease::operator=(buffer_lease &&other) noexcept{
+      if(this != &other){
+        release();
+        std::swap(pool_, other.pool_);
+        std::swap(data_, other.data_);
+        std::swap(capacity_, other.capacity_);
+        std::swap(size_, other.size_);
+      }
+      return *this;
+    }
+
+    buffer_lease::~buffer_lease(){
+      release();
+    }
+
+    std::size_t buffer_lease::capacity() const{
+      return capacity_;
+    }
+
+    std::uint8_t *buffer_lease::data() const{
+      return data_;
+    }
+
+    bool buffer_lease::is_valid() const{
+      return data_ != nullptr;
+    }
+
+    void buffer_lease::release(){
+      if(data_ == nullptr) return;
+
+      {
+        std::lock_guard<std::mutex> lock(pool_->mutex);
+        // grow() reserved room for every buffer, so this never allocates
+        pool_->free.push_back(data_);
+      }
+      pool_.reset();
+      data_ = nullptr;
+      capacity_ = 0;
+      size_ = 0;
+    }
+
+    std::size_t buffer_lease::size() const{
+      return size_;
+    }
+
+    void buffer_lease::size(const std::size_t new_size){
+      size_ = new_size < capacity_ ? new_size : capacity_;
+    }
+
+    buffer_pool::buffer_pool(const std::size_t buffer_size, const std::size_t buffers,
+                             const int numa_node) :
+      shared_(std::make_shared<buffer_lease::shared>())
+    {
+      const std::size_t size{buffer_size > 0 ? buffer_size : 1};
+      shared_->buffer_size = size;
+      shared_->stride = (size + cache_line_size - 1) / cache_line_size * cache_line_size;
+      shared_->slab_buffers = buffers > 0 ? buffers : 1;
+      shared_->total = 0;
+      shared_->numa_node = numa_node;
+
+      std::lock_guard<std::mutex> lock(shared_->mutex);
+      shared_->grow();
+    }
+
+    buffer_lease buffer_pool::acquire(){
+      std::lock_guard<std::mutex> lock(shared_->mutex);
+      if(shared_->free.empty() && !shared_->grow())
+        return buffer_lease();
+
+      std::uint8_t *data{shared_->free.back()};
+      shared_->free.pop_back();
+      return buffer_lease(shared_, data, shared_->buffer_size);
+    }
+
+    std::size_t buffer_pool::available() const{
+      std::lock_guard<std::mutex> lock(shared_->mutex);
+      return shared_->free.size();
+    }
+
+    std::size_t buffer_pool::buffer_size() const{
+      return shared_->buffer_size;
+    }
+
+    std::size_t buffer_pool::size() const{
+      std::lock_guard<std::mutex> lock(shared_->mutex);
+      return shared_->total;
+    }
+
+    std::vector<iovec> buffer_pool::slabs() const{
+      std::lock_guard<std::mutex> lock(shared_->mutex);
+      std::vector<iovec> memory;
+      memory.reserve(shared_->slabs.size());
+      for(const buffer_lease::shared::slab &mapped : shared_->slabs)
+        memory.push_back(iovec{mapped.memory, mapped.length});
+      return memory;
+    }
+
+    // :::::::::::::::::::::::::::::::::::: PRIVATE FUNCTIONS ::::::::::::::::::::::::::::::::::::
+
+    buffer_lease::buffer_lease(const std::shared_ptr<shared> &pool, std::uint8_t *data,
+                               const std::size_t capacity) :
+      pool_(pool),
+      data_{data},
+      capacity_{capacity},
+      size_{0}
+    {}
+  } // namespace: network_communication
+} // namespace: ramrod
@@ -0,0 +1,167 @@
+#include "ramrod/network_communication/channels.h"
+
+#include <cerrno>                      // for errno, EINVAL, EMSGSIZE, ENOBUFS, EPROTO
+#include <cstring>                     // for memcpy
+
+namespace ramrod {
+  namespace network_communication {
+    namespace {
+      constexpr std::uint8_t first_chunk{1};
+      constexpr std::uint8_t last_chunk{2};
+    } // namespace: anonymous
+
+    channel_scheduler::channel_scheduler(const std::size_t max_bytes) :
+      mutex_(),
+      lanes_(),
+      priorities_(),
+      sequences_(),
+      oldest_(),
+      bytes_{0},
+      max_bytes_{max_bytes},
+      writing_{false},
+      lane_{0},
+      chunk_{0},
+      header_()
+    {
+      priorities_.fill(0);
+      sequences_.fill(0);
+      oldest_.fill(0);
+    }
+
+    bool channel_scheduler::add(const std::uint8_t channel, const void *buffer,
+                                const std::size_t size, bool *start){
+      *start = false;
+      // Copying outside the lock, the writer is not stopped by big messages
+      pending message{channel, 0, std::vector<std::uint8_t>(size), 0};
+      if(size > 0) std::memcpy(message.data.data(), buffer, size);
+
+      std::lock_guard<std::mutex> guard(mutex_);
+      if(bytes_ + size > max_bytes_){
+        errno = ENOBUFS;
+        return false;
+      }
+
+      bytes_ += size;
+      message.sequence = sequences_[channel]++;
+      lanes_[priorities_[channel]].push_back(std::move(message));
+      *start = !writing_;
+      writing_ = true;
+      return true;
+    }
+
+    std::size_t channel_scheduler::bytes() const{
+      std::lock_guard<std::mutex> guard(mutex_);
+      return bytes_;
+    }
+
+    std::size_t channel_scheduler::next(iovec *parts){
+      std::lock_guard<std::mutex> guard(mutex_);
+      for(std::size_t lane = 0; lane < channel_priorities; ++lane){
+        if(lanes_[lane].empty()) continue;
+
+        pending &message = lanes_[lane].front();
+        // An older message of its channel is in another lane since a priority change, the
+        // oldest front of all the lanes is never blocked so that one is always sent first
+        if(message.sequence != oldest_[message.channel]) continue;
+
+        const std::size_t left{message.data.size() - message.offset};
+        chunk_ = left < channel_chunk_size ? left : channel_chunk_size;
+        lane_ = lane;
+
+        std::uint8_t flags{0};
+        if(message.offset == 0) flags |= first_chunk;
+        if(message.offset + chunk_ == message.data.size()) flags |= last_chunk;
+        message_buffer::write_header(header_,
+                                     static_cast<std::uint32_t>(channel_header_size + chunk_));
+        header_[message_buffer::header_size] = message.channel;
+        header_[message_buffer::header_size + 1] = flags;
+
+        parts[0] = iovec{header_, sizeof(header_)};
+        if(chunk_ == 0) return 1;
+        parts[1] = iovec{message.data.data() + message.offset, chunk_};
+        return 2;
+      }
+
+      // Nothing left, the next add() starts a new writer
+      writing_ = false;
+      return 0;
+    }
+
+    std::uint8_t channel_scheduler::priority(const std::uint8_t channel) const{
+      std::lock_guard<std::mutex> guard(mutex_);
+      return priorities_[channel];
+    }
+
+    bool channel_scheduler::priority(const std::uint8_t channel, const std::uint8_t new_priority){
+      if(new_priority >= channel_priorities){
+        errno = EINVAL;
+        return false;
+      }
+
+      std::lock_guard<std::mutex> guard(mutex_);
+      priorities_[channel] = new_priority;
+      return true;
+    }
+
+    void channel_scheduler::sent(const bool failed){
+      std::lock_guard<std::mutex> guard(mutex_);
+      pending &message = lanes_[lane_].front();
+      const std::size_t consumed{failed ? message.data.size() - message.offset : chunk_};
+      message.offset += consumed;
+      bytes_ -= consumed;
+
+      if(message.offset < message.data.size()) return;
+      ++oldest_[message.channel];
+      lanes_[lane_].pop_front();
+    }
+
+    channel_assembler::channel_assembler(const std::size_t max_message_size) :
+      partial_(),
+      max_message_size_{max_message_size}
+    {}
+
+    int channel_assembler::add(const std::uint8_t *chunk, const std::uint32_t size,
+                               const channel_handler &handler){
+      if(size < channel_header_size){
+        errno = EPROTO;
+        return -1;
+      }
+
+      const std::uint8_t channel{chunk[0]};
+      const std::uint8_t flags{chunk[1]};
+      const std::uint8_t *data{chunk + channel_header_size};
+      const std::size_t data_size{size - channel_header_size};
+      std::vector<std::uint8_t> &partial = partial_[channel];
+
+      // A new message replaces the rest of one whose sending failed
+      if(flags & first_chunk) partial.clear();
+      else if(partial.empty()){
+        errno = EPROTO;
+        return -1;
+      }
+
+      // The whole message came at once, it is given without copying it
+      if((flags & first_chunk) && (flags & last_chunk)){
+        if(handler) handler(channel, data, data_size);
+        return 1;
+      }
+
+      if(partial.size() + data_size > max_message_size_){
+        partial.clear();
+        partial.shrink_to_fit();
+        errno = EMSGSIZE;
+        return -1;
+      }
+      partial.insert(partial.end(), data, data + data_size);
+      if(!(flags & last_chunk)) return 0;
+
+      if(handler) handler(channel, partial.data(), partial.size());
+      partial.clear();
+      return 1;
+    }
+
+    void channel_assembler::clear(){
+      for(std::vector<std::uint8_t> &partial : partial_) partial.clear();
+    }
+  } // namespace: network_communication
+} // namespace: ramrod
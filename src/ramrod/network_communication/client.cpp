@@ -3,11 +3,18 @@
 #include <cerrno>                      // for errno
 #include <cstring>                     // for memset
 #include <iosfwd>                      // for size_t
+#ifdef RAMROD_NETWORK_IO_URING
+#include <linux/io_uring.h>            // for IORING_CQE_F_MORE
+#endif
 #include <netdb.h>                     // for addrinfo, freeaddrinfo, gai_st...
+#include <poll.h>                      // for POLLIN, POLLOUT
 #include <signal.h>                    // for sigaction, sigemptyset, SA_RES...
+#include <sys/uio.h>                   // for iovec
 #include <sys/wait.h>                  // for waitpid, WNOHANG
 #include <thread>                      // for sleep_for, thread
 #include <unistd.h>                    // for ssize_t, close
+#include <utility>                     // for move
+#include <vector>                      // for vector
 
 #include "ramrod/console.h"            // for formatted
 #include "ramrod/console/attention.h"  // for attention_stream, attention
@@ -16,11 +23,30 @@
 #include "ramrod/console/perror.h"     // for perror, perror_stream
 #include "ramrod/console/types.h"      // for error
 #include "ramrod/console/warning.h"    // for warning, warning_stream
+#include "ramrod/network_communication/connect_race.h"
+#include "ramrod/network_communication/io_vectors.h"
+#include "ramrod/network_communication/multicast.h"
+#include "ramrod/network_communication/reconnection_policy.h"
+#include "ramrod/network_communication/socket_options.h"
+#include "ramrod/network_communication/socket_wait.h"
+#include "ramrod/network_communication/timestamping.h"
+#include "ramrod/network_communication/zero_copy.h"
 
 namespace ramrod {
   namespace network_communication {
+#ifdef RAMROD_NETWORK_IO_URING
+    namespace {
+      // Buffers leased by every multishot reception, and results read at once
+      constexpr std::size_t multishot_buffers{32};
+      constexpr std::uint64_t multishot_reception{1};
+      constexpr std::uint64_t multishot_cancellation{2};
+    } // namespace: anonymous
+
+#endif
     client::client() :
       conversor(),
+      attempt_delay_{default_attempt_delay},
+      connection_timeout_{5000},
       ip_(),
       port_{1313},
       socket_fd_{-1},
@@ -33,11 +59,83 @@ namespace ramrod {
       connected_{false},
       connecting_{false},
       is_tcp_{false},
-      reconnection_time_(std::chrono::milliseconds(5000))
-    {}
+      reconnection_(),
+      addresses_(),
+      non_blocking_{false},
+      io_timeout_{1000},
+      options_(),
+      multicast_(),
+      messages_(),
+      message_timestamp_(),
+      compression_(),
+      negotiated_compression_{compression_algorithm::none},
+      compression_mutex_(),
+      compression_context_(),
+#ifdef RAMROD_NETWORK_IO_URING
+      io_uring_{false},
+      send_ring_mutex_(),
+      send_ring_(),
+      receive_ring_mutex_(),
+      receive_ring_(),
+#endif
+      io_threads_mutex_(),
+      io_threads_(),
+      receive_worker_(1),
+      send_worker_(1),
+      zero_copy_{false},
+      zero_copy_sends_(),
+      zero_copy_worker_(1),
+      send_queue_(),
+      channels_(),
+      channel_messages_(),
+      reliable_(),
+      reliable_receive_mutex_(),
+      reliable_send_mutex_(),
+      reliable_incoming_(),
+      reliable_outgoing_(),
+      metrics_()
+    {
+#ifdef RAMROD_NETWORK_IO_URING
+      // The backend was chosen when compiling, it is only disabled if the kernel is too old
+      io_uring(true);
+#endif
+    }
 
     client::~client(){
       disconnect();
+      // Waiting for the pending tasks, they stop quickly because the socket is closed
+      receive_worker_.stop();
+      send_worker_.stop();
+      zero_copy_worker_.stop();
+    }
+
+    int client::attempt_delay(){
+      return attempt_delay_;
+    }
+
+    void client::attempt_delay(const int delay_in_milliseconds){
+      attempt_delay_ = delay_in_milliseconds < 0 ? 0 : delay_in_milliseconds;
+    }
+
+    std::uint8_t client::channel_priority(const std::uint8_t channel){
+      return channels_.priority(channel);
+    }
+
+    bool client::channel_priority(const std::uint8_t channel, const std::uint8_t priority){
+      return channels_.priority(channel, priority);
+    }
+
+    compression_options client::compression(){
+      return compression_;
+    }
+
+    bool client::compression(const compression_options &new_options){
+      if(!compression_context::available(new_options.algorithm)){
+        errno = EPROTONOSUPPORT;
+        return false;
+      }
+      compression_ = new_options;
+      return true;
     }
 
     bool client::connect(const std::string &ip, const int port, const int socket_type,
@@ -52,12 +150,23 @@ namespace ramrod {
       terminate_concurrent_.store(false);
 
       if(concurrent)
-        std::thread(&client::concurrent_connector, this, false).detach();
+        std::thread([this, options = io_thread("connect")]{
+          configure_current_thread(options);
+          concurrent_connector();
+        }).detach();
       else
-        concurrent_connector(true);
+        concurrent_connector();
       return true;
     }
 
+    int client::connection_timeout(){
+      return connection_timeout_;
+    }
+
+    void client::connection_timeout(const int timeout_in_milliseconds){
+      connection_timeout_ = timeout_in_milliseconds < 0 ? -1 : timeout_in_milliseconds;
+    }
+
     bool client::disconnect(){
       connecting_.store(false);
       terminate_send_.store(true);
@@ -67,6 +176,74 @@ namespace ramrod {
       return close();
     }
 
+    thread_options client::io_threads(){
+      std::lock_guard<std::mutex> guard(io_threads_mutex_);
+      return io_threads_;
+    }
+
+    bool client::io_threads(const thread_options &new_options){
+      if(!validate_thread_options(new_options)) return false;
+      {
+        std::lock_guard<std::mutex> guard(io_threads_mutex_);
+        io_threads_ = new_options;
+      }
+      receive_worker_.options(thread_role(new_options, "recv"));
+      send_worker_.options(thread_role(new_options, "send"));
+      zero_copy_worker_.options(thread_role(new_options, "zcopy"));
+      return true;
+    }
+
+    int client::io_timeout(){
+      return io_timeout_;
+    }
+
+    void client::io_timeout(const int timeout_in_milliseconds){
+      io_timeout_ = timeout_in_milliseconds < 0 ? -1 : timeout_in_milliseconds;
+    }
+
+#ifdef RAMROD_NETWORK_IO_URING
+    bool client::io_uring(){
+      return io_uring_.load();
+    }
+
+    bool client::io_uring(const bool enable){
+      if(enable){
+        std::lock_guard<std::mutex> send_lock(send_ring_mutex_);
+        std::lock_guard<std::mutex> receive_lock(receive_ring_mutex_);
+        // The rings are never destroyed before the client, disabling only stops using them
+        if(!send_ring_) send_ring_ = std::make_unique<io_ring>();
+        if(!receive_ring_) receive_ring_ = std::make_unique<io_ring>();
+
+        if(!send_ring_->is_valid() || !receive_ring_->is_valid()){
+#ifdef VERBOSE
+          rr::perror("Creating io_uring");
+#endif
+          send_ring_.reset();
+          receive_ring_.reset();
+          io_uring_.store(false);
+          return false;
+        }
+      }
+      io_uring_.store(enable);
+      return true;
+    }
+
+    bool client::io_uring_buffers(const buffer_pool *pool){
+      std::lock_guard<std::mutex> lock(receive_ring_mutex_);
+      if(!receive_ring_){
+        errno = ENODEV;
+        return false;
+      }
+
+      if(!receive_ring_->unregister_buffers() && errno != ENXIO) return false;
+      if(pool == nullptr) return true;
+
+      const std::vector<iovec> slabs{pool->slabs()};
+      return receive_ring_->register_buffers(slabs.data(), slabs.size());
+    }
+#endif
+
+
     const std::string &client::ip(){
       return ip_;
     }
@@ -75,6 +252,22 @@ namespace ramrod {
       return connected_.load(std::memory_order_relaxed);
     }
 
+    bool client::latency_metrics(){
+      return metrics_.latencies();
+    }
+
+    void client::latency_metrics(const bool enable){
+      metrics_.latencies(enable);
+    }
+
+    std::size_t client::max_message_size(){
+      return messages_.max_message_size();
+    }
+
+    bool client::max_message_size(const std::size_t new_max_message_size){
+      return messages_.max_message_size(new_max_message_size);
+    }
+
     int client::max_queue(){
       return max_queue_;
     }
@@ -85,6 +278,16 @@ namespace ramrod {
       return true;
     }
 
+    std::size_t client::max_queued_bytes(){
+      return send_queue_.max_bytes();
+    }
+
+    bool client::max_queued_bytes(const std::size_t new_max_queued_bytes){
+      if(new_max_queued_bytes == 0) return false;
+      send_queue_.max_bytes(new_max_queued_bytes);
+      return true;
+    }
+
     std::uint32_t client::max_reconnection_intents(){
       return max_intents_;
     }
@@ -93,14 +296,78 @@ namespace ramrod {
       max_intents_ = new_max_intents;
     }
 
+    packet_timestamp client::message_timestamp(){
+      return message_timestamp_;
+    }
+
+    metrics_snapshot client::metrics(){
+      return metrics_.snapshot();
+    }
+
+    multicast_options client::multicast(){
+      return multicast_;
+    }
+
+    bool client::multicast(const multicast_options &new_options){
+      multicast_ = new_options;
+      // Changing the current connection, the next ones are changed when connected
+      if(connected_.load() && socket_fd_ >= 0 && !is_tcp_)
+        return apply_multicast_options(socket_fd_, multicast_);
+      return true;
+    }
+
+    compression_algorithm client::negotiated_compression(){
+      return negotiated_compression_;
+    }
+
+    bool client::non_blocking(){
+      return non_blocking_;
+    }
+
+    bool client::non_blocking(const bool enable){
+      non_blocking_ = enable;
+      // Changing the current connection, the next ones are changed when connected
+      if(connected_.load() && socket_fd_ >= 0)
+        return set_non_blocking(socket_fd_, enable);
+      return true;
+    }
+
+    socket_options client::options(){
+      if(connected_.load() && socket_fd_ >= 0)
+        return read_socket_options(socket_fd_);
+      return options_;
+    }
+
+    bool client::options(const socket_options &new_options){
+      options_ = new_options;
+      // Changing the current connection, the next ones are changed when connected
+      if(connected_.load() && socket_fd_ >= 0)
+        return apply_socket_options(socket_fd_, options_);
+      return true;
+    }
+
     int client::port(){
       return port_;
     }
 
+    bool client::queue_saturated(){
+      return send_queue_.saturated();
+    }
+
+    bool client::queue_watermarks(const std::size_t high, const std::size_t low,
+                                const watermark_handler &handler){
+      return send_queue_.watermarks(high, low, handler);
+    }
+
+    std::size_t client::queued_bytes(){
+      return send_queue_.bytes();
+    }
+
     ssize_t client::receive(void *buffer, const std::size_t size, const int flags){      
       if(!connected_.load() || size == 0)
         return 0;
 
+      const std::uint64_t start{metrics_.start()};
       ssize_t received{0};
       std::uint32_t error_counter{0};
 
@@ -110,17 +377,41 @@ namespace ramrod {
         if(received == 0) return 0;
 
         if(received < 0){
-  #ifdef VERBOSE
-          rr::perror("Receiving data");
-  #endif
-          if(++error_counter > max_intents_)
+          // Waits until the socket is ready again, it fails after the max intents
+          if(!retry(socket_fd_, POLLIN, &error_counter, nullptr))
             return received;
+          continue;
+        }
+        return metrics_.received(received, start);
+      }
+    }
+
+    ssize_t client::receive(const iovec *buffers, const std::size_t count, const int flags){
+      if(!connected_.load() || count == 0)
+        return 0;
+
+      const std::uint64_t start{metrics_.start()};
+      io_vectors parts(buffers, count);
+      if(parts.empty()) return 0;
+
+      ssize_t received{0};
+      std::uint32_t error_counter{0};
+      msghdr header{};
+      header.msg_iov = parts.data();
+      header.msg_iovlen = parts.count();
+
+      while(true){
+        received = ::recvmsg(socket_fd_, &header, flags);
+
+        if(received == 0) return 0;
 
-          // This will try to receive the same data than the last time
-          std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        if(received < 0){
+          // Waits until the socket is ready again, it fails after the max intents
+          if(!retry(socket_fd_, POLLIN, &error_counter, nullptr))
+            return received;
           continue;
         }
-        return received;
+        return metrics_.received(received, start);
       }
     }
 
@@ -129,6 +420,7 @@ namespace ramrod {
       if(!connected_.load() || size == 0)
         return 0;
 
+      const std::uint64_t start{metrics_.start()};
       std::size_t total_received{0};
       std::size_t bytes_left = size;
       ssize_t received_size;
@@ -136,161 +428,951 @@ namespace ramrod {
       bool never{false};
       if(breaker == nullptr) breaker = &never;
 
+#ifdef RAMROD_NETWORK_IO_URING
+      if(is_tcp_ && io_uring_.load()){
+        std::lock_guard<std::mutex> lock(receive_ring_mutex_);
+        return metrics_.received(ring_receive_all(receive_ring_.get(), socket_fd_, buffer, size,
+                                                  breaker, flags, io_timeout_, max_intents_,
+                                                  &metrics_), start);
+      }
+#endif
       while(total_received < size && !(*breaker)){
         received_size = ::recv(socket_fd_, (std::uint8_t*)buffer + total_received,
                                bytes_left, flags);
 
         if(received_size == 0) return 0;
 
-        if(received_size < 0){
-#ifdef VERBOSE
-          rr::perror("Receiving data");
-#endif
-          // There is an error and returns after the max intents have been reached
-          if(++error_counter > max_intents_)
-            return received_size;
+        if(received_size < 0){
+          // Waits until the socket is ready again, it fails after the max intents
+          if(!retry(socket_fd_, POLLIN, &error_counter, nullptr))
+            return received_size;
+          continue;
+        }
+        total_received += static_cast<std::size_t>(received_size);
+        bytes_left -= static_cast<std::size_t>(received_size);
+      }
+      return metrics_.received(static_cast<ssize_t>(total_received), start);
+    }
+
+    ssize_t client::receive_all(const iovec *buffers, const std::size_t count, bool *breaker,
+                                 const int flags){
+      if(!connected_.load() || count == 0)
+        return 0;
+
+      const std::uint64_t start{metrics_.start()};
+      io_vectors parts(buffers, count);
+      std::size_t total_received{0};
+      ssize_t received_size;
+      std::uint32_t error_counter{0};
+      msghdr header{};
+      bool never{false};
+      if(breaker == nullptr) breaker = &never;
+
+      while(!parts.empty() && !(*breaker)){
+        header.msg_iov = parts.data();
+        header.msg_iovlen = parts.count();
+        received_size = ::recvmsg(socket_fd_, &header, flags);
+
+        if(received_size == 0) return 0;
+
+        if(received_size < 0){
+          // Waits until the socket is ready again, it fails after the max intents
+          if(!retry(socket_fd_, POLLIN, &error_counter, nullptr))
+            return received_size;
+          continue;
+        }
+        total_received += static_cast<std::size_t>(received_size);
+        parts.advance(static_cast<std::size_t>(received_size));
+      }
+      return metrics_.received(static_cast<ssize_t>(total_received), start);
+    }
+
+    operation client::receive_all_async(void *buffer, const std::size_t size,
+                                        const operation::completion &on_complete, const int flags){
+      operation task(on_complete);
+      if(!connected_.load() || size == 0){
+        task.finish(0);
+        return task;
+      }
+
+      if(!receive_worker_.post([this, buffer, size, flags, task]() mutable{
+           task.finish(concurrent_receive_all(buffer, size, nullptr, task.cancellation(), flags));
+         })){
+        errno = ECANCELED;
+        task.finish(-1);
+      }
+      return task;
+    }
+
+    operation client::receive_all_async(buffer_pool *pool, const std::size_t size,
+                                        const lease_completion &on_complete, const int flags){
+      operation task(nullptr);
+      if(!connected_.load() || size == 0){
+        if(on_complete) on_complete(buffer_lease(), 0);
+        task.finish(0);
+        return task;
+      }
+      if(pool == nullptr || size > pool->buffer_size()){
+        if(on_complete) on_complete(buffer_lease(), -1);
+        errno = EMSGSIZE;
+        task.finish(-1);
+        return task;
+      }
+
+      if(!receive_worker_.post([this, pool, size, on_complete, flags, task]{
+           concurrent_receive_leased(pool, size, true, task, on_complete, flags);
+         })){
+        if(on_complete) on_complete(buffer_lease(), -1);
+        errno = ECANCELED;
+        task.finish(-1);
+      }
+      return task;
+    }
+
+    bool client::receive_all_concurrently(void *buffer, std::size_t *size, bool *breaker,
+                                          const int flags){
+      if(!connected_.load() || *size == 0){
+        *size = 0;
+        return false;
+      }
+
+      if(!receive_worker_.post([this, buffer, size, breaker, flags]{
+           const ssize_t received = concurrent_receive_all(buffer, *size, breaker, nullptr, flags);
+           *size = received > 0 ? static_cast<std::size_t>(received) : 0;
+         })){
+        *size = 0;
+        return false;
+      }
+      return true;
+    }
+
+    operation client::receive_async(void *buffer, const std::size_t size,
+                                    const operation::completion &on_complete, const int flags){
+      operation task(on_complete);
+      if(!connected_.load() || size == 0){
+        task.finish(0);
+        return task;
+      }
+
+      if(!receive_worker_.post([this, buffer, size, flags, task]() mutable{
+           task.finish(concurrent_receive(buffer, size, task.cancellation(), flags));
+         })){
+        errno = ECANCELED;
+        task.finish(-1);
+      }
+      return task;
+    }
+
+    operation client::receive_async(buffer_pool *pool, const lease_completion &on_complete,
+                                    const int flags){
+      operation task(nullptr);
+      if(!connected_.load() || pool == nullptr){
+        if(on_complete) on_complete(buffer_lease(), 0);
+        task.finish(0);
+        return task;
+      }
+
+      if(!receive_worker_.post([this, pool, on_complete, flags, task]{
+           concurrent_receive_leased(pool, pool->buffer_size(), false, task, on_complete, flags);
+         })){
+        if(on_complete) on_complete(buffer_lease(), -1);
+        errno = ECANCELED;
+        task.finish(-1);
+      }
+      return task;
+    }
+
+    int client::receive_channels(const channel_handler &handler, bool *breaker, const int flags){
+      if(!connected_.load())
+        return 0;
+
+      const std::uint8_t *message;
+      std::uint32_t message_size;
+      int total{0};
+      // Chunks of incomplete messages do not count, it keeps waiting until one is complete
+      while(total == 0){
+        int status = next_message(&message, &message_size, breaker, flags);
+        if(status <= 0) return status;
+
+        do{
+          const int completed = channel_messages_.add(message, message_size, handler);
+          if(completed < 0) return -1;
+          total += completed;
+        }while((status = messages_.next(&message, &message_size)) > 0);
+      }
+
+      metrics_.messages_received(static_cast<std::uint64_t>(total));
+      return total;
+    }
+
+    bool client::receive_concurrently(void *buffer, std::size_t *size, const int flags){
+      if(!connected_.load() || *size == 0){
+        *size = 0;
+        return false;
+      }
+
+      if(!receive_worker_.post([this, buffer, size, flags]{
+           const ssize_t received = concurrent_receive(buffer, *size, nullptr, flags);
+           *size = received > 0 ? static_cast<std::size_t>(received) : 0;
+         })){
+        *size = 0;
+        return false;
+      }
+      return true;
+    }
+
+    int client::receive_datagrams(datagram *datagrams, const std::size_t count, const int flags){
+      if(!connected_.load() || count == 0)
+        return 0;
+      if(is_tcp_){
+        errno = EOPNOTSUPP;
+        return -1;
+      }
+
+      const std::size_t batch{count < max_datagram_batch ? count : max_datagram_batch};
+      mmsghdr headers[max_datagram_batch];
+      iovec parts[max_datagram_batch];
+      // Only the sockets with timestamps need room for the control messages
+      const bool timestamps{options_.receive_timestamps || options_.hardware_timestamps};
+      alignas(cmsghdr) std::uint8_t controls[max_datagram_batch][timestamp_control_size];
+      std::uint32_t error_counter{0};
+
+      while(true){
+        // The kernel overwrites the address lengths, so they are prepared every time
+        for(std::size_t i{0}; i < batch; ++i){
+          parts[i] = {datagrams[i].buffer, datagrams[i].size};
+          headers[i] = mmsghdr{};
+          headers[i].msg_hdr.msg_iov = &parts[i];
+          headers[i].msg_hdr.msg_iovlen = 1;
+          headers[i].msg_hdr.msg_name = &datagrams[i].address;
+          headers[i].msg_hdr.msg_namelen = sizeof(sockaddr_storage);
+          if(timestamps){
+            headers[i].msg_hdr.msg_control = controls[i];
+            headers[i].msg_hdr.msg_controllen = sizeof(controls[i]);
+          }
+        }
+
+        // Returns after the first datagram instead of waiting for the whole batch
+        const int received = ::recvmmsg(socket_fd_, headers, static_cast<unsigned int>(batch),
+                                        flags | MSG_WAITFORONE, nullptr);
+        if(received > 0){
+          std::size_t bytes{0};
+          for(int i{0}; i < received; ++i){
+            bytes += headers[i].msg_len;
+            datagrams[i].length = headers[i].msg_len;
+            datagrams[i].truncated = (headers[i].msg_hdr.msg_flags & MSG_TRUNC) != 0;
+            datagrams[i].address_length = headers[i].msg_hdr.msg_namelen;
+            read_timestamp(headers[i].msg_hdr, &datagrams[i].timestamp);
+          }
+          metrics_.received(static_cast<ssize_t>(bytes));
+          metrics_.messages_received(static_cast<std::uint64_t>(received));
+          return received;
+        }
+
+        // Waits until the socket is ready again, it fails after the max intents
+        if(!retry(socket_fd_, POLLIN, &error_counter, nullptr))
+          return -1;
+      }
+    }
+
+    ssize_t client::receive_message(void *buffer, const std::size_t size, bool *breaker,
+                                    const int flags){
+      if(!connected_.load() || size == 0)
+        return 0;
+
+      const std::uint8_t *message;
+      std::uint32_t message_size;
+      const int status = next_message(&message, &message_size, breaker, flags);
+      if(status <= 0) return status;
+
+      const std::uint8_t *data{message};
+      std::size_t data_size{message_size};
+      if(negotiated_compression_ != compression_algorithm::none
+         && !compression_context_.decompress(message, message_size, size, &data, &data_size))
+        return -1;
+
+      if(data_size > size){
+        errno = EMSGSIZE;
+        return -1;
+      }
+      std::memcpy(buffer, data, data_size);
+      metrics_.messages_received();
+      return static_cast<ssize_t>(data_size);
+    }
+
+    int client::receive_messages(const message_handler &handler, bool *breaker, const int flags){
+      if(!connected_.load())
+        return 0;
+
+      const std::uint8_t *message;
+      std::uint32_t message_size;
+      // Only the first message could wait for receiving more bytes
+      int status = next_message(&message, &message_size, breaker, flags);
+      if(status <= 0) return status;
+
+      const bool compressed{negotiated_compression_ != compression_algorithm::none};
+      const std::uint8_t *data;
+      std::size_t data_size;
+      int total{0};
+      do{
+        data = message;
+        data_size = message_size;
+        if(compressed && !compression_context_.decompress(message, message_size,
+                                                          messages_.max_message_size(),
+                                                          &data, &data_size))
+          return -1;
+        ++total;
+        if(handler) handler(data, static_cast<std::uint32_t>(data_size));
+      }while((status = messages_.next(&message, &message_size)) > 0);
+
+      metrics_.messages_received(static_cast<std::uint64_t>(total));
+      // The broken message will be reported in the next call
+      return total;
+    }
+
+#ifdef RAMROD_NETWORK_IO_URING
+    ssize_t client::receive_multishot(buffer_pool *pool, const data_handler &handler,
+                                      bool *breaker, const int flags){
+      if(!connected_.load())
+        return 0;
+      if(!is_tcp_ || pool == nullptr){
+        errno = EINVAL;
+        return -1;
+      }
+
+      // The leases are declared before the ring, so the kernel stops using the buffers
+      // before they return to the pool
+      std::vector<buffer_lease> leases(multishot_buffers);
+      std::vector<iovec> buffers(multishot_buffers);
+      for(std::size_t i = 0; i < multishot_buffers; ++i){
+        leases[i] = pool->acquire();
+        if(!leases[i].is_valid()){
+          errno = ENOMEM;
+          return -1;
+        }
+        buffers[i] = iovec{leases[i].data(), leases[i].capacity()};
+      }
+
+      io_ring ring;
+      if(!ring.is_valid() || !ring.provide_buffers(buffers.data(), buffers.size())){
+#ifdef VERBOSE
+        rr::perror("Preparing multishot reception");
+#endif
+        return -1;
+      }
+
+      io_completion results[multishot_buffers];
+      std::size_t total_received{0};
+      std::uint32_t error_counter{0};
+      bool armed{false};
+      bool cancelling{false};
+      bool never{false};
+      if(breaker == nullptr) breaker = &never;
+
+      while(true){
+        if(!armed){
+          if(*breaker) return static_cast<ssize_t>(total_received);
+          if(!ring.prepare_receive_multishot(socket_fd_, flags, multishot_reception))
+            return -1;
+          armed = true;
+          cancelling = false;
+        }
+        if(*breaker && !cancelling){
+          ring.prepare_cancel(multishot_reception, multishot_cancellation);
+          cancelling = true;
+        }
+
+        // Waking up periodically to check the breaker
+        const int count{ring.wait(results, multishot_buffers, 50)};
+        if(count < 0) return -1;
+
+        for(int i = 0; i < count; ++i){
+          const io_completion &result{results[i]};
+          if(result.user_data != multishot_reception) continue;
+
+          // The kernel stopped the reception, it is armed again in the next iteration
+          if((result.flags & IORING_CQE_F_MORE) == 0) armed = false;
+
+          if(result.result > 0){
+            if(handler) handler(ring.provided_buffer(result),
+                                static_cast<std::size_t>(result.result));
+            ring.recycle(result);
+            metrics_.received(result.result);
+            total_received += static_cast<std::size_t>(result.result);
+            error_counter = 0;
+            continue;
+          }
+          if(result.result == 0) return 0;
+          // All the buffers were used because the handler is slower than the stream
+          if(result.result == -ENOBUFS || result.result == -ECANCELED) continue;
+
+          errno = -result.result;
+          if(!retry(socket_fd_, POLLIN, &error_counter, nullptr)) return -1;
+        }
+      }
+    }
+
+#endif
+    int client::receive_reliable(const reliable_handler &handler, bool *breaker){
+      if(!connected_.load())
+        return 0;
+      if(is_tcp_){
+        errno = EOPNOTSUPP;
+        return -1;
+      }
+
+      bool never{false};
+      if(breaker == nullptr) breaker = &never;
+
+      std::lock_guard<std::mutex> guard(reliable_receive_mutex_);
+      while(!(*breaker) && connected_.load()){
+        // Acknowledgements of the last datagrams, expired retransmissions and new messages
+        flush_reliable();
+        const int delivered = reliable_.deliver(handler);
+        if(delivered > 0) return delivered;
+        if(reliable_.failed()){
+          errno = ETIMEDOUT;
+          return -1;
+        }
+
+        // Waiting until the next timer at most, the breaker is checked every 50 milliseconds
+        int timeout{reliable_.wait_time()};
+        if(timeout < 0 || timeout > 50) timeout = 50;
+        const int ready = wait_for_socket(socket_fd_, POLLIN, timeout);
+        if(ready < 0) return -1;
+        if(ready > 0 && !receive_reliable_datagrams()) return -1;
+      }
+
+      if(!connected_.load()) return 0;
+      errno = ECANCELED;
+      return -1;
+    }
+
+    ssize_t client::receive_timestamped(void *buffer, const std::size_t size,
+                                        packet_timestamp *timestamp, const int flags){
+      *timestamp = packet_timestamp{};
+      if(!connected_.load() || size == 0)
+        return 0;
+
+      const std::uint64_t start{metrics_.start()};
+      iovec part{buffer, size};
+      alignas(cmsghdr) std::uint8_t control[timestamp_control_size];
+      ssize_t received{0};
+      std::uint32_t error_counter{0};
+
+      while(true){
+        // The kernel overwrites the control length, so it is prepared every time
+        msghdr header{};
+        header.msg_iov = &part;
+        header.msg_iovlen = 1;
+        header.msg_control = control;
+        header.msg_controllen = sizeof(control);
+        received = ::recvmsg(socket_fd_, &header, flags);
+
+        if(received == 0) return 0;
+
+        if(received < 0){
+          // Waits until the socket is ready again, it fails after the max intents
+          if(!retry(socket_fd_, POLLIN, &error_counter, nullptr))
+            return received;
+          continue;
+        }
+        read_timestamp(header, timestamp);
+        return metrics_.received(received, start);
+      }
+    }
+
+    bool client::reconnect(const bool concurrent){
+      if(ip_.size() == 0 || port_ <= 0) return false;
+      if(connecting_.load()) return true;
+      if(connected_.load()) disconnect();
+
+      current_intent_ = 0;
+      connecting_.store(true);
+      terminate_concurrent_.store(false);
+
+      if(concurrent)
+        std::thread([this, options = io_thread("connect")]{
+          configure_current_thread(options);
+          concurrent_connector();
+        }).detach();
+      else
+        concurrent_connector();
+      return true;
+    }
+
+    reconnection_policy client::reconnection(){
+      return reconnection_;
+    }
+
+    bool client::reconnection(const reconnection_policy &new_policy){
+      if(!is_valid(new_policy)) return false;
+      reconnection_ = new_policy;
+      return true;
+    }
+
+    reliable_options client::reliable_udp(){
+      return reliable_.options();
+    }
+
+    bool client::reliable_udp(const reliable_options &new_options){
+      return reliable_.options(new_options);
+    }
+
+    reliable_statistics client::reliable_udp_statistics(){
+      return reliable_.statistics();
+    }
+
+    void client::reset_metrics(){
+      metrics_.reset();
+    }
+
+    ssize_t client::send(const void *buffer, const std::size_t size, const int flags){
+      if(!connected_.load() || size == 0)
+        return 0;
+
+      const std::uint64_t start{metrics_.start()};
+      std::uint32_t error_counter{0};
+      ssize_t sent{0};
+
+      while(true){
+        sent = ::send(socket_fd_, buffer, size, flags);
+
+        if(sent == 0) return 0;
+
+        if(sent < 0){
+          // Waits until the socket is ready again, it fails after the max intents
+          if(!retry(socket_fd_, POLLOUT, &error_counter, nullptr))
+            return sent;
+          continue;
+        }
+        return metrics_.sent(sent, start);
+      }
+    }
+
+    ssize_t client::send(const iovec *buffers, const std::size_t count, const int flags){
+      if(!connected_.load() || count == 0)
+        return 0;
+
+      const std::uint64_t start{metrics_.start()};
+      io_vectors parts(buffers, count);
+      if(parts.empty()) return 0;
+
+      std::uint32_t error_counter{0};
+      ssize_t sent{0};
+      msghdr header{};
+      header.msg_iov = parts.data();
+      header.msg_iovlen = parts.count();
+
+      while(true){
+        sent = ::sendmsg(socket_fd_, &header, flags);
+
+        if(sent == 0) return 0;
+
+        if(sent < 0){
+          // Waits until the socket is ready again, it fails after the max intents
+          if(!retry(socket_fd_, POLLOUT, &error_counter, nullptr))
+            return sent;
+          continue;
+        }
+        return metrics_.sent(sent, start);
+      }
+    }
+
+    ssize_t client::send_all(const void *buffer, const std::size_t size, bool *breaker,
+                             const int flags){
+      if(!connected_.load() || size == 0)
+        return 0;
+
+      const std::uint64_t start{metrics_.start()};
+      std::size_t total_sent{0};
+      std::size_t bytes_left = size;
+      ssize_t sent_size;
+      std::uint32_t error_counter{0};
+      bool never{false};
+      if(breaker == nullptr) breaker = &never;
+
+#ifdef RAMROD_NETWORK_IO_URING
+      if(is_tcp_ && io_uring_.load()){
+        std::lock_guard<std::mutex> lock(send_ring_mutex_);
+        return metrics_.sent(ring_send_all(send_ring_.get(), socket_fd_, buffer, size, breaker,
+                                           flags, io_timeout_, max_intents_, &metrics_),
+                             start);
+      }
+#endif
+      while(total_sent < size && !(*breaker)){
+        sent_size = ::send(socket_fd_, (const std::uint8_t*)buffer + total_sent,
+                           bytes_left, flags);
+        // The server has disconnected and therefore disconnecting client
+        if(sent_size == 0)
+          return 0;
+
+        if(sent_size < 0){
+          // Waits until the socket is ready again, it fails after the max intents
+          if(!retry(socket_fd_, POLLOUT, &error_counter, nullptr))
+            return sent_size;
+          continue;
+        }
+        total_sent += static_cast<std::size_t>(sent_size);
+        bytes_left -= static_cast<std::size_t>(sent_size);
+      }
+      return metrics_.sent(static_cast<ssize_t>(total_sent), start);
+    }
+
+    ssize_t client::send_all(const iovec *buffers, const std::size_t count, bool *breaker,
+                              const int flags){
+      if(!connected_.load() || count == 0)
+        return 0;
+
+      const std::uint64_t start{metrics_.start()};
+      io_vectors parts(buffers, count);
+      std::size_t total_sent{0};
+      ssize_t sent_size;
+      std::uint32_t error_counter{0};
+      msghdr header{};
+      bool never{false};
+      if(breaker == nullptr) breaker = &never;
+
+      while(!parts.empty() && !(*breaker)){
+        header.msg_iov = parts.data();
+        header.msg_iovlen = parts.count();
+        sent_size = ::sendmsg(socket_fd_, &header, flags);
+        if(sent_size == 0)
+          return 0;
 
-          // This will try to receive the same data than the last time
-          std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        if(sent_size < 0){
+          // Waits until the socket is ready again, it fails after the max intents
+          if(!retry(socket_fd_, POLLOUT, &error_counter, nullptr))
+            return sent_size;
           continue;
         }
-        total_received += static_cast<std::size_t>(received_size);
-        bytes_left -= static_cast<std::size_t>(received_size);
+        total_sent += static_cast<std::size_t>(sent_size);
+        parts.advance(static_cast<std::size_t>(sent_size));
       }
-      return static_cast<ssize_t>(total_received);
+      return metrics_.sent(static_cast<ssize_t>(total_sent), start);
     }
 
-    bool client::receive_all_concurrently(void *buffer, std::size_t *size, bool *breaker,
-                                          const int flags){
-      if(!connected_.load() || *size == 0){
-        *size = 0;
-        return false;
+    operation client::send_all_async(const void *buffer, const std::size_t size,
+                                     const operation::completion &on_complete, const int flags){
+      operation task(on_complete);
+      if(!connected_.load() || size == 0){
+        task.finish(0);
+        return task;
       }
 
-      std::thread(&client::concurrent_receive_all, this, buffer, size, breaker, flags).detach();
-      return true;
+      if(!send_worker_.post([this, buffer, size, flags, task]() mutable{
+           if(size >= zero_copy_minimum_size && zero_copy_sends_.active())
+             concurrent_send_zero_copy(buffer, size, task, flags);
+           else
+             task.finish(concurrent_send_all(buffer, size, nullptr, task.cancellation(), flags));
+         })){
+        errno = ECANCELED;
+        task.finish(-1);
+      }
+      return task;
     }
 
-    bool client::receive_concurrently(void *buffer, std::size_t *size, const int flags){
+    bool client::send_all_concurrently(const void *buffer, std::size_t *size, bool *breaker,
+                                       const int flags){
       if(!connected_.load() || *size == 0){
         *size = 0;
         return false;
       }
 
-      std::thread(&client::concurrent_receive, this, buffer, size, flags).detach();
+      if(!send_worker_.post([this, buffer, size, breaker, flags]{
+           const ssize_t sent = concurrent_send_all(buffer, *size, breaker, nullptr, flags);
+           *size = sent > 0 ? static_cast<std::size_t>(sent) : 0;
+         })){
+        *size = 0;
+        return false;
+      }
       return true;
     }
 
-    bool client::reconnect(const bool concurrent){
-      if(ip_.size() == 0 || port_ <= 0) return false;
-      if(connecting_.load()) return true;
-      if(connected_.load()) disconnect();
+    operation client::send_async(const void *buffer, const std::size_t size,
+                                 const operation::completion &on_complete, const int flags){
+      operation task(on_complete);
+      if(!connected_.load() || size == 0){
+        task.finish(0);
+        return task;
+      }
 
-      current_intent_ = 0;
-      connecting_.store(true);
-      terminate_concurrent_.store(false);
+      if(!send_worker_.post([this, buffer, size, flags, task]() mutable{
+           task.finish(concurrent_send(buffer, size, task.cancellation(), flags));
+         })){
+        errno = ECANCELED;
+        task.finish(-1);
+      }
+      return task;
+    }
 
-      if(concurrent)
-        std::thread(&client::concurrent_connector, this, false).detach();
-      else
-        concurrent_connector(true);
+    bool client::send_channel(const std::uint8_t channel, const void *buffer,
+                              const std::size_t size){
+      if(!connected_.load())
+        return false;
+
+      bool start;
+      if(!channels_.add(channel, buffer, size, &start))
+        return false;
+      if(start && !send_worker_.post([this]{ concurrent_send_channels(); })){
+        errno = ECANCELED;
+        return false;
+      }
+      metrics_.messages_sent();
       return true;
     }
 
-    ssize_t client::send(const void *buffer, const std::size_t size, const int flags){
-      if(!connected_.load() || size == 0)
+    bool client::send_concurrently(const void *buffer, std::size_t *size, const int flags){
+      if(!connected_.load() || *size == 0){
+        *size = 0;
+        return false;
+      }
+
+      if(!send_worker_.post([this, buffer, size, flags]{
+           const ssize_t sent = concurrent_send(buffer, *size, nullptr, flags);
+           *size = sent > 0 ? static_cast<std::size_t>(sent) : 0;
+         })){
+        *size = 0;
+        return false;
+      }
+      return true;
+    }
+
+    int client::send_datagrams(const datagram *datagrams, const std::size_t count,
+                               const int flags){
+      if(!connected_.load() || count == 0)
         return 0;
+      if(is_tcp_){
+        errno = EOPNOTSUPP;
+        return -1;
+      }
 
+      mmsghdr headers[max_datagram_batch];
+      iovec parts[max_datagram_batch];
+      std::size_t total_sent{0};
       std::uint32_t error_counter{0};
-      ssize_t sent{0};
-
-      while(true){
-        sent = ::send(socket_fd_, buffer, size, flags);
 
-        if(sent == 0) return 0;
+      while(total_sent < count){
+        const std::size_t left{count - total_sent};
+        const std::size_t batch{left < max_datagram_batch ? left : max_datagram_batch};
+        for(std::size_t i{0}; i < batch; ++i){
+          const datagram &current = datagrams[total_sent + i];
+          parts[i] = {current.buffer, current.size};
+          headers[i] = mmsghdr{};
+          headers[i].msg_hdr.msg_iov = &parts[i];
+          headers[i].msg_hdr.msg_iovlen = 1;
+        }
 
+        const int sent = ::sendmmsg(socket_fd_, headers, static_cast<unsigned int>(batch), flags);
         if(sent < 0){
-#ifdef VERBOSE
-          rr::perror("Sending data");
-#endif
-          if(++error_counter > max_intents_)
-            return sent;
-
-          // This will try to receive the same data than the last time
-          std::this_thread::sleep_for(std::chrono::milliseconds(10));
+          // Waits until the socket is ready again, it fails after the max intents
+          if(!retry(socket_fd_, POLLOUT, &error_counter, nullptr))
+            return total_sent > 0 ? static_cast<int>(total_sent) : -1;
           continue;
         }
-        return sent;
+        std::size_t bytes{0};
+        for(int i{0}; i < sent; ++i) bytes += headers[i].msg_len;
+        metrics_.sent(static_cast<ssize_t>(bytes));
+        metrics_.messages_sent(static_cast<std::uint64_t>(sent));
+        total_sent += static_cast<std::size_t>(sent);
       }
+      return static_cast<int>(total_sent);
     }
 
-    ssize_t client::send_all(const void *buffer, const std::size_t size, bool *breaker,
-                             const int flags){
-      if(!connected_.load() || size == 0)
+    ssize_t client::send_file(const int file_fd, const off_t offset, const std::size_t length,
+                              bool *breaker){
+      if(!connected_.load())
         return 0;
+      if(!is_tcp_){
+        errno = EOPNOTSUPP;
+        return -1;
+      }
 
-      std::size_t total_sent{0};
-      std::size_t bytes_left = size;
+      file_stream stream;
+      if(!stream.open(file_fd, offset, length)) return -1;
+
+      const std::uint64_t start{metrics_.start()};
       ssize_t sent_size;
       std::uint32_t error_counter{0};
       bool never{false};
       if(breaker == nullptr) breaker = &never;
 
-      while(total_sent < size && !(*breaker)){
-        sent_size = ::send(socket_fd_, (const std::uint8_t*)buffer + total_sent,
-                           bytes_left, flags);
-        // The server has disconnected and therefore disconnecting client
-        if(sent_size == 0)
-          return 0;
+      while(!stream.finished() && !(*breaker)){
+        sent_size = stream.send(socket_fd_);
+        // The file or pipe ended before sending `length` bytes
+        if(sent_size == 0) break;
 
         if(sent_size < 0){
-#ifdef VERBOSE
-          rr::perror("Sending data");
-#endif
-          // There is an error and returns after the max intents have been reached
-          if(++error_counter > max_intents_)
+          // Waits until the socket (or the empty pipe) is ready again, it fails after the
+          // max intents
+          short events;
+          const int waiting{stream.waiting_fd(socket_fd_, &events)};
+          if(!retry(waiting, events, &error_counter, nullptr))
             return sent_size;
-
-          // This will try to send the same data than the last time
-          std::this_thread::sleep_for(std::chrono::milliseconds(10));
           continue;
         }
-        total_sent += static_cast<std::size_t>(sent_size);
-        bytes_left -= static_cast<std::size_t>(sent_size);
       }
-      return static_cast<ssize_t>(total_sent);
+      return metrics_.sent(static_cast<ssize_t>(stream.sent()), start);
     }
 
-    bool client::send_all_concurrently(const void *buffer, std::size_t *size, bool *breaker,
-                                       const int flags){
-      if(!connected_.load() || *size == 0){
-        *size = 0;
+    operation client::send_file_async(const int file_fd, const off_t offset,
+                                      const std::size_t length,
+                                      const operation::completion &on_complete,
+                                      const file_progress &on_progress){
+      operation task(on_complete);
+      if(!connected_.load()){
+        task.finish(0);
+        return task;
+      }
+      if(!is_tcp_){
+        errno = EOPNOTSUPP;
+        task.finish(-1);
+        return task;
+      }
+
+      // Wrong descriptors and offsets are reported before posting the task
+      file_stream stream;
+      if(!stream.open(file_fd, offset, length)){
+        task.finish(-1);
+        return task;
+      }
+
+      if(!send_worker_.post([this, stream, task, on_progress]() mutable{
+           concurrent_send_file(&stream, task, on_progress);
+         })){
+        errno = ECANCELED;
+        task.finish(-1);
+      }
+      return task;
+    }
+
+    ssize_t client::send_message(const void *buffer, const std::uint32_t size, bool *breaker,
+                                 const int flags){
+      if(!connected_.load())
+        return 0;
+
+      std::uint8_t header[message_buffer::header_size];
+      message_buffer::write_header(header, size);
+      iovec parts[3]{{header, sizeof(header)}, {const_cast<void*>(buffer), size}, {}};
+      std::size_t count{2};
+
+      // The compressed message and its header replace the original one
+      std::unique_lock<std::mutex> guard(compression_mutex_, std::defer_lock);
+      if(negotiated_compression_ != compression_algorithm::none){
+        guard.lock();
+        if(!compression_context_.compress(buffer, size, compression_.threshold, parts + 1))
+          return -1;
+        message_buffer::write_header(header, static_cast<std::uint32_t>(parts[1].iov_len
+                                                                        + parts[2].iov_len));
+        count = 3;
+      }
+
+      const ssize_t sent = send_all(parts, count, breaker, flags);
+      if(sent <= 0) return sent;
+      metrics_.messages_sent();
+
+      const std::size_t total{sizeof(header) + parts[1].iov_len + parts[2].iov_len};
+      if(count == 3)
+        return static_cast<std::size_t>(sent) == total ? static_cast<ssize_t>(size) : 0;
+      return sent > static_cast<ssize_t>(sizeof(header))
+             ? sent - static_cast<ssize_t>(sizeof(header)) : 0;
+    }
+
+    bool client::send_message_queued(const void *buffer, const std::uint32_t size){
+      if(!connected_.load())
         return false;
+
+      std::uint8_t header[message_buffer::header_size + compression_header_size];
+      message_buffer::write_header(header, size);
+      std::size_t header_size{message_buffer::header_size};
+      iovec parts[2]{{}, {const_cast<void*>(buffer), size}};
+
+      // The compression's header is copied together with the message's one
+      std::unique_lock<std::mutex> guard(compression_mutex_, std::defer_lock);
+      if(negotiated_compression_ != compression_algorithm::none){
+        guard.lock();
+        if(!compression_context_.compress(buffer, size, compression_.threshold, parts))
+          return false;
+        std::memcpy(header + header_size, parts[0].iov_base, parts[0].iov_len);
+        header_size += parts[0].iov_len;
+        message_buffer::write_header(header, static_cast<std::uint32_t>(parts[0].iov_len
+                                                                        + parts[1].iov_len));
       }
 
-      std::thread(&client::concurrent_send_all, this, buffer, size, breaker, flags).detach();
+      bool start;
+      if(!send_queue_.add(header, header_size, parts[1].iov_base, parts[1].iov_len, &start))
+        return false;
+      if(start && !send_worker_.post([this]{ concurrent_send_queue(); })){
+        errno = ECANCELED;
+        return false;
+      }
+      metrics_.messages_sent();
       return true;
     }
 
-    bool client::send_concurrently(const void *buffer, std::size_t *size, const int flags){
-      if(!connected_.load() || *size == 0){
-        *size = 0;
+    bool client::send_queued(const void *buffer, const std::size_t size){
+      if(!connected_.load())
+        return false;
+
+      bool start;
+      if(!send_queue_.add(nullptr, 0, buffer, size, &start))
+        return false;
+      if(start && !send_worker_.post([this]{ concurrent_send_queue(); })){
+        errno = ECANCELED;
+        return false;
+      }
+      return true;
+    }
+
+    bool client::send_reliable(const void *buffer, const std::size_t size, const delivery mode){
+      if(!connected_.load())
+        return false;
+      if(is_tcp_){
+        errno = EOPNOTSUPP;
         return false;
       }
+      if(!reliable_.send(buffer, size, mode))
+        return false;
+
+      // Without a thread in receive_reliable() the acknowledgements are read here
+      std::unique_lock<std::mutex> receiving(reliable_receive_mutex_, std::try_to_lock);
+      if(receiving.owns_lock() && wait_for_socket(socket_fd_, POLLIN, 0) > 0
+         && !receive_reliable_datagrams())
+        return false;
 
-      std::thread(&client::concurrent_send, this, buffer, size, flags).detach();
+      flush_reliable();
       return true;
     }
 
     int client::time_to_reconnect(){
-      return static_cast<int>(reconnection_time_.count());
+      return reconnection_.initial_delay;
     }
 
     void client::time_to_reconnect(const int waiting_time_in_milliseconds){
-      if(waiting_time_in_milliseconds > 0)
-        reconnection_time_ = std::chrono::duration<long, std::milli>(
-              std::chrono::milliseconds(waiting_time_in_milliseconds)
-            );
+      if(waiting_time_in_milliseconds > 0){
+        reconnection_.initial_delay = waiting_time_in_milliseconds;
+        if(reconnection_.maximum_delay < waiting_time_in_milliseconds)
+          reconnection_.maximum_delay = waiting_time_in_milliseconds;
+      }
+    }
+
+    bool client::zero_copy(){
+      return zero_copy_.load();
+    }
+
+    bool client::zero_copy(const bool enable){
+      zero_copy_.store(enable);
+      // Changing the current connection, the next ones are changed when connected
+      if(!connected_.load() || !is_tcp_ || socket_fd_ < 0)
+        return true;
+
+      if(enable && !set_zero_copy(socket_fd_, true)){
+        zero_copy_sends_.set_active(false);
+        return false;
+      }
+      // The option stays in the socket, so the pending sends still get their notifications
+      zero_copy_sends_.set_active(enable);
+      return true;
     }
 
     // :::::::::::::::::::::::::::::::::::: PRIVATE FUNCTIONS ::::::::::::::::::::::::::::::::::::
@@ -314,78 +1396,51 @@ namespace ramrod {
       return true;
     }
 
-    void client::concurrent_connector(const bool wait){
+    void client::concurrent_connector(){
       if(connected_.load()) return;
 
       connecting_.store(true);
+      negotiated_compression_ = compression_algorithm::none;
+      const std::uint64_t start{metrics_.start()};
       int status;
-      struct addrinfo hints;
-      struct addrinfo *results; // Will point to the results
-      struct addrinfo *pointer;
-
-      std::memset(&hints, 0, sizeof(addrinfo));               // make sure the struct is empty
-      hints.ai_family   = AF_UNSPEC;                          // don't care if IPv4 or IPv6
-      hints.ai_socktype = is_tcp_ ? SOCK_STREAM : SOCK_DGRAM; // UDP or TCP socket
-      hints.ai_flags    = AI_PASSIVE;                         // Fill in my Ip information for me
-
-      // first, load up address structs with getaddrinfo():
-      if((status = ::getaddrinfo(ip_.c_str(), std::to_string(port_).c_str(),
-                                 &hints, &results)) != 0){
-        rr::formatted("Error: getaddrinfo (%s)\n", rr::message::error, ::gai_strerror(status));
-        return;
-      }
-
-      // loop through all the results and bind to the first we can
-      for(pointer = results; pointer != nullptr; pointer = pointer->ai_next){
-        // Making a socket
-        if((socket_fd_ = ::socket(pointer->ai_family, pointer->ai_socktype,
-                                  pointer->ai_protocol)) == -1){
-          rr::perror("Selecting socket");
-          continue;
-        }
 
-        if(::setsockopt(socket_fd_, SOL_SOCKET, SO_REUSEADDR, &status, sizeof(int)) == -1){
-          rr::perror("Setting socket options");
-          ::close(socket_fd_);
-          return;
-        }
-
-        // Connecting to the server
-        if(::connect(socket_fd_, pointer->ai_addr, pointer->ai_addrlen) == -1){
-          rr::perror("Connecting");
-          ::close(socket_fd_);
-          continue;
+      // Retrying in a loop until it connects, it is cancelled or the intents are exhausted
+      while(true){
+        // The addresses are resolved again only when they expire, see reconnection_policy
+        const addrinfo *results = addresses_.resolve(ip_, port_,
+                                                     is_tcp_ ? SOCK_STREAM : SOCK_DGRAM,
+                                                     AI_PASSIVE, reconnection_.address_ttl,
+                                                     &status);
+        if(results == nullptr){
+          rr::formatted("Error: getaddrinfo (%s)\n", rr::message::error, ::gai_strerror(status));
+        }else{
+          // Racing all the results, the first one that connects is used
+          socket_fd_ = race_connect(results, options_, attempt_delay_, connection_timeout_,
+                                    &terminate_concurrent_);
+          if(socket_fd_ >= 0 && negotiate()) break;
+          rr::perror("client failed to connect");
         }
-        break;
-      }
 
-      ::freeaddrinfo(results); // all done with this structure
-
-      if(pointer == nullptr){
-        rr::perror("client failed to bind");
+        metrics_.connection_failed();
         if(++current_intent_ > max_intents_){
+          metrics_.intents_exhausted();
           rr::error("Max number of reconnections has been reached "
                     "and therefore failed to connect.");
+          connecting_.store(false);
           return;
         }
-        rr::attention() << "Trying reconnection in " << reconnection_time_.count() / 1000
-                        << " seconds... (#" << current_intent_ << ")" << rr::endl;
-        std::this_thread::sleep_for(reconnection_time_);
+
+        const std::chrono::milliseconds delay{backoff_delay(reconnection_, current_intent_)};
+        rr::attention() << "Trying reconnection in " << delay.count() << " milliseconds... (#"
+                        << current_intent_ << ")" << rr::endl;
 
         // Terminates the pending connection in case disconnect() is called:
-        if(terminate_concurrent_.load()){
+        if(!wait_to_reconnect(delay, terminate_concurrent_)){
           connecting_.store(false);
           return;
         }
 
         rr::attention("Reconnecting!");
-
-        if(wait)
-          concurrent_connector(true);
-        else
-          std::thread(&client::concurrent_connector, this, false).detach();
-
-        return;
       }
 
       // TODO: is this necessary?
@@ -402,14 +1457,36 @@ namespace ramrod {
       // END TODO:
 
       if(!is_tcp_){
-        char outgoing[11] = "identifier";
-        if(::send(socket_fd_, outgoing, sizeof(outgoing), MSG_NOSIGNAL) < 0){
+        sockaddr_storage destination;
+        socklen_t destination_length{sizeof(destination)};
+        // A multicast group has no server waiting for the identifier
+        if(::getpeername(socket_fd_, reinterpret_cast<sockaddr*>(&destination),
+                         &destination_length) == 0 && is_multicast(destination)){
+          apply_multicast_options(socket_fd_, multicast_);
+        }else{
+          char outgoing[11] = "identifier";
+          if(::send(socket_fd_, outgoing, sizeof(outgoing), MSG_NOSIGNAL) < 0){
 #ifdef VERBOSE
-          rr::perror("Sending identifier");
+            rr::perror("Sending identifier");
 #endif
+          }
         }
       }
 
+      if(non_blocking_ && !set_non_blocking(socket_fd_, true))
+        rr::perror("Setting socket as non-blocking");
+
+      // Numbering of the zero-copy sends starts again with every socket
+      bool zero_copy_enabled{false};
+      if(is_tcp_ && zero_copy_.load()){
+        zero_copy_enabled = set_zero_copy(socket_fd_, true);
+        if(!zero_copy_enabled) rr::perror("Enabling zero-copy sending");
+      }
+      zero_copy_sends_.reset(zero_copy_enabled);
+      messages_.clear();
+      channel_messages_.clear();
+      reliable_.reset();
+      metrics_.connected(start);
       connected_.store(true);
       connecting_.store(false);
       terminate_send_.store(false);
@@ -420,136 +1497,316 @@ namespace ramrod {
 #endif
     }
 
-    void client::concurrent_receive(void *buffer, std::size_t *size, const int flags){
+    ssize_t client::concurrent_receive(void *buffer, const std::size_t size,
+                                       const std::atomic<bool> *cancel, const int flags){
+      const std::uint64_t start{metrics_.start()};
       ssize_t received{0};
       std::uint32_t error_counter{0};
 
       while(true){
-        received = ::recv(socket_fd_, buffer, *size, flags);
+        if(terminate_receive_.load() || (cancel && cancel->load())){
+          errno = ECANCELED;
+          return -1;
+        }
 
-        if(received == 0) break;
+        received = ::recv(socket_fd_, buffer, size, flags);
 
         if(received < 0){
-  #ifdef VERBOSE
-          rr::perror("Receiving data");
-  #endif
-          if(++error_counter > max_intents_){
-            *size = 0;
-            return;
-          }
-
-          // This will try to receive the same data than the last time
-          std::this_thread::sleep_for(std::chrono::milliseconds(10));
+          // Waits until the socket is ready again, it fails after the max intents
+          if(!retry(socket_fd_, POLLIN, &error_counter, cancel))
+            return received;
           continue;
         }
-        break;
+        return metrics_.received(received, start);
       }
-      *size = static_cast<std::size_t>(received);
-      return;
     }
 
-    void client::concurrent_receive_all(void *buffer, std::size_t *size, bool *breaker,
-                                        const int flags){
+    ssize_t client::concurrent_receive_all(void *buffer, const std::size_t size, bool *breaker,
+                                           const std::atomic<bool> *cancel, const int flags){
+      const std::uint64_t start{metrics_.start()};
       std::size_t total_received{0};
-      std::size_t bytes_left = *size;
+      std::size_t bytes_left = size;
       ssize_t received_size;
       std::uint32_t error_counter{0};
       bool never{false};
       if(breaker == nullptr) breaker = &never;
 
-      while(total_received < *size && !terminate_receive_.load() && !(*breaker)){
+      while(total_received < size && !terminate_receive_.load() && !(*breaker)
+            && !(cancel && cancel->load())){
         received_size = ::recv(socket_fd_, (std::uint8_t*)buffer + total_received,
                                bytes_left, flags);
         // The server has disconnected and therefore disconnecting client
-        if(received_size == 0){
-          *size = 0;
-          return;
-        }
+        if(received_size == 0)
+          return 0;
 
         if(received_size < 0){
-#ifdef VERBOSE
-          rr::perror("Receiving data");
-#endif
-          // There is an error and returns after the max intents have been reached
-          if(++error_counter > max_intents_){
-            *size = 0;
-            return;
-          }
-
-          // This will try to receive the same data than the last time
-          std::this_thread::sleep_for(std::chrono::milliseconds(10));
+          // Waits until the socket is ready again, it fails after the max intents
+          if(!retry(socket_fd_, POLLIN, &error_counter, cancel))
+            return received_size;
           continue;
         }
         total_received += static_cast<std::size_t>(received_size);
         bytes_left -= static_cast<std::size_t>(received_size);
       }
-      *size = total_received;
+
+      if(total_received == 0 && size > 0){
+        errno = ECANCELED;
+        return -1;
+      }
+      return metrics_.received(static_cast<ssize_t>(total_received), start);
+    }
+
+    void client::concurrent_receive_leased(buffer_pool *pool, const std::size_t size,
+                                           const bool all, operation task,
+                                           const lease_completion &on_complete, const int flags){
+      buffer_lease buffer = pool->acquire();
+      ssize_t result{-1};
+      if(!buffer.is_valid())
+        errno = ENOMEM;
+      else if(all)
+        result = concurrent_receive_all(buffer.data(), size, nullptr, task.cancellation(), flags);
+      else
+        result = concurrent_receive(buffer.data(), size, task.cancellation(), flags);
+      buffer.size(result > 0 ? static_cast<std::size_t>(result) : 0);
+
+      // The completion could change errno, which is saved when the operation finishes
+      const int error{errno};
+      if(on_complete) on_complete(std::move(buffer), result);
+      errno = error;
+      task.finish(result);
     }
 
-    void client::concurrent_send(const void *buffer, std::size_t *size, const int flags){
+    ssize_t client::concurrent_send(const void *buffer, const std::size_t size,
+                                    const std::atomic<bool> *cancel, const int flags){
+      const std::uint64_t start{metrics_.start()};
       std::uint32_t error_counter{0};
       ssize_t sent{0};
 
       while(true){
-        sent = ::send(socket_fd_, buffer, *size, flags);
+        if(terminate_send_.load() || (cancel && cancel->load())){
+          errno = ECANCELED;
+          return -1;
+        }
 
-        if(sent == 0) break;
+        sent = ::send(socket_fd_, buffer, size, flags);
 
         if(sent < 0){
-#ifdef VERBOSE
-          rr::perror("Sending data");
-#endif
-          if(++error_counter > max_intents_){
-            *size = 0;
-            return;
-          }
-
-          // This will try to receive the same data than the last time
-          std::this_thread::sleep_for(std::chrono::milliseconds(10));
+          // Waits until the socket is ready again, it fails after the max intents
+          if(!retry(socket_fd_, POLLOUT, &error_counter, cancel))
+            return sent;
           continue;
         }
-        break;
+        return metrics_.sent(sent, start);
       }
-      *size = static_cast<std::size_t>(sent);
-      return;
-
     }
 
-    void client::concurrent_send_all(const void *buffer, std::size_t *size, bool *breaker,
-                                     const int flags){
+    ssize_t client::concurrent_send_all(const void *buffer, const std::size_t size, bool *breaker,
+                                        const std::atomic<bool> *cancel, const int flags,
+                                        std::uint32_t *sends){
+      const std::uint64_t start{metrics_.start()};
       std::size_t total_sent{0};
-      std::size_t bytes_left = *size;
+      std::size_t bytes_left = size;
       ssize_t sent_size;
       std::uint32_t error_counter{0};
       bool never{false};
       if(breaker == nullptr) breaker = &never;
 
-      while(total_sent < *size && !terminate_send_.load() && !(*breaker)){
+      while(total_sent < size && !terminate_send_.load() && !(*breaker)
+            && !(cancel && cancel->load())){
         sent_size = ::send(socket_fd_, (const std::uint8_t*)buffer + total_sent,
                            bytes_left, flags);
-        if(sent_size == 0){
-          *size = 0;
-          return;
-        }
+        if(sent_size == 0)
+          return 0;
 
         if(sent_size < 0){
+          // Waits until the socket is ready again, it fails after the max intents
+          if(!retry(socket_fd_, POLLOUT, &error_counter, cancel))
+            return sent_size;
+          continue;
+        }
+        if(sends) ++(*sends);
+        total_sent += static_cast<std::size_t>(sent_size);
+        bytes_left -= static_cast<std::size_t>(sent_size);
+      }
+
+      if(total_sent == 0 && size > 0){
+        errno = ECANCELED;
+        return -1;
+      }
+      return metrics_.sent(static_cast<ssize_t>(total_sent), start);
+    }
+
+    void client::concurrent_send_channels(){
+      iovec parts[channel_scheduler::max_parts];
+      std::size_t count;
+      // One chunk at a time, so a more urgent message queued meanwhile is the next one
+      while((count = channels_.next(parts)) > 0){
+        const bool failed{send_all(parts, count, nullptr, MSG_NOSIGNAL) < 0};
 #ifdef VERBOSE
-          rr::perror("Sending data");
+        if(failed) rr::perror("Sending channel messages");
 #endif
-          // There is an error and returns after the max intents have been reached
-          if(++error_counter > max_intents_){
-            *size = 0;
+        channels_.sent(failed);
+      }
+    }
+
+    void client::concurrent_send_file(file_stream *stream, operation task,
+                                      const file_progress &on_progress){
+      const std::uint64_t start{metrics_.start()};
+      const std::atomic<bool> *cancel{task.cancellation()};
+      ssize_t sent_size;
+      std::uint32_t error_counter{0};
+
+      while(!stream->finished() && !terminate_send_.load() && !cancel->load()){
+        sent_size = stream->send(socket_fd_);
+        // The file or pipe ended before sending `length` bytes
+        if(sent_size == 0) break;
+
+        if(sent_size < 0){
+          // Waits until the socket (or the empty pipe) is ready again, it fails after the
+          // max intents
+          short events;
+          const int waiting{stream->waiting_fd(socket_fd_, &events)};
+          if(!retry(waiting, events, &error_counter, cancel)){
+            task.finish(-1);
             return;
           }
+          continue;
+        }
+        task.progress(stream->sent());
+        if(on_progress) on_progress(stream->sent(), stream->total());
+      }
+
+      if(stream->sent() == 0 && !stream->finished()){
+        errno = ECANCELED;
+        task.finish(-1);
+        return;
+      }
+      task.finish(metrics_.sent(static_cast<ssize_t>(stream->sent()), start));
+    }
+
+    void client::concurrent_send_queue(){
+      iovec parts[send_queue::max_batch];
+      do{
+        std::size_t count;
+        while((count = send_queue_.take(parts)) > 0){
+          // Every message taken is written by the same writev(), a failure discards them
+          if(send_all(parts, count, nullptr, MSG_NOSIGNAL) < 0){
+#ifdef VERBOSE
+            rr::perror("Sending queued messages");
+#endif
+          }
+          send_queue_.release();
+        }
+      }while(send_queue_.keep_writing());
+    }
+
+    void client::concurrent_send_zero_copy(const void *buffer, const std::size_t size,
+                                           operation task, const int flags){
+      std::uint32_t sends{0};
+      const ssize_t result = concurrent_send_all(buffer, size, nullptr, task.cancellation(),
+                                                 flags | MSG_ZEROCOPY, &sends);
+
+      // The buffer is released by the reaper after the kernel reports all the sends
+      if(zero_copy_sends_.add(task, result, result < 0 ? errno : 0, sends)
+         && !zero_copy_worker_.post([this]{ concurrent_zero_copy_reaper(); }))
+        zero_copy_sends_.release();
+    }
 
-          // This will try to receive the same data than the last time
-          std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    void client::concurrent_zero_copy_reaper(){
+      while(zero_copy_sends_.keep_reaping()){
+        if(terminate_send_.load()){
+          zero_copy_sends_.release();
           continue;
         }
-        total_sent += static_cast<std::size_t>(sent_size);
-        bytes_left -= static_cast<std::size_t>(sent_size);
+
+        // The notifications are reported as an error condition, no event is needed
+        const int ready = wait_for_socket(socket_fd_, 0, 50);
+        if(ready == 0) continue;
+
+        // The socket is broken, the pending operations are cancelled
+        const int reaped = ready < 0 ? -1 : zero_copy_sends_.reap(socket_fd_);
+        if(reaped < 0){
+#ifdef VERBOSE
+          rr::perror("Reading zero-copy notifications");
+#endif
+          zero_copy_sends_.release();
+        }else if(reaped == 0){
+          // A hung up socket is always ready, waiting a slice avoids spinning on it
+          std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        }
+      }
+    }
+
+    void client::flush_reliable(){
+      std::lock_guard<std::mutex> guard(reliable_send_mutex_);
+      send_reliable_batches(&reliable_, &reliable_outgoing_,
+                            [this](datagram *datagrams, const std::size_t count){
+                              return send_datagrams(datagrams, count, MSG_NOSIGNAL);
+                            });
+    }
+
+    thread_options client::io_thread(const char *role){
+      std::lock_guard<std::mutex> guard(io_threads_mutex_);
+      return thread_role(io_threads_, role);
+    }
+
+    bool client::negotiate(){
+      if(!is_tcp_ || compression_.algorithm == compression_algorithm::none) return true;
+
+      compression_algorithm agreed;
+      // Both devices must agree on the compression before the first message
+      if(!negotiate_compression(socket_fd_, compression_, true, io_timeout_, &agreed)
+         || !compression_context_.algorithm(agreed, compression_.level)){
+        ::close(socket_fd_);
+        socket_fd_ = -1;
+        return false;
       }
-      *size = total_sent;
+      negotiated_compression_ = agreed;
+      return true;
+    }
+
+    int client::next_message(const std::uint8_t **message, std::uint32_t *size, bool *breaker,
+                                 const int flags){
+      bool never{false};
+      if(breaker == nullptr) breaker = &never;
+
+      while(!(*breaker)){
+        const int status = messages_.next(message, size);
+        if(status > 0) return status;
+        if(status < 0){
+#ifdef VERBOSE
+          rr::error("Received message is bigger than the maximum message size");
+#endif
+          errno = EMSGSIZE;
+          return -1;
+        }
+
+        // Receives everything that is available, not only the missing part of the message
+        const std::size_t free_space = messages_.reserve();
+        // Every message completed by this reception gets its timestamp
+        const ssize_t received = options_.receive_timestamps || options_.hardware_timestamps
+                                 ? receive_timestamped(messages_.tail(), free_space,
+                                                       &message_timestamp_, flags)
+                                 : receive(messages_.tail(), free_space, flags);
+        if(received <= 0) return static_cast<int>(received);
+        messages_.commit(static_cast<std::size_t>(received));
+      }
+
+      errno = ECANCELED;
+      return -1;
+    }
+
+    bool client::receive_reliable_datagrams(){
+      return receive_reliable_batch(&reliable_, &reliable_incoming_,
+                                    [this](datagram *datagrams, const std::size_t count){
+                                      return receive_datagrams(datagrams, count);
+                                    });
+    }
+
+    bool client::retry(const int fd, const short events, std::uint32_t *error_counter,
+                     const std::atomic<bool> *cancel){
+      return retry_transfer(fd, events, io_timeout_, max_intents_, error_counter, cancel,
+                            &metrics_);
     }
 
     // :::::::::::::::::::::::::::::::::::: OUTTER FUNCTIONS :::::::::::::::::::::::::::::::::::
@@ -0,0 +1,296 @@
+#include "ramrod/network_communication/compression.h"
+
+#include <cerrno>                      // for errno, EAGAIN, EINTR, EMSGSIZE, EPR...
+#include <cstdint>                     // for UINT32_MAX
+#include <cstring>                     // for memcmp, memcpy
+#include <poll.h>                      // for POLLIN, POLLOUT
+#include <sys/socket.h>                // for recv, send, MSG_NOSIGNAL
+#ifdef RAMROD_NETWORK_LZ4
+#include <lz4.h>                       // for LZ4_compress_fast_extState, LZ4_decomp...
+#endif
+#ifdef RAMROD_NETWORK_ZSTD
+#include <zstd.h>                      // for ZSTD_compress2, ZSTD_decompressDCtx
+#endif
+
+#include "ramrod/network_communication/socket_wait.h"
+
+namespace ramrod {
+  namespace network_communication {
+    namespace {
+      // Magic bytes of the negotiation, then the role, the preferred and the available
+      constexpr std::uint8_t hello_magic[4]{'R', 'R', 'C', 'Z'};
+      constexpr std::size_t hello_size{7};
+
+      std::uint8_t bit(const compression_algorithm algorithm){
+        return static_cast<std::uint8_t>(1u << static_cast<std::uint8_t>(algorithm));
+      }
+
+      bool exchange(const int fd, const short events, std::uint8_t *buffer,
+                    const std::size_t size, const int timeout){
+        std::size_t done{0};
+        while(done < size){
+          const ssize_t result = events == POLLOUT
+                                 ? ::send(fd, buffer + done, size - done, MSG_NOSIGNAL)
+                                 : ::recv(fd, buffer + done, size - done, 0);
+          if(result > 0){
+            done += static_cast<std::size_t>(result);
+            continue;
+          }
+          if(result == 0){
+            // The other device closed the connection without negotiating
+            errno = EPROTO;
+            return false;
+          }
+          if(errno == EINTR) continue;
+          if(errno != EAGAIN && errno != EWOULDBLOCK) return false;
+
+          const int ready = wait_for_socket(fd, events, timeout);
+          if(ready < 0) return false;
+          if(ready == 0){
+            errno = ETIMEDOUT;
+            return false;
+          }
+        }
+        return true;
+      }
+    } // namespace: anonymous
+
+    compression_context::compression_context() :
+      algorithm_{compression_algorithm::none},
+      level_{0},
+      header_(),
+#ifdef RAMROD_NETWORK_LZ4
+      lz4_state_(),
+#endif
+#ifdef RAMROD_NETWORK_ZSTD
+      zstd_compression_{nullptr},
+      zstd_decompression_{nullptr},
+#endif
+      compressed_(),
+      decompressed_()
+    {}
+
+    compression_context::~compression_context(){
+#ifdef RAMROD_NETWORK_ZSTD
+      ::ZSTD_freeCCtx(zstd_compression_);
+      ::ZSTD_freeDCtx(zstd_decompression_);
+#endif
+    }
+
+    compression_algorithm compression_context::algorithm() const{
+      return algorithm_;
+    }
+
+    bool compression_context::algorithm(const compression_algorithm new_algorithm,
+                                        const int level){
+      if(!available(new_algorithm)){
+        errno = EPROTONOSUPPORT;
+        return false;
+      }
+
+#ifdef RAMROD_NETWORK_LZ4
+      if(new_algorithm == compression_algorithm::lz4 && lz4_state_.empty())
+        lz4_state_.resize(static_cast<std::size_t>(::LZ4_sizeofState()));
+#endif
+#ifdef RAMROD_NETWORK_ZSTD
+      if(new_algorithm == compression_algorithm::zstd){
+        if(zstd_compression_ == nullptr) zstd_compression_ = ::ZSTD_createCCtx();
+        if(zstd_compression_ == nullptr){
+          errno = ENOMEM;
+          return false;
+        }
+        ::ZSTD_CCtx_setParameter(zstd_compression_, ZSTD_c_compressionLevel, level);
+      }
+#endif
+      algorithm_ = new_algorithm;
+      level_ = level;
+      return true;
+    }
+
+    bool compression_context::compress(const void *data, const std::size_t size,
+                                       const std::size_t threshold, iovec *parts){
+      // Uncompressed messages only have the algorithm, the data is not copied
+      header_[0] = static_cast<std::uint8_t>(compression_algorithm::none);
+      parts[0] = iovec{header_, 1};
+      parts[1] = iovec{const_cast<void*>(data), size};
+      if(algorithm_ == compression_algorithm::none || size < threshold || size > UINT32_MAX)
+        return true;
+
+      std::size_t compressed_size{0};
+#ifdef RAMROD_NETWORK_LZ4
+      if(algorithm_ == compression_algorithm::lz4){
+        if(size > LZ4_MAX_INPUT_SIZE) return true;
+        const int bound{::LZ4_compressBound(static_cast<int>(size))};
+        compressed_.resize(static_cast<std::size_t>(bound));
+        const int result = ::LZ4_compress_fast_extState(lz4_state_.data(),
+                                                        static_cast<const char*>(data),
+                                                        reinterpret_cast<char*>(
+                                                          compressed_.data()),
+                                                        static_cast<int>(size), bound,
+                                                        level_ > 0 ? level_ : 1);
+        if(result <= 0){
+          errno = EINVAL;
+          return false;
+        }
+        compressed_size = static_cast<std::size_t>(result);
+      }
+#endif
+#ifdef RAMROD_NETWORK_ZSTD
+      if(algorithm_ == compression_algorithm::zstd){
+        compressed_.resize(::ZSTD_compressBound(size));
+        const std::size_t result = ::ZSTD_compress2(zstd_compression_, compressed_.data(),
+                                                    compressed_.size(), data, size);
+        if(::ZSTD_isError(result)){
+          errno = EINVAL;
+          return false;
+        }
+        compressed_size = result;
+      }
+#endif
+      // Incompressible data is sent as it is, the receiver then does not decompress it
+      if(compressed_size == 0 || compressed_size + compression_header_size >= size + 1)
+        return true;
+
+      const std::uint32_t original{static_cast<std::uint32_t>(size)};
+      header_[0] = static_cast<std::uint8_t>(algorithm_);
+      header_[1] = static_cast<std::uint8_t>(original >> 24);
+      header_[2] = static_cast<std::uint8_t>(original >> 16);
+      header_[3] = static_cast<std::uint8_t>(original >> 8);
+      header_[4] = static_cast<std::uint8_t>(original);
+      parts[0] = iovec{header_, compression_header_size};
+      parts[1] = iovec{compressed_.data(), compressed_size};
+      return true;
+    }
+
+    bool compression_context::decompress(const std::uint8_t *message, const std::uint32_t size,
+                                         const std::size_t max_size, const std::uint8_t **data,
+                                         std::size_t *data_size){
+      if(size < 1){
+        errno = EPROTO;
+        return false;
+      }
+
+      const compression_algorithm used{static_cast<compression_algorithm>(message[0])};
+      if(used == compression_algorithm::none){
+        *data = message + 1;
+        *data_size = size - 1;
+        return true;
+      }
+      if(size < compression_header_size){
+        errno = EPROTO;
+        return false;
+      }
+
+      const std::size_t original{static_cast<std::size_t>(message[1]) << 24
+                                 | static_cast<std::size_t>(message[2]) << 16
+                                 | static_cast<std::size_t>(message[3]) << 8
+                                 | static_cast<std::size_t>(message[4])};
+      if(original > max_size){
+        errno = EMSGSIZE;
+        return false;
+      }
+      if(decompressed_.size() < original) decompressed_.resize(original);
+
+      // The compressed data follows the header
+      const std::size_t source_size{size - compression_header_size};
+      bool valid{false};
+      switch(used){
+#ifdef RAMROD_NETWORK_LZ4
+        case compression_algorithm::lz4:{
+          char *destination{reinterpret_cast<char*>(decompressed_.data())};
+          const int result = ::LZ4_decompress_safe(reinterpret_cast<const char*>(
+                                                     message + compression_header_size),
+                                                   destination, static_cast<int>(source_size),
+                                                   static_cast<int>(original));
+          valid = result >= 0 && static_cast<std::size_t>(result) == original;
+          break;
+        }
+#endif
+#ifdef RAMROD_NETWORK_ZSTD
+        case compression_algorithm::zstd:{
+          if(zstd_decompression_ == nullptr) zstd_decompression_ = ::ZSTD_createDCtx();
+          if(zstd_decompression_ == nullptr){
+            errno = ENOMEM;
+            return false;
+          }
+          const std::size_t result = ::ZSTD_decompressDCtx(zstd_decompression_,
+                                                           decompressed_.data(), original,
+                                                           message + compression_header_size,
+                                                           source_size);
+          valid = !::ZSTD_isError(result) && result == original;
+          break;
+        }
+#endif
+        default:
+          // Either unknown or not compiled in this device
+          errno = used > compression_algorithm::zstd ? EPROTO : EPROTONOSUPPORT;
+          static_cast<void>(source_size);
+          return false;
+      }
+
+      if(!valid){
+        errno = EPROTO;
+        return false;
+      }
+      *data = decompressed_.data();
+      *data_size = original;
+      return true;
+    }
+
+    bool compression_context::available(const compression_algorithm algorithm){
+      switch(algorithm){
+        case compression_algorithm::none:
+          return true;
+#ifdef RAMROD_NETWORK_LZ4
+        case compression_algorithm::lz4:
+          return true;
+#endif
+#ifdef RAMROD_NETWORK_ZSTD
+        case compression_algorithm::zstd:
+          return true;
+#endif
+        default:
+          return false;
+      }
+    }
+
+    bool negotiate_compression(const int fd, const compression_options &options,
+                               const bool is_client, const int timeout,
+                               compression_algorithm *agreed){
+      *agreed = compression_algorithm::none;
+
+      std::uint8_t available_mask{0};
+      for(const compression_algorithm algorithm : {compression_algorithm::lz4,
+                                                   compression_algorithm::zstd})
+        if(compression_context::available(algorithm)) available_mask |= bit(algorithm);
+
+      std::uint8_t hello[hello_size];
+      std::memcpy(hello, hello_magic, sizeof(hello_magic));
+      hello[4] = is_client ? 1 : 0;
+      hello[5] = static_cast<std::uint8_t>(options.algorithm);
+      hello[6] = available_mask;
+      if(!exchange(fd, POLLOUT, hello, sizeof(hello), timeout)) return false;
+
+      std::uint8_t answer[hello_size];
+      if(!exchange(fd, POLLIN, answer, sizeof(answer), timeout)) return false;
+      // Both devices must have a different role
+      if(std::memcmp(answer, hello_magic, sizeof(hello_magic)) != 0
+         || answer[4] == hello[4]){
+        errno = EPROTO;
+        return false;
+      }
+
+      // Both choose the same algorithm without a third message
+      const std::uint8_t *client_hello = is_client ? hello : answer;
+      const std::uint8_t *server_hello = is_client ? answer : hello;
+      const std::uint8_t shared{static_cast<std::uint8_t>(hello[6] & answer[6])};
+      for(const std::uint8_t preferred : {client_hello[5], server_hello[5]}){
+        if(preferred != 0 && preferred < 8 && (shared & (1u << preferred))){
+          *agreed = static_cast<compression_algorithm>(preferred);
+          break;
+        }
+      }
+      return true;
+    }
+  } // namespace: network_communication
+} // namespace: ramrod
@@ -0,0 +1,162 @@
+#include "ramrod/network_communication/connect_race.h"
+
+#include <algorithm>                   // for min
+#include <cerrno>                      // for errno, ECANCELED, EINPROGRESS, ETIMEDOUT
+#include <chrono>                      // for steady_clock, milliseconds
+#include <cstddef>                     // for size_t
+#include <poll.h>                      // for poll, pollfd, POLLOUT
+#include <sys/socket.h>                // for connect, getsockopt, socket, SO_ERROR
+#include <unistd.h>                    // for close
+#include <vector>                      // for vector
+
+#include "ramrod/network_communication/socket_wait.h"
+
+namespace ramrod {
+  namespace network_communication {
+    namespace {
+      using clock = std::chrono::steady_clock;
+
+      int remaining(const clock::time_point &until, const clock::time_point &now){
+        const auto left = std::chrono::duration_cast<std::chrono::milliseconds>(until - now);
+        return left.count() > 0 ? static_cast<int>(left.count()) : 0;
+      }
+
+      std::vector<const addrinfo*> interleave(const addrinfo *candidates){
+        std::vector<const addrinfo*> first, second;
+        const int family{candidates != nullptr ? candidates->ai_family : AF_UNSPEC};
+
+        for(const addrinfo *pointer = candidates; pointer != nullptr; pointer = pointer->ai_next)
+          (pointer->ai_family == family ? first : second).push_back(pointer);
+
+        std::vector<const addrinfo*> ordered;
+        ordered.reserve(first.size() + second.size());
+        for(std::size_t i{0}; i < first.size() || i < second.size(); ++i){
+          if(i < first.size()) ordered.push_back(first[i]);
+          if(i < second.size()) ordered.push_back(second[i]);
+        }
+        return ordered;
+      }
+
+      void close_all(std::vector<pollfd> &pending){
+        for(const pollfd &current : pending) ::close(current.fd);
+        pending.clear();
+      }
+    } // namespace: anonymous
+
+    int race_connect(const addrinfo *candidates, const socket_options &options,
+                     const int attempt_delay, const int timeout,
+                     const std::atomic<bool> *cancel){
+      // Only a race with cancellation flag needs to wake up periodically
+      constexpr int slice{50};
+      const std::vector<const addrinfo*> ordered{interleave(candidates)};
+      const clock::time_point deadline{clock::now() + std::chrono::milliseconds(timeout)};
+      clock::time_point next_attempt{clock::now()};
+      std::vector<pollfd> pending;
+      std::size_t next{0};
+      int last_error{ECONNREFUSED};
+      int winner{-1};
+
+      while(winner < 0){
+        if(cancel && cancel->load()){
+          close_all(pending);
+          errno = ECANCELED;
+          return -1;
+        }
+
+        clock::time_point now{clock::now()};
+        if(timeout >= 0 && now >= deadline){
+          close_all(pending);
+          errno = ETIMEDOUT;
+          return -1;
+        }
+
+        // Starting the next attempt, without waiting if there is none running
+        if(next < ordered.size() && (now >= next_attempt || pending.empty())){
+          const addrinfo *address{ordered[next++]};
+          const int fd = ::socket(address->ai_family, address->ai_socktype, address->ai_protocol);
+          if(fd == -1){
+            last_error = errno;
+            continue;
+          }
+
+          // Some options only work before connecting, the failed ones are not fatal
+          apply_socket_options(fd, options);
+
+          if(!set_non_blocking(fd, true)){
+            last_error = errno;
+            ::close(fd);
+            continue;
+          }
+
+          if(::connect(fd, address->ai_addr, address->ai_addrlen) == 0){
+            winner = fd;
+            break;
+          }
+          if(errno != EINPROGRESS){
+            last_error = errno;
+            ::close(fd);
+            continue;
+          }
+          pending.push_back(pollfd{fd, POLLOUT, 0});
+          next_attempt = now + std::chrono::milliseconds(attempt_delay);
+          continue;
+        }
+
+        if(pending.empty()){
+          errno = last_error;
+          return -1;
+        }
+
+        int waiting{-1};
+        if(next < ordered.size()) waiting = remaining(next_attempt, now);
+        if(timeout >= 0){
+          const int left{remaining(deadline, now)};
+          waiting = waiting < 0 ? left : std::min(waiting, left);
+        }
+        if(cancel && (waiting < 0 || waiting > slice)) waiting = slice;
+
+        const int ready = ::poll(pending.data(), pending.size(), waiting);
+        if(ready < 0){
+          if(errno == EINTR) continue;
+          last_error = errno;
+          close_all(pending);
+          errno = last_error;
+          return -1;
+        }
+        if(ready == 0) continue;
+
+        for(std::size_t i{0}; i < pending.size();){
+          if(pending[i].revents == 0){
+            ++i;
+            continue;
+          }
+
+          int error{0};
+          socklen_t length{sizeof(error)};
+          if(::getsockopt(pending[i].fd, SOL_SOCKET, SO_ERROR, &error, &length) == -1)
+            error = errno;
+
+          if(error == 0 && winner < 0){
+            winner = pending[i].fd;
+          }else{
+            if(error != 0) last_error = error;
+            ::close(pending[i].fd);
+            // A failed attempt lets the next one start immediately
+            if(error != 0) next_attempt = clock::now();
+          }
+          pending.erase(pending.begin() + static_cast<long>(i));
+        }
+      }
+
+      close_all(pending);
+
+      if(!set_non_blocking(winner, false)){
+        last_error = errno;
+        ::close(winner);
+        errno = last_error;
+        return -1;
+      }
+      return winner;
+    }
+  } // namespace: network_communication
+} // namespace: ramrod
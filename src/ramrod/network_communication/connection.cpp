@@ -0,0 +1,368 @@
+#include "ramrod/network_communication/connection.h"
+
+#include <cerrno>                      // for errno, EBADF, ECANCELED, EHOS...
+#include <cstring>                     // for memcpy
+#include <netdb.h>                     // for addrinfo
+#include <poll.h>                      // for POLLIN, POLLOUT
+#include <unistd.h>                    // for close
+#include <utility>                     // for move
+
+#include "ramrod/console/perror.h"     // for perror
+#include "ramrod/network_communication/address_cache.h"
+#include "ramrod/network_communication/connect_race.h"
+#include "ramrod/network_communication/io_vectors.h"
+#include "ramrod/network_communication/socket_wait.h"
+
+namespace ramrod {
+  namespace network_communication {
+    connection::connection() :
+      fd_{-1},
+      peer_(),
+      peer_length_{0},
+      io_timeout_{1000},
+      max_intents_{10},
+      messages_()
+    {}
+
+    connection::connection(const int fd, const sockaddr *peer, const socklen_t peer_length,
+                           const std::size_t max_message_size) :
+      fd_{fd},
+      peer_(),
+      peer_length_{0},
+      io_timeout_{1000},
+      max_intents_{10},
+      messages_(max_message_size)
+    {
+      if(peer != nullptr && peer_length > 0 && peer_length <= sizeof(peer_)){
+        std::memcpy(&peer_, peer, peer_length);
+        peer_length_ = peer_length;
+      }
+    }
+
+    connection::~connection(){
+      close();
+    }
+
+    connection::connection(connection &&other) noexcept :
+      fd_{other.fd_},
+      peer_(other.peer_),
+      peer_length_{other.peer_length_},
+      io_timeout_{other.io_timeout_},
+      max_intents_{other.max_intents_},
+      messages_(std::move(other.messages_))
+    {
+      other.fd_ = -1;
+      other.peer_length_ = 0;
+      // The moved vector is empty but its positions were copied
+      other.messages_.clear();
+    }
+
+    connection &connection::operator=(connection &&other) noexcept{
+      if(this == &other) return *this;
+
+      close();
+      fd_ = other.fd_;
+      peer_ = other.peer_;
+      peer_length_ = other.peer_length_;
+      io_timeout_ = other.io_timeout_;
+      max_intents_ = other.max_intents_;
+      messages_ = std::move(other.messages_);
+
+      other.fd_ = -1;
+      other.peer_length_ = 0;
+      other.messages_.clear();
+      return *this;
+    }
+
+    bool connection::close(){
+      if(fd_ < 0){
+        errno = EBADF;
+        return false;
+      }
+
+      const int fd{fd_};
+      fd_ = -1;
+      peer_length_ = 0;
+      messages_.clear();
+      return ::close(fd) == 0;
+    }
+
+    connection connection::connect(const std::string &ip, const int port,
+                                   const socket_options &options, const int timeout){
+      address_cache addresses;
+      int status;
+      const addrinfo *results = addresses.resolve(ip, port, SOCK_STREAM, 0, 0, &status);
+      if(results == nullptr){
+        errno = EHOSTUNREACH;
+        return connection();
+      }
+
+      // Racing all the results, the first one that connects is used
+      const int fd{race_connect(results, options, default_attempt_delay, timeout)};
+      if(fd < 0) return connection();
+
+      sockaddr_storage peer;
+      socklen_t peer_length = sizeof(peer);
+      if(::getpeername(fd, reinterpret_cast<sockaddr*>(&peer), &peer_length) == -1)
+        peer_length = 0;
+      return connection(fd, reinterpret_cast<const sockaddr*>(&peer), peer_length);
+    }
+
+    int connection::fd() const{
+      return fd_;
+    }
+
+    int connection::io_timeout() const{
+      return io_timeout_;
+    }
+
+    void connection::io_timeout(const int timeout_in_milliseconds){
+      io_timeout_ = timeout_in_milliseconds;
+    }
+
+    bool connection::is_valid() const{
+      return fd_ >= 0;
+    }
+
+    std::size_t connection::max_message_size(){
+      return messages_.max_message_size();
+    }
+
+    bool connection::max_message_size(const std::size_t new_max_message_size){
+      return messages_.max_message_size(new_max_message_size);
+    }
+
+    std::uint32_t connection::max_intents() const{
+      return max_intents_;
+    }
+
+    void connection::max_intents(const std::uint32_t new_max_intents){
+      max_intents_ = new_max_intents;
+    }
+
+    bool connection::peer_address(sockaddr_storage *address, socklen_t *length) const{
+      if(peer_length_ == 0) return false;
+
+      std::memcpy(address, &peer_, peer_length_);
+      *length = peer_length_;
+      return true;
+    }
+
+    ssize_t connection::receive(void *buffer, const std::size_t size, const int flags){
+      if(fd_ < 0 || size == 0)
+        return 0;
+
+      ssize_t received{0};
+      std::uint32_t error_counter{0};
+
+      while(true){
+        received = ::recv(fd_, buffer, size, flags);
+
+        if(received >= 0) return received;
+
+        // Waits until the socket is ready again, it fails after the max intents
+        if(!retry(POLLIN, &error_counter))
+          return received;
+      }
+    }
+
+    ssize_t connection::receive_all(void *buffer, const std::size_t size, bool *breaker,
+                                    const int flags){
+      if(fd_ < 0 || size == 0)
+        return 0;
+
+      std::size_t total_received{0};
+      ssize_t received_size;
+      std::uint32_t error_counter{0};
+      bool never{false};
+      if(breaker == nullptr) breaker = &never;
+
+      while(total_received < size && !(*breaker)){
+        received_size = ::recv(fd_, static_cast<std::uint8_t*>(buffer) + total_received,
+                               size - total_received, flags);
+
+        if(received_size == 0) return 0;
+
+        if(received_size < 0){
+          // Waits until the socket is ready again, it fails after the max intents
+          if(!retry(POLLIN, &error_counter))
+            return received_size;
+          continue;
+        }
+        total_received += static_cast<std::size_t>(received_size);
+      }
+      return static_cast<ssize_t>(total_received);
+    }
+
+    ssize_t connection::receive_message(void *buffer, const std::size_t size, bool *breaker,
+                                        const int flags){
+      if(fd_ < 0 || size == 0)
+        return 0;
+
+      const std::uint8_t *message;
+      std::uint32_t message_size;
+      const int status = next_message(&message, &message_size, breaker, flags);
+      if(status <= 0) return status;
+
+      if(message_size > size){
+        errno = EMSGSIZE;
+        return -1;
+      }
+      std::memcpy(buffer, message, message_size);
+      return static_cast<ssize_t>(message_size);
+    }
+
+    int connection::receive_messages(const message_handler &handler, bool *breaker,
+                                     const int flags){
+      if(fd_ < 0)
+        return 0;
+
+      const std::uint8_t *message;
+      std::uint32_t message_size;
+      // Only the first message could wait for receiving more bytes
+      int status = next_message(&message, &message_size, breaker, flags);
+      if(status <= 0) return status;
+
+      int total{0};
+      do{
+        ++total;
+        if(handler) handler(message, message_size);
+      }while((status = messages_.next(&message, &message_size)) > 0);
+
+      // The broken message will be reported in the next call
+      return total;
+    }
+
+    int connection::release(){
+      const int fd{fd_};
+      fd_ = -1;
+      peer_length_ = 0;
+      messages_.clear();
+      return fd;
+    }
+
+    ssize_t connection::send(const void *buffer, const std::size_t size, const int flags){
+      if(fd_ < 0 || size == 0)
+        return 0;
+
+      std::uint32_t error_counter{0};
+      ssize_t sent{0};
+
+      while(true){
+        sent = ::send(fd_, buffer, size, flags);
+
+        if(sent >= 0) return sent;
+
+        // Waits until the socket is ready again, it fails after the max intents
+        if(!retry(POLLOUT, &error_counter))
+          return sent;
+      }
+    }
+
+    ssize_t connection::send_all(const void *buffer, const std::size_t size, bool *breaker,
+                                 const int flags){
+      if(fd_ < 0 || size == 0)
+        return 0;
+
+      std::size_t total_sent{0};
+      ssize_t sent_size;
+      std::uint32_t error_counter{0};
+      bool never{false};
+      if(breaker == nullptr) breaker = &never;
+
+      while(total_sent < size && !(*breaker)){
+        sent_size = ::send(fd_, static_cast<const std::uint8_t*>(buffer) + total_sent,
+                           size - total_sent, flags);
+        if(sent_size == 0)
+          return 0;
+
+        if(sent_size < 0){
+          // Waits until the socket is ready again, it fails after the max intents
+          if(!retry(POLLOUT, &error_counter))
+            return sent_size;
+          continue;
+        }
+        total_sent += static_cast<std::size_t>(sent_size);
+      }
+      return static_cast<ssize_t>(total_sent);
+    }
+
+    ssize_t connection::send_all(const iovec *buffers, const std::size_t count, bool *breaker,
+                                 const int flags){
+      if(fd_ < 0 || count == 0)
+        return 0;
+
+      io_vectors parts(buffers, count);
+      std::size_t total_sent{0};
+      ssize_t sent_size;
+      std::uint32_t error_counter{0};
+      msghdr header{};
+      bool never{false};
+      if(breaker == nullptr) breaker = &never;
+
+      while(!parts.empty() && !(*breaker)){
+        header.msg_iov = parts.data();
+        header.msg_iovlen = parts.count();
+        sent_size = ::sendmsg(fd_, &header, flags);
+        if(sent_size == 0)
+          return 0;
+
+        if(sent_size < 0){
+          // Waits until the socket is ready again, it fails after the max intents
+          if(!retry(POLLOUT, &error_counter))
+            return sent_size;
+          continue;
+        }
+        total_sent += static_cast<std::size_t>(sent_size);
+        parts.advance(static_cast<std::size_t>(sent_size));
+      }
+      return static_cast<ssize_t>(total_sent);
+    }
+
+    ssize_t connection::send_message(const void *buffer, const std::uint32_t size, bool *breaker,
+                                     const int flags){
+      if(fd_ < 0)
+        return 0;
+
+      std::uint8_t header[message_buffer::header_size];
+      message_buffer::write_header(header, size);
+      iovec parts[2]{{header, sizeof(header)}, {const_cast<void*>(buffer), size}};
+
+      const ssize_t sent = send_all(parts, 2, breaker, flags);
+      if(sent <= 0) return sent;
+
+      return sent > static_cast<ssize_t>(sizeof(header))
+             ? sent - static_cast<ssize_t>(sizeof(header)) : 0;
+    }
+
+    // :::::::::::::::::::::::::::::::::::: PRIVATE FUNCTIONS ::::::::::::::::::::::::::::::::::::
+
+    int connection::next_message(const std::uint8_t **message, std::uint32_t *size,
+                                 bool *breaker, const int flags){
+      bool never{false};
+      if(breaker == nullptr) breaker = &never;
+
+      while(!(*breaker)){
+        const int status = messages_.next(message, size);
+        if(status > 0) return status;
+        if(status < 0){
+          errno = EMSGSIZE;
+          return -1;
+        }
+
+        // Receives everything that is available, not only the missing part of the message
+        const std::size_t free_space = messages_.reserve();
+        const ssize_t received = receive(messages_.tail(), free_space, flags);
+        if(received <= 0) return static_cast<int>(received);
+        messages_.commit(static_cast<std::size_t>(received));
+      }
+
+      errno = ECANCELED;
+      return -1;
+    }
+
+    bool connection::retry(const short events, std::uint32_t *error_counter){
+      return retry_transfer(fd_, events, io_timeout_, max_intents_, error_counter);
+    }
+  } // namespace: network_communication
+} // namespace: ramrod
@@ -0,0 +1,273 @@
+#include "ramrod/network_communication/connection_metrics.h"
+
+#include <chrono>                      // for steady_clock, nanoseconds
+#include <cinttypes>                   // for PRIu64
+#include <cstdio>                      // for snprintf
+
+namespace ramrod {
+  namespace network_communication {
+    namespace {
+      constexpr std::memory_order relaxed{std::memory_order_relaxed};
+
+      void append(std::string *text, const char *format, const std::string &prefix,
+                  const char *name, const std::uint64_t value){
+        char line[160];
+        const int size{std::snprintf(line, sizeof(line), format, prefix.c_str(), name, value)};
+        if(size > 0) text->append(line, static_cast<std::size_t>(size) < sizeof(line)
+                                        ? static_cast<std::size_t>(size) : sizeof(line) - 1);
+      }
+
+      void append_summary(std::string *text, const std::string &prefix, const char *name,
+                          const histogram_snapshot &latency){
+        char line[160];
+        for(const double quantile : {0.5, 0.9, 0.99, 0.999}){
+          const int size{std::snprintf(line, sizeof(line), "%s%s_seconds{quantile=\"%g\"} %.9f\n",
+                                       prefix.c_str(), name, quantile,
+                                       static_cast<double>(latency.percentile(quantile)) / 1e9)};
+          if(size > 0 && static_cast<std::size_t>(size) < sizeof(line)) text->append(line);
+        }
+        const int size{std::snprintf(line, sizeof(line), "%s%s_seconds_sum %.9f\n",
+                                     prefix.c_str(), name,
+                                     static_cast<double>(latency.total) / 1e9)};
+        if(size > 0 && static_cast<std::size_t>(size) < sizeof(line)) text->append(line);
+        append(text, "%s%s_seconds_count %" PRIu64 "\n", prefix, name, latency.count);
+      }
+
+      void update_minimum(std::atomic<std::uint64_t> *minimum, const std::uint64_t value){
+        std::uint64_t current{minimum->load(relaxed)};
+        while(value < current && !minimum->compare_exchange_weak(current, value, relaxed));
+      }
+
+      void update_maximum(std::atomic<std::uint64_t> *maximum, const std::uint64_t value){
+        std::uint64_t current{maximum->load(relaxed)};
+        while(value > current && !maximum->compare_exchange_weak(current, value, relaxed));
+      }
+    } // namespace: anonymous
+
+    double histogram_snapshot::mean() const{
+      return count == 0 ? 0.0 : static_cast<double>(total) / static_cast<double>(count);
+    }
+
+    std::uint64_t histogram_snapshot::percentile(const double fraction) const{
+      if(count == 0) return 0;
+
+      std::uint64_t found{0};
+      for(std::size_t i = 0; i < counts.size(); ++i) found += counts[i];
+      if(found == 0) return 0;
+
+      const double limit{fraction <= 0.0 ? 0.0 : fraction >= 1.0 ? 1.0 : fraction};
+      std::uint64_t wanted{static_cast<std::uint64_t>(limit * static_cast<double>(found) + 0.5)};
+      if(wanted == 0) wanted = 1;
+
+      std::uint64_t accumulated{0};
+      for(std::size_t i = 0; i < counts.size(); ++i){
+        accumulated += counts[i];
+        if(accumulated < wanted) continue;
+
+        // Highest value of the bucket, every value in it is reported as the same one
+        const std::uint64_t highest{i + 1 < counts.size() ? latency_histogram::lowest(i + 1) - 1
+                                                          : latency_histogram::highest};
+        return highest < maximum ? highest : maximum;
+      }
+      return maximum;
+    }
+
+    std::string metrics_snapshot::to_text(const std::string &prefix) const{
+      std::string text;
+      const char *counter{"%s%s %" PRIu64 "\n"};
+      append(&text, counter, prefix, "bytes_sent_total", bytes_sent);
+      append(&text, counter, prefix, "bytes_received_total", bytes_received);
+      append(&text, counter, prefix, "sends_total", sends);
+      append(&text, counter, prefix, "receives_total", receives);
+      append(&text, counter, prefix, "messages_sent_total", messages_sent);
+      append(&text, counter, prefix, "messages_received_total", messages_received);
+      append(&text, counter, prefix, "send_errors_total", send_errors);
+      append(&text, counter, prefix, "receive_errors_total", receive_errors);
+      append(&text, counter, prefix, "retries_total", retries);
+      append(&text, counter, prefix, "exhausted_intents_total", exhausted_intents);
+      append(&text, counter, prefix, "connections_total", connections);
+      append(&text, counter, prefix, "connection_failures_total", connection_failures);
+      append_summary(&text, prefix, "send_latency", send_latency);
+      append_summary(&text, prefix, "receive_latency", receive_latency);
+      append_summary(&text, prefix, "connect_latency", connect_latency);
+      return text;
+    }
+
+    latency_histogram::latency_histogram() :
+      counts_(),
+      count_{0},
+      total_{0},
+      minimum_{UINT64_MAX},
+      maximum_{0}
+    {
+      for(std::atomic<std::uint64_t> &counter : counts_) counter.store(0, relaxed);
+    }
+
+    std::size_t latency_histogram::bucket(const std::uint64_t value){
+      constexpr std::uint64_t linear{std::uint64_t{1} << precision_bits};
+      if(value < linear) return static_cast<std::size_t>(value);
+      if(value > highest) return buckets - 1;
+
+      // The highest bits choose the power of two and the next ones the linear bucket
+      const unsigned shift{63u - static_cast<unsigned>(__builtin_clzll(value)) - precision_bits};
+      return (static_cast<std::size_t>(shift + 1) << precision_bits)
+             + static_cast<std::size_t>((value >> shift) - linear);
+    }
+
+    std::uint64_t latency_histogram::lowest(const std::size_t index){
+      constexpr std::size_t linear{std::size_t{1} << precision_bits};
+      if(index < linear) return index;
+
+      const std::size_t shift{(index >> precision_bits) - 1};
+      return static_cast<std::uint64_t>((index & (linear - 1)) + linear) << shift;
+    }
+
+    void latency_histogram::record(const std::uint64_t value){
+      counts_[bucket(value)].fetch_add(1, relaxed);
+      count_.fetch_add(1, relaxed);
+      total_.fetch_add(value, relaxed);
+      update_minimum(&minimum_, value);
+      update_maximum(&maximum_, value);
+    }
+
+    void latency_histogram::reset(){
+      for(std::atomic<std::uint64_t> &counter : counts_) counter.store(0, relaxed);
+      count_.store(0, relaxed);
+      total_.store(0, relaxed);
+      minimum_.store(UINT64_MAX, relaxed);
+      maximum_.store(0, relaxed);
+    }
+
+    histogram_snapshot latency_histogram::snapshot() const{
+      histogram_snapshot copy;
+      copy.count = count_.load(relaxed);
+      copy.total = total_.load(relaxed);
+      copy.maximum = maximum_.load(relaxed);
+      const std::uint64_t minimum{minimum_.load(relaxed)};
+      copy.minimum = minimum == UINT64_MAX ? 0 : minimum;
+
+      copy.counts.resize(buckets);
+      for(std::size_t i = 0; i < buckets; ++i) copy.counts[i] = counts_[i].load(relaxed);
+      return copy;
+    }
+
+    connection_metrics::connection_metrics() :
+      sending_(),
+      receiving_(),
+      latencies_{false},
+      retries_{0},
+      exhausted_intents_{0},
+      connections_{0},
+      connection_failures_{0},
+      connect_latency_()
+    {}
+
+    void connection_metrics::connected(const std::uint64_t start){
+      connections_.fetch_add(1, relaxed);
+      if(start == 0) return;
+
+      const std::uint64_t now{this->start()};
+      if(now >= start) connect_latency_.record(now - start);
+    }
+
+    void connection_metrics::connection_failed(){
+      connection_failures_.fetch_add(1, relaxed);
+    }
+
+    bool connection_metrics::failed(const bool sending, const bool exhausted){
+      (sending ? sending_ : receiving_).errors.fetch_add(1, relaxed);
+      if(exhausted) exhausted_intents_.fetch_add(1, relaxed);
+      return false;
+    }
+
+    void connection_metrics::intents_exhausted(){
+      exhausted_intents_.fetch_add(1, relaxed);
+    }
+
+    bool connection_metrics::latencies() const{
+      return latencies_.load(relaxed);
+    }
+
+    void connection_metrics::latencies(const bool enable){
+      latencies_.store(enable, relaxed);
+    }
+
+    void connection_metrics::messages_received(const std::uint64_t count){
+      receiving_.messages.fetch_add(count, relaxed);
+    }
+
+    void connection_metrics::messages_sent(const std::uint64_t count){
+      sending_.messages.fetch_add(count, relaxed);
+    }
+
+    ssize_t connection_metrics::received(const ssize_t result, const std::uint64_t start){
+      count(&receiving_, result, start);
+      return result;
+    }
+
+    void connection_metrics::reset(){
+      for(direction *counters : {&sending_, &receiving_}){
+        counters->bytes.store(0, relaxed);
+        counters->calls.store(0, relaxed);
+        counters->messages.store(0, relaxed);
+        counters->errors.store(0, relaxed);
+        counters->latency.reset();
+      }
+      retries_.store(0, relaxed);
+      exhausted_intents_.store(0, relaxed);
+      connections_.store(0, relaxed);
+      connection_failures_.store(0, relaxed);
+      connect_latency_.reset();
+    }
+
+    void connection_metrics::retried(){
+      retries_.fetch_add(1, relaxed);
+    }
+
+    ssize_t connection_metrics::sent(const ssize_t result, const std::uint64_t start){
+      count(&sending_, result, start);
+      return result;
+    }
+
+    metrics_snapshot connection_metrics::snapshot() const{
+      metrics_snapshot copy;
+      copy.bytes_sent = sending_.bytes.load(relaxed);
+      copy.bytes_received = receiving_.bytes.load(relaxed);
+      copy.sends = sending_.calls.load(relaxed);
+      copy.receives = receiving_.calls.load(relaxed);
+      copy.messages_sent = sending_.messages.load(relaxed);
+      copy.messages_received = receiving_.messages.load(relaxed);
+      copy.send_errors = sending_.errors.load(relaxed);
+      copy.receive_errors = receiving_.errors.load(relaxed);
+      copy.retries = retries_.load(relaxed);
+      copy.exhausted_intents = exhausted_intents_.load(relaxed);
+      copy.connections = connections_.load(relaxed);
+      copy.connection_failures = connection_failures_.load(relaxed);
+      copy.send_latency = sending_.latency.snapshot();
+      copy.receive_latency = receiving_.latency.snapshot();
+      copy.connect_latency = connect_latency_.snapshot();
+      return copy;
+    }
+
+    std::uint64_t connection_metrics::start() const{
+      if(!latencies_.load(relaxed)) return 0;
+      return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    // :::::::::::::::::::::::::::::::::::: PRIVATE FUNCTIONS ::::::::::::::::::::::::::::::::::::
+
+    void connection_metrics::count(direction *counters, const ssize_t result,
+                                   const std::uint64_t start){
+      if(result <= 0) return;
+
+      counters->bytes.fetch_add(static_cast<std::uint64_t>(result), relaxed);
+      counters->calls.fetch_add(1, relaxed);
+      if(start != 0){
+        const std::uint64_t now{this->start()};
+        // The latencies could be disabled while the operation was running
+        if(now >= start) counters->latency.record(now - start);
+      }
+    }
+  } // namespace: network_communication
+} // namespace: ramrod
@@ -1,23 +1,173 @@
 #include "ramrod/network_communication/conversor.h"
 
-#include <netinet/in.h>  // for htonl, htons, ntohl, ntohs
+#include <cstring>                     // for memcpy, memmove
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>                 // for _mm256_shuffle_epi8, _mm_shuffle_epi8...
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>                  // for vrev16q_u8, vrev32q_u8, vrev64q_u8...
+#endif
 
 namespace ramrod {
   namespace network_communication {
-    std::uint16_t conversor::host_to_network(const std::uint16_t host_value){
-      return ::htons(host_value);
+    namespace {
+      // Converts the bytes of the first values with SIMD, returns the converted bytes
+      using swap_kernel = std::size_t (*)(const std::uint8_t *input, std::uint8_t *output,
+                                          const std::size_t bytes);
+
+      template<std::size_t width>
+      struct swap_order {
+        // Shuffle mask that reverses every group of `width` bytes of a 16 bytes lane
+        constexpr swap_order() : bytes() {
+          for(std::size_t i = 0; i < 32; ++i)
+            bytes[i] = static_cast<char>(i / width * width + width - 1 - i % width);
+        }
+        alignas(32) char bytes[32];
+      };
+
+#if defined(__x86_64__) || defined(__i386__)
+      template<std::size_t width>
+      __attribute__((target("avx2")))
+      std::size_t swap_avx2(const std::uint8_t *input, std::uint8_t *output,
+                            const std::size_t bytes){
+        static constexpr swap_order<width> order{};
+        // The shuffle works inside each 128 bit lane, both lanes use the same mask
+        const __m256i mask{_mm256_load_si256(reinterpret_cast<const __m256i*>(order.bytes))};
+
+        std::size_t done{0};
+        for(; done + 32 <= bytes; done += 32){
+          const __m256i block{_mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + done))};
+          _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + done),
+                              _mm256_shuffle_epi8(block, mask));
+        }
+        return done;
+      }
+
+      template<std::size_t width>
+      __attribute__((target("ssse3")))
+      std::size_t swap_ssse3(const std::uint8_t *input, std::uint8_t *output,
+                             const std::size_t bytes){
+        static constexpr swap_order<width> order{};
+        const __m128i mask{_mm_load_si128(reinterpret_cast<const __m128i*>(order.bytes))};
+
+        std::size_t done{0};
+        for(; done + 16 <= bytes; done += 16){
+          const __m128i block{_mm_loadu_si128(reinterpret_cast<const __m128i*>(input + done))};
+          _mm_storeu_si128(reinterpret_cast<__m128i*>(output + done),
+                           _mm_shuffle_epi8(block, mask));
+        }
+        return done;
+      }
+
+      template<std::size_t width>
+      swap_kernel best_kernel(){
+        __builtin_cpu_init();
+        if(__builtin_cpu_supports("avx2")) return swap_avx2<width>;
+        if(__builtin_cpu_supports("ssse3")) return swap_ssse3<width>;
+        return nullptr;
+      }
+#elif defined(__ARM_NEON)
+      template<std::size_t width>
+      std::size_t swap_neon(const std::uint8_t *input, std::uint8_t *output,
+                            const std::size_t bytes){
+        std::size_t done{0};
+        for(; done + 16 <= bytes; done += 16){
+          const uint8x16_t block{vld1q_u8(input + done)};
+          if constexpr(width == 2) vst1q_u8(output + done, vrev16q_u8(block));
+          else if constexpr(width == 4) vst1q_u8(output + done, vrev32q_u8(block));
+          else vst1q_u8(output + done, vrev64q_u8(block));
+        }
+        return done;
+      }
+
+      template<std::size_t width>
+      swap_kernel best_kernel(){
+        return swap_neon<width>;
+      }
+#else
+      template<std::size_t width>
+      swap_kernel best_kernel(){
+        return nullptr;
+      }
+#endif
+
+      // Reverses the bytes of every value of the integer type T, the input and the output
+      // could be the same array
+      template<typename T>
+      void swap_all(const void *input, void *output, const std::size_t count){
+        constexpr std::size_t width{sizeof(T)};
+        const std::size_t bytes{count * width};
+
+        if(conversor::native_network_order){
+          if(input != output) std::memmove(output, input, bytes);
+          return;
+        }
+
+        const std::uint8_t *source{static_cast<const std::uint8_t*>(input)};
+        std::uint8_t *destination{static_cast<std::uint8_t*>(output)};
+
+        // The processor is checked only once per width
+        static const swap_kernel vectorized{best_kernel<width>()};
+        std::size_t done{vectorized != nullptr ? vectorized(source, destination, bytes) : 0};
+
+        // The last values that do not fill a whole SIMD register
+        for(; done < bytes; done += width){
+          T value;
+          std::memcpy(&value, source + done, width);
+          value = conversor::host_to_network(value);
+          std::memcpy(destination + done, &value, width);
+        }
+      }
+    } // namespace: anonymous
+
+    void conversor::host_to_network(const std::uint16_t *input, std::uint16_t *output,
+                                    const std::size_t count){
+      swap_all<std::uint16_t>(input, output, count);
+    }
+
+    void conversor::host_to_network(const std::uint32_t *input, std::uint32_t *output,
+                                    const std::size_t count){
+      swap_all<std::uint32_t>(input, output, count);
+    }
+
+    void conversor::host_to_network(const std::uint64_t *input, std::uint64_t *output,
+                                    const std::size_t count){
+      swap_all<std::uint64_t>(input, output, count);
+    }
+
+    void conversor::host_to_network(const float *input, std::uint32_t *output,
+                                    const std::size_t count){
+      swap_all<std::uint32_t>(input, output, count);
+    }
+
+    void conversor::host_to_network(const double *input, std::uint64_t *output,
+                                    const std::size_t count){
+      swap_all<std::uint64_t>(input, output, count);
+    }
+
+    void conversor::network_to_host(const std::uint16_t *input, std::uint16_t *output,
+                                    const std::size_t count){
+      swap_all<std::uint16_t>(input, output, count);
+    }
+
+    void conversor::network_to_host(const std::uint32_t *input, std::uint32_t *output,
+                                    const std::size_t count){
+      swap_all<std::uint32_t>(input, output, count);
     }
 
-    std::uint32_t conversor::host_to_network(const std::uint32_t host_value){
-      return ::htonl(host_value);
+    void conversor::network_to_host(const std::uint64_t *input, std::uint64_t *output,
+                                    const std::size_t count){
+      swap_all<std::uint64_t>(input, output, count);
     }
 
-    std::uint16_t conversor::network_to_host(const std::uint16_t network_value){
-      return ::ntohs(network_value);
+    void conversor::network_to_host(const std::uint32_t *input, float *output,
+                                    const std::size_t count){
+      swap_all<std::uint32_t>(input, output, count);
     }
 
-    std::uint32_t conversor::network_to_host(const std::uint32_t network_value){
-      return ::ntohl(network_value);
+    void conversor::network_to_host(const std::uint64_t *input, double *output,
+                                    const std::size_t count){
+      swap_all<std::uint64_t>(input, output, count);
     }
-  } // namespace: network_communication 
-} // namespace: ramrod
\ No newline at end of file
+  } // namespace: network_communication
+} // namespace: ramrod
@@ -0,0 +1,170 @@
+#include "ramrod/network_communication/event_loop.h"
+
+#include <cerrno>                      // for errno, EINTR
+#include <cstdint>                     // for uint64_t
+#include <sys/epoll.h>                 // for epoll_event, epoll_ctl, EPOLLIN
+#include <sys/eventfd.h>               // for eventfd, EFD_CLOEXEC, EFD_NONBLOCK
+#include <unistd.h>                    // for close, read, write
+
+#include "ramrod/console/perror.h"     // for perror, perror_stream
+
+namespace ramrod {
+  namespace network_communication {
+    event_loop::event_loop() :
+      epoll_fd_{-1},
+      wake_fd_{-1},
+      options_(),
+      running_{false},
+      callback_(),
+      thread_()
+    {}
+
+    event_loop::~event_loop(){
+      stop();
+      // Destroyed by its own callback, the thread cannot join itself
+      if(thread_.joinable()){
+        if(thread_.get_id() == std::this_thread::get_id())
+          thread_.detach();
+        else
+          thread_.join();
+      }
+      release();
+    }
+
+    bool event_loop::add(const int fd, const std::uint32_t events){
+      if(epoll_fd_ < 0) return false;
+
+      epoll_event event{};
+      event.events = events;
+      event.data.fd = fd;
+      if(::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &event) == -1){
+#ifdef VERBOSE
+        rr::perror("Adding descriptor to event loop");
+#endif
+        return false;
+      }
+      return true;
+    }
+
+    bool event_loop::is_running(){
+      return running_.load(std::memory_order_relaxed);
+    }
+
+    bool event_loop::modify(const int fd, const std::uint32_t events){
+      if(epoll_fd_ < 0) return false;
+
+      epoll_event event{};
+      event.events = events;
+      event.data.fd = fd;
+      if(::epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, fd, &event) == -1){
+#ifdef VERBOSE
+        rr::perror("Modifying descriptor in event loop");
+#endif
+        return false;
+      }
+      return true;
+    }
+
+    bool event_loop::remove(const int fd){
+      if(epoll_fd_ < 0) return false;
+
+      if(::epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd, nullptr) == -1){
+#ifdef VERBOSE
+        rr::perror("Removing descriptor from event loop");
+#endif
+        return false;
+      }
+      return true;
+    }
+
+    bool event_loop::start(const callback &on_event, const int cpu){
+      thread_options options;
+      if(cpu >= 0) options.cpus.push_back(cpu);
+      return start(on_event, options);
+    }
+
+    bool event_loop::start(const callback &on_event, const thread_options &options){
+      if(running_.load() || !on_event) return false;
+      // The previous thread was stopped by its callback or an error, it must finish before
+      // its descriptors are closed, and it cannot wait for itself
+      if(thread_.joinable()){
+        if(thread_.get_id() == std::this_thread::get_id()) return false;
+        thread_.join();
+      }
+      release();
+
+      if((epoll_fd_ = ::epoll_create1(EPOLL_CLOEXEC)) == -1){
+        rr::perror("Creating event loop");
+        return false;
+      }
+
+      if((wake_fd_ = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK)) == -1){
+        rr::perror("Creating event loop's wake up descriptor");
+        release();
+        return false;
+      }
+
+      if(!add(wake_fd_, EPOLLIN)){
+        release();
+        return false;
+      }
+
+      callback_ = on_event;
+      options_ = options;
+      running_.store(true);
+
+      thread_ = std::thread(&event_loop::run, this);
+      return true;
+    }
+
+    void event_loop::stop(){
+      if(!thread_.joinable() || !running_.exchange(false)) return;
+
+      const std::uint64_t wake{1};
+      if(::write(wake_fd_, &wake, sizeof(wake)) < 0)
+        rr::perror("Waking up event loop");
+
+      // From the callback it finishes after returning, the next start() joins it
+      if(thread_.get_id() != std::this_thread::get_id()) thread_.join();
+    }
+
+    // :::::::::::::::::::::::::::::::::::: PRIVATE FUNCTIONS ::::::::::::::::::::::::::::::::::::
+
+    void event_loop::release(){
+      if(wake_fd_ >= 0) ::close(wake_fd_);
+      if(epoll_fd_ >= 0) ::close(epoll_fd_);
+      wake_fd_ = -1;
+      epoll_fd_ = -1;
+    }
+
+    void event_loop::run(){
+      constexpr int max_events{64};
+      epoll_event events[max_events];
+      // Copies, so the members are only read once
+      const int epoll_fd{epoll_fd_};
+      const int wake_fd{wake_fd_};
+      const callback on_event{callback_};
+      const thread_options options{options_};
+      configure_current_thread(options);
+
+      while(running_.load()){
+        const int ready = ::epoll_wait(epoll_fd, events, max_events, -1);
+
+        if(ready < 0){
+          if(errno == EINTR) continue;
+#ifdef VERBOSE
+          rr::perror("Waiting for events");
+#endif
+          // Then is_running() tells it and the loop could be started again
+          running_.store(false);
+          break;
+        }
+
+        for(int i = 0; i < ready && running_.load(); ++i){
+          if(events[i].data.fd == wake_fd) continue;
+          on_event(events[i].data.fd, events[i].events);
+        }
+      }
+    }
+  } // namespace: network_communication
+} // namespace: ramrod
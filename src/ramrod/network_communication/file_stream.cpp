@@ -0,0 +1,124 @@
+#include "ramrod/network_communication/file_stream.h"
+
+#include <cerrno>                      // for errno, EAGAIN, EBADF, EINVAL, ESPIPE
+#include <fcntl.h>                     // for splice, SPLICE_F_MORE, SPLICE_F_MOVE
+#include <poll.h>                      // for poll, pollfd, POLLIN, POLLOUT
+#include <pthread.h>                   // for pthread_sigmask
+#include <signal.h>                    // for sigaddset, sigemptyset, sigismember
+#include <sys/sendfile.h>              // for sendfile
+#include <sys/stat.h>                  // for fstat, stat, S_ISBLK, S_ISFIFO, S_I...
+
+namespace ramrod {
+  namespace network_communication {
+    file_stream::file_stream() :
+      fd_{-1},
+      offset_{0},
+      total_{0},
+      sent_{0},
+      is_pipe_{false},
+      ended_{false},
+      source_empty_{false}
+    {}
+
+    bool file_stream::finished() const{
+      return ended_ || (total_ > 0 && sent_ >= total_);
+    }
+
+    bool file_stream::open(const int fd, const off_t offset, const std::size_t length){
+      struct stat status;
+      if(::fstat(fd, &status) == -1) return false;
+
+      if(offset < 0){
+        errno = EINVAL;
+        return false;
+      }
+
+      std::size_t total{length};
+      if(S_ISFIFO(status.st_mode)){
+        // A pipe cannot be read from a position
+        if(offset != 0){
+          errno = ESPIPE;
+          return false;
+        }
+      }else if(S_ISREG(status.st_mode)){
+        if(offset > status.st_size){
+          errno = EINVAL;
+          return false;
+        }
+        // The size is known, so the transfer never waits for an end that already passed
+        const std::size_t available{static_cast<std::size_t>(status.st_size - offset)};
+        if(total == 0 || total > available) total = available;
+      }else if(!S_ISBLK(status.st_mode)){
+        errno = EINVAL;
+        return false;
+      }
+
+      fd_ = fd;
+      offset_ = offset;
+      total_ = total;
+      sent_ = 0;
+      is_pipe_ = S_ISFIFO(status.st_mode);
+      // An empty part of a regular file is already finished
+      ended_ = S_ISREG(status.st_mode) && total == 0;
+      source_empty_ = false;
+      return true;
+    }
+
+    ssize_t file_stream::send(const int socket_fd){
+      if(fd_ < 0){
+        errno = EBADF;
+        return -1;
+      }
+      if(finished()) return 0;
+
+      std::size_t chunk{file_chunk_size};
+      if(total_ > 0 && total_ - sent_ < chunk) chunk = total_ - sent_;
+
+      // sendfile() and splice() do not accept MSG_NOSIGNAL, so SIGPIPE is blocked and the
+      // one raised by this call is discarded (a partial send could raise it too)
+      sigset_t pipe_signal, previous, pending;
+      ::sigemptyset(&pipe_signal);
+      ::sigaddset(&pipe_signal, SIGPIPE);
+      ::pthread_sigmask(SIG_BLOCK, &pipe_signal, &previous);
+      ::sigpending(&pending);
+      const bool was_pending{::sigismember(&pending, SIGPIPE) == 1};
+
+      const ssize_t sent = is_pipe_
+                           ? ::splice(fd_, nullptr, socket_fd, nullptr, chunk,
+                                      SPLICE_F_MOVE | SPLICE_F_MORE)
+                           : ::sendfile(socket_fd, fd_, &offset_, chunk);
+
+      const int error{errno};
+      // splice() does not tell which side would block, the socket or an empty pipe
+      source_empty_ = false;
+      if(sent == -1 && is_pipe_ && (error == EAGAIN || error == EWOULDBLOCK)){
+        pollfd source{fd_, POLLIN, 0};
+        source_empty_ = ::poll(&source, 1, 0) == 0;
+      }
+      ::sigpending(&pending);
+      if(!was_pending && ::sigismember(&pending, SIGPIPE) == 1){
+        const timespec immediately{0, 0};
+        ::sigtimedwait(&pipe_signal, nullptr, &immediately);
+      }
+      ::pthread_sigmask(SIG_SETMASK, &previous, nullptr);
+      errno = error;
+
+      if(sent == 0) ended_ = true;
+      if(sent > 0) sent_ += static_cast<std::size_t>(sent);
+      return sent;
+    }
+
+    std::size_t file_stream::sent() const{
+      return sent_;
+    }
+
+    std::size_t file_stream::total() const{
+      return total_;
+    }
+
+    int file_stream::waiting_fd(const int socket_fd, short *events) const{
+      *events = source_empty_ ? POLLIN : POLLOUT;
+      return source_empty_ ? fd_ : socket_fd;
+    }
+  } // namespace: network_communication
+} // namespace: ramrod
@@ -0,0 +1,466 @@
+#include "ramrod/network_communication/io_ring.h"
+
+#include <cerrno>                      // for errno, EBADF, EBUSY, EEXIST, EINTR, EINVAL
+#include <cstring>                     // for memset
+#include <linux/io_uring.h>            // for io_uring_params, io_uring_sqe, io_uring_cqe...
+#include <poll.h>                      // for POLLIN, POLLOUT
+#include <sys/mman.h>                  // for mmap, munmap, MAP_FAILED, PROT_READ, PROT_WRITE
+#include <sys/socket.h>                // for MSG_WAITALL
+#include <sys/syscall.h>               // for __NR_io_uring_setup, __NR_io_uring_enter...
+#include <unistd.h>                    // for syscall, close, sysconf, _SC_PAGESIZE
+
+#include "ramrod/network_communication/socket_wait.h"
+
+namespace ramrod {
+  namespace network_communication {
+    namespace {
+      // The buffer group used by all the multishot receptions of a ring
+      constexpr std::uint16_t buffer_group{0};
+      // Limit of the kernel for a provided buffer ring
+      constexpr std::size_t max_provided_buffers{32768};
+
+      void *map_ring(const int fd, const std::size_t size, const long long offset){
+        return ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                      fd, offset);
+      }
+
+      // The tail of a provided buffer ring overlays the reserved field of its first entry,
+      // `io_uring_buf_ring::bufs` is not used because the header misplaces it in C++
+      std::uint16_t *buffer_tail(io_uring_buf *ring){
+        return &ring[0].resv;
+      }
+
+      template<typename T>
+      T *at(void *memory, const std::uint32_t offset){
+        return reinterpret_cast<T*>(static_cast<char*>(memory) + offset);
+      }
+    } // namespace: anonymous
+
+    io_ring::io_ring(const unsigned int entries) :
+      fd_{-1},
+      sq_memory_{MAP_FAILED},
+      sq_size_{0},
+      sq_head_{nullptr},
+      sq_tail_{nullptr},
+      sq_mask_{0},
+      sq_array_{nullptr},
+      sqes_{nullptr},
+      sqes_size_{0},
+      pending_{0},
+      cq_memory_{MAP_FAILED},
+      cq_size_{0},
+      cq_head_{nullptr},
+      cq_tail_{nullptr},
+      cq_mask_{0},
+      cqes_{nullptr},
+      buffer_ring_{nullptr},
+      buffer_ring_size_{0},
+      buffer_mask_{0},
+      provided_(),
+      registered_()
+    {
+      io_uring_params parameters;
+      std::memset(&parameters, 0, sizeof(parameters));
+
+      fd_ = static_cast<int>(::syscall(__NR_io_uring_setup, entries > 0 ? entries : 1,
+                                       &parameters));
+      if(fd_ < 0){
+        fd_ = -1;
+        return;
+      }
+
+      sq_size_ = parameters.sq_off.array + parameters.sq_entries * sizeof(unsigned int);
+      cq_size_ = parameters.cq_off.cqes + parameters.cq_entries * sizeof(io_uring_cqe);
+
+      // Newer kernels map both queues with only one call
+      const bool single_map{(parameters.features & IORING_FEAT_SINGLE_MMAP) != 0};
+      if(single_map){
+        if(cq_size_ > sq_size_) sq_size_ = cq_size_;
+        cq_size_ = sq_size_;
+      }
+
+      sq_memory_ = map_ring(fd_, sq_size_, IORING_OFF_SQ_RING);
+      if(sq_memory_ != MAP_FAILED)
+        cq_memory_ = single_map ? sq_memory_ : map_ring(fd_, cq_size_, IORING_OFF_CQ_RING);
+
+      sqes_size_ = parameters.sq_entries * sizeof(io_uring_sqe);
+      void *sqes{MAP_FAILED};
+      if(cq_memory_ != MAP_FAILED) sqes = map_ring(fd_, sqes_size_, IORING_OFF_SQES);
+
+      if(sqes == MAP_FAILED){
+        const int error{errno};
+        release();
+        errno = error;
+        return;
+      }
+      sqes_ = static_cast<io_uring_sqe*>(sqes);
+
+      sq_head_ = at<unsigned int>(sq_memory_, parameters.sq_off.head);
+      sq_tail_ = at<unsigned int>(sq_memory_, parameters.sq_off.tail);
+      sq_mask_ = *at<unsigned int>(sq_memory_, parameters.sq_off.ring_mask);
+      sq_array_ = at<unsigned int>(sq_memory_, parameters.sq_off.array);
+
+      cq_head_ = at<unsigned int>(cq_memory_, parameters.cq_off.head);
+      cq_tail_ = at<unsigned int>(cq_memory_, parameters.cq_off.tail);
+      cq_mask_ = *at<unsigned int>(cq_memory_, parameters.cq_off.ring_mask);
+      cqes_ = at<io_uring_cqe>(cq_memory_, parameters.cq_off.cqes);
+
+      // Every slot of the indirection array points always to the same entry
+      for(unsigned int i = 0; i < parameters.sq_entries; ++i) sq_array_[i] = i;
+    }
+
+    io_ring::~io_ring(){
+      release();
+    }
+
+    std::size_t io_ring::completions(io_completion *completions, const std::size_t count){
+      if(fd_ < 0) return 0;
+
+      unsigned int head{*cq_head_};
+      const unsigned int tail{__atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE)};
+
+      std::size_t read{0};
+      for(; head != tail && read < count; ++head, ++read){
+        const io_uring_cqe &cqe{cqes_[head & cq_mask_]};
+        completions[read] = {cqe.user_data, cqe.res, cqe.flags};
+      }
+      __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+      return read;
+    }
+
+    bool io_ring::is_valid(){
+      return fd_ >= 0;
+    }
+
+    bool io_ring::prepare_cancel(const std::uint64_t target, const std::uint64_t user_data){
+      io_uring_sqe *sqe{next()};
+      if(sqe == nullptr) return false;
+
+      sqe->opcode = IORING_OP_ASYNC_CANCEL;
+      sqe->fd = -1;
+      sqe->addr = target;
+      sqe->user_data = user_data;
+      return true;
+    }
+
+    bool io_ring::prepare_receive(const int fd, void *buffer, const std::size_t size,
+                                  const int flags, const std::uint64_t user_data){
+      io_uring_sqe *sqe{next()};
+      if(sqe == nullptr) return false;
+
+      sqe->opcode = IORING_OP_RECV;
+      sqe->fd = fd;
+      sqe->addr = reinterpret_cast<std::uint64_t>(buffer);
+      sqe->len = static_cast<std::uint32_t>(size);
+      sqe->msg_flags = static_cast<std::uint32_t>(flags);
+      sqe->user_data = user_data;
+      return true;
+    }
+
+    bool io_ring::prepare_receive_multishot(const int fd, const int flags,
+                                            const std::uint64_t user_data){
+      if(buffer_ring_ == nullptr){
+        errno = EINVAL;
+        return false;
+      }
+      io_uring_sqe *sqe{next()};
+      if(sqe == nullptr) return false;
+
+      sqe->opcode = IORING_OP_RECV;
+      sqe->flags = IOSQE_BUFFER_SELECT;
+      sqe->ioprio = IORING_RECV_MULTISHOT;
+      sqe->fd = fd;
+      sqe->msg_flags = static_cast<std::uint32_t>(flags);
+      sqe->buf_group = buffer_group;
+      sqe->user_data = user_data;
+      return true;
+    }
+
+    bool io_ring::prepare_read_fixed(const int fd, void *buffer, const std::size_t size,
+                                     const std::uint16_t index, const std::uint64_t user_data){
+      io_uring_sqe *sqe{next()};
+      if(sqe == nullptr) return false;
+
+      sqe->opcode = IORING_OP_READ_FIXED;
+      sqe->fd = fd;
+      sqe->addr = reinterpret_cast<std::uint64_t>(buffer);
+      sqe->len = static_cast<std::uint32_t>(size);
+      sqe->buf_index = index;
+      sqe->user_data = user_data;
+      return true;
+    }
+
+    bool io_ring::prepare_send(const int fd, const void *buffer, const std::size_t size,
+                               const int flags, const std::uint64_t user_data){
+      io_uring_sqe *sqe{next()};
+      if(sqe == nullptr) return false;
+
+      sqe->opcode = IORING_OP_SEND;
+      sqe->fd = fd;
+      sqe->addr = reinterpret_cast<std::uint64_t>(buffer);
+      sqe->len = static_cast<std::uint32_t>(size);
+      sqe->msg_flags = static_cast<std::uint32_t>(flags);
+      sqe->user_data = user_data;
+      return true;
+    }
+
+    bool io_ring::provide_buffers(const iovec *buffers, const std::size_t count){
+      if(fd_ < 0 || buffers == nullptr || count == 0 || count > max_provided_buffers){
+        errno = fd_ < 0 ? EBADF : EINVAL;
+        return false;
+      }
+      if(buffer_ring_ != nullptr){
+        errno = EEXIST;
+        return false;
+      }
+
+      // The kernel needs a power of two entries aligned to a page
+      unsigned int entries{1};
+      while(entries < count) entries <<= 1;
+      const std::size_t page{static_cast<std::size_t>(::sysconf(_SC_PAGESIZE))};
+      const std::size_t size{(entries * sizeof(io_uring_buf) + page - 1) / page * page};
+
+      void *memory{::mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                          MAP_ANONYMOUS | MAP_PRIVATE, -1, 0)};
+      if(memory == MAP_FAILED) return false;
+
+      io_uring_buf_reg registration;
+      std::memset(&registration, 0, sizeof(registration));
+      registration.ring_addr = reinterpret_cast<std::uint64_t>(memory);
+      registration.ring_entries = entries;
+      registration.bgid = buffer_group;
+
+      if(::syscall(__NR_io_uring_register, fd_, IORING_REGISTER_PBUF_RING,
+                   &registration, 1) < 0){
+        const int error{errno};
+        ::munmap(memory, size);
+        errno = error;
+        return false;
+      }
+
+      buffer_ring_ = static_cast<io_uring_buf*>(memory);
+      buffer_ring_size_ = size;
+      buffer_mask_ = entries - 1;
+      provided_.assign(buffers, buffers + count);
+
+      for(std::size_t i = 0; i < count; ++i){
+        io_uring_buf &buffer{buffer_ring_[i]};
+        buffer.addr = reinterpret_cast<std::uint64_t>(buffers[i].iov_base);
+        buffer.len = static_cast<std::uint32_t>(buffers[i].iov_len);
+        buffer.bid = static_cast<std::uint16_t>(i);
+      }
+      __atomic_store_n(buffer_tail(buffer_ring_), static_cast<std::uint16_t>(count),
+                       __ATOMIC_RELEASE);
+      return true;
+    }
+
+    void *io_ring::provided_buffer(const io_completion &completion){
+      if((completion.flags & IORING_CQE_F_BUFFER) == 0) return nullptr;
+
+      const std::size_t id{completion.flags >> IORING_CQE_BUFFER_SHIFT};
+      return id < provided_.size() ? provided_[id].iov_base : nullptr;
+    }
+
+    void io_ring::recycle(const io_completion &completion){
+      if(buffer_ring_ == nullptr || (completion.flags & IORING_CQE_F_BUFFER) == 0) return;
+
+      const std::size_t id{completion.flags >> IORING_CQE_BUFFER_SHIFT};
+      if(id >= provided_.size()) return;
+
+      // Only this thread writes the tail, the kernel only reads it
+      const std::uint16_t tail{*buffer_tail(buffer_ring_)};
+      io_uring_buf &buffer{buffer_ring_[tail & buffer_mask_]};
+      buffer.addr = reinterpret_cast<std::uint64_t>(provided_[id].iov_base);
+      buffer.len = static_cast<std::uint32_t>(provided_[id].iov_len);
+      buffer.bid = static_cast<std::uint16_t>(id);
+      __atomic_store_n(buffer_tail(buffer_ring_), static_cast<std::uint16_t>(tail + 1),
+                       __ATOMIC_RELEASE);
+    }
+
+    bool io_ring::register_buffers(const iovec *buffers, const std::size_t count){
+      if(fd_ < 0){
+        errno = EBADF;
+        return false;
+      }
+      if(::syscall(__NR_io_uring_register, fd_, IORING_REGISTER_BUFFERS,
+                   buffers, static_cast<unsigned int>(count)) != 0)
+        return false;
+
+      registered_.assign(buffers, buffers + count);
+      return true;
+    }
+
+    bool io_ring::registered(const void *buffer, const std::size_t size,
+                             std::uint16_t *index){
+      const std::uint8_t *begin{static_cast<const std::uint8_t*>(buffer)};
+
+      for(std::size_t i = 0; i < registered_.size(); ++i){
+        const std::uint8_t *first{static_cast<const std::uint8_t*>(registered_[i].iov_base)};
+        if(begin >= first && begin + size <= first + registered_[i].iov_len){
+          *index = static_cast<std::uint16_t>(i);
+          return true;
+        }
+      }
+      return false;
+    }
+
+    int io_ring::submit(const unsigned int wait_for){
+      if(fd_ < 0){
+        errno = EBADF;
+        return -1;
+      }
+
+      // Publishes everything prepared since the last call, all in one system call
+      if(pending_ > 0){
+        __atomic_store_n(sq_tail_, *sq_tail_ + pending_, __ATOMIC_RELEASE);
+        pending_ = 0;
+      }
+      // Entries rejected by a previous interrupted call are still in the queue
+      const unsigned int unsubmitted{*sq_tail_ - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE)};
+      if(unsubmitted == 0 && wait_for == 0) return 0;
+
+      const unsigned int flags{wait_for > 0 ? IORING_ENTER_GETEVENTS : 0U};
+      while(true){
+        const long result{::syscall(__NR_io_uring_enter, fd_, unsubmitted, wait_for,
+                                    flags, nullptr, 0)};
+        if(result >= 0) return static_cast<int>(result);
+        if(errno != EINTR) return -1;
+      }
+    }
+
+    bool io_ring::unregister_buffers(){
+      if(fd_ < 0){
+        errno = EBADF;
+        return false;
+      }
+      if(::syscall(__NR_io_uring_register, fd_, IORING_UNREGISTER_BUFFERS, nullptr, 0) != 0)
+        return false;
+
+      registered_.clear();
+      return true;
+    }
+
+    int io_ring::wait(io_completion *completions, const std::size_t count, const int timeout){
+      if(submit() < 0) return -1;
+
+      while(true){
+        const std::size_t read{this->completions(completions, count)};
+        if(read > 0) return static_cast<int>(read);
+
+        if(timeout < 0){
+          if(submit(1) < 0) return -1;
+          continue;
+        }
+        // The ring's descriptor is readable while there are completions
+        const int ready{wait_for_socket(fd_, POLLIN, timeout)};
+        if(ready <= 0) return ready;
+      }
+    }
+
+    // :::::::::::::::::::::::::::::::::::: PRIVATE FUNCTIONS ::::::::::::::::::::::::::::::::::::
+
+    io_uring_sqe *io_ring::next(){
+      if(fd_ < 0){
+        errno = EBADF;
+        return nullptr;
+      }
+
+      const unsigned int tail{*sq_tail_ + pending_};
+      if(tail - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE) > sq_mask_){
+        errno = EBUSY;
+        return nullptr;
+      }
+
+      io_uring_sqe *sqe{&sqes_[tail & sq_mask_]};
+      std::memset(sqe, 0, sizeof(io_uring_sqe));
+      ++pending_;
+      return sqe;
+    }
+
+    void io_ring::release(){
+      if(buffer_ring_ != nullptr) ::munmap(buffer_ring_, buffer_ring_size_);
+      if(sqes_ != nullptr) ::munmap(sqes_, sqes_size_);
+      if(cq_memory_ != MAP_FAILED && cq_memory_ != sq_memory_) ::munmap(cq_memory_, cq_size_);
+      if(sq_memory_ != MAP_FAILED) ::munmap(sq_memory_, sq_size_);
+      if(fd_ >= 0) ::close(fd_);
+
+      fd_ = -1;
+      sq_memory_ = MAP_FAILED;
+      cq_memory_ = MAP_FAILED;
+      sqes_ = nullptr;
+      buffer_ring_ = nullptr;
+      provided_.clear();
+      registered_.clear();
+    }
+
+    // :::::::::::::::::::::::::::::::::::: OUTTER FUNCTIONS :::::::::::::::::::::::::::::::::::
+
+    ssize_t ring_receive_all(io_ring *ring, const int fd, void *buffer, const std::size_t size,
+                             bool *breaker, const int flags, const int timeout_in_milliseconds,
+                             const std::uint32_t max_intents, connection_metrics *metrics){
+      std::uint8_t *data{static_cast<std::uint8_t*>(buffer)};
+      std::size_t total_received{0};
+      std::uint32_t error_counter{0};
+      std::uint16_t index;
+      io_completion result;
+
+      while(total_received < size && !(*breaker)){
+        std::uint8_t *position{data + total_received};
+        const std::size_t bytes_left{size - total_received};
+        // The registered memory is not mapped again by the kernel in every reception
+        if(ring->registered(position, bytes_left, &index))
+          ring->prepare_read_fixed(fd, position, bytes_left, index, 0);
+        else
+          ring->prepare_receive(fd, position, bytes_left, flags | MSG_WAITALL, 0);
+
+        // Submitting and waiting for the result with only one system call
+        if(ring->submit(1) < 0 || ring->completions(&result, 1) == 0)
+          return -1;
+
+        if(result.result == 0) return 0;
+
+        if(result.result < 0){
+          // Waits until the socket is ready again, it fails after the max intents
+          errno = -result.result;
+          if(!retry_transfer(fd, POLLIN, timeout_in_milliseconds, max_intents, &error_counter,
+                             nullptr, metrics))
+            return -1;
+          continue;
+        }
+        total_received += static_cast<std::size_t>(result.result);
+      }
+      return static_cast<ssize_t>(total_received);
+    }
+
+    ssize_t ring_send_all(io_ring *ring, const int fd, const void *buffer, const std::size_t size,
+                          bool *breaker, const int flags, const int timeout_in_milliseconds,
+                          const std::uint32_t max_intents, connection_metrics *metrics){
+      const std::uint8_t *data{static_cast<const std::uint8_t*>(buffer)};
+      std::size_t total_sent{0};
+      std::uint32_t error_counter{0};
+      io_completion result;
+
+      while(total_sent < size && !(*breaker)){
+        ring->prepare_send(fd, data + total_sent, size - total_sent, flags, 0);
+
+        // Submitting and waiting for the result with only one system call
+        if(ring->submit(1) < 0 || ring->completions(&result, 1) == 0)
+          return -1;
+
+        // The other device has disconnected
+        if(result.result == 0) return 0;
+
+        if(result.result < 0){
+          // Waits until the socket is ready again, it fails after the max intents
+          errno = -result.result;
+          if(!retry_transfer(fd, POLLOUT, timeout_in_milliseconds, max_intents, &error_counter,
+                             nullptr, metrics))
+            return -1;
+          continue;
+        }
+        total_sent += static_cast<std::size_t>(result.result);
+      }
+      return static_cast<ssize_t>(total_sent);
+    }
+  } // namespace: network_communication
+} // namespace: ramrod
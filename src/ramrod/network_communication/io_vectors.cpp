@@ -0,0 +1,57 @@
+#include "ramrod/network_communication/io_vectors.h"
+
+#include <climits>                     // for IOV_MAX
+#include <cstdint>                     // for uint8_t
+
+namespace ramrod {
+  namespace network_communication {
+    io_vectors::io_vectors(const iovec *buffers, const std::size_t count) :
+      local_{},
+      allocated_(),
+      parts_{local_},
+      count_{0},
+      total_{0}
+    {
+      if(count > local_size_){
+        allocated_.resize(count);
+        parts_ = allocated_.data();
+      }
+
+      for(std::size_t i{0}; i < count; ++i){
+        if(buffers[i].iov_len == 0) continue;
+        parts_[count_++] = buffers[i];
+        total_ += buffers[i].iov_len;
+      }
+    }
+
+    void io_vectors::advance(std::size_t bytes){
+      // Skipping the parts that were completely transferred and moving inside the last one
+      while(count_ > 0 && bytes >= parts_->iov_len){
+        bytes -= parts_->iov_len;
+        ++parts_;
+        --count_;
+      }
+      if(count_ > 0){
+        parts_->iov_base = static_cast<std::uint8_t*>(parts_->iov_base) + bytes;
+        parts_->iov_len -= bytes;
+      }
+    }
+
+    std::size_t io_vectors::count() const{
+      const std::size_t maximum{static_cast<std::size_t>(IOV_MAX)};
+      return count_ < maximum ? count_ : maximum;
+    }
+
+    iovec *io_vectors::data(){
+      return parts_;
+    }
+
+    bool io_vectors::empty() const{
+      return count_ == 0;
+    }
+
+    std::size_t io_vectors::total() const{
+      return total_;
+    }
+  } // namespace: network_communication
+} // namespace: ramrod
@@ -0,0 +1,157 @@
+#include "ramrod/network_communication/listener.h"
+
+#include <cerrno>                      // for errno, EBADF, ECONNABORTED, E...
+#include <netdb.h>                     // for addrinfo, AI_PASSIVE
+#include <poll.h>                      // for POLLIN
+#include <sys/socket.h>                // for accept4, bind, listen, socket, SOC...
+#include <sys/un.h>                    // for sockaddr_un
+#include <unistd.h>                    // for close, unlink
+#include <utility>                     // for move
+
+#include "ramrod/console/perror.h"     // for perror
+#include "ramrod/network_communication/address_cache.h"
+#include "ramrod/network_communication/local_socket.h"
+#include "ramrod/network_communication/socket_wait.h"
+
+namespace ramrod {
+  namespace network_communication {
+    listener::listener() :
+      fd_{-1},
+      options_(),
+      local_path_()
+    {}
+
+    listener::~listener(){
+      close();
+    }
+
+    listener::listener(listener &&other) noexcept :
+      fd_{other.fd_},
+      options_(other.options_),
+      local_path_(std::move(other.local_path_))
+    {
+      other.fd_ = -1;
+      other.local_path_.clear();
+    }
+
+    listener &listener::operator=(listener &&other) noexcept{
+      if(this == &other) return *this;
+
+      close();
+      fd_ = other.fd_;
+      options_ = other.options_;
+      local_path_ = std::move(other.local_path_);
+
+      other.fd_ = -1;
+      other.local_path_.clear();
+      return *this;
+    }
+
+    connection listener::accept(const int timeout_in_milliseconds,
+                                const std::atomic<bool> *cancel){
+      while(true){
+        const int ready = wait_for_socket(fd_, POLLIN, timeout_in_milliseconds, cancel);
+        if(ready < 0) return connection();
+        if(ready == 0){
+          errno = ETIMEDOUT;
+          return connection();
+        }
+
+        sockaddr_storage peer;
+        socklen_t peer_length = sizeof(peer);
+        const int fd = ::accept4(fd_, reinterpret_cast<sockaddr*>(&peer), &peer_length,
+                                 SOCK_CLOEXEC);
+        if(fd == -1){
+          // Another thread could have accepted it, or the client gave up before
+          if(errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK
+             || errno == ECONNABORTED)
+            continue;
+          return connection();
+        }
+
+        // Accepted sockets inherit most options, but not all of them in every kernel
+        apply_socket_options(fd, options_);
+        return connection(fd, reinterpret_cast<const sockaddr*>(&peer), peer_length);
+      }
+    }
+
+    bool listener::close(){
+      if(fd_ < 0){
+        errno = EBADF;
+        return false;
+      }
+
+      const bool closed{::close(fd_) == 0};
+      fd_ = -1;
+
+      // Nobody else could bind to the local socket's path while the file exists
+      if(!local_path_.empty()){
+        if(::unlink(local_path_.c_str()) == -1)
+          rr::perror("Local socket cannot be deleted");
+        local_path_.clear();
+      }
+      return closed;
+    }
+
+    int listener::fd() const{
+      return fd_;
+    }
+
+    bool listener::is_open() const{
+      return fd_ >= 0;
+    }
+
+    bool listener::open(const std::string &ip, const int port, const socket_options &options,
+                        const int backlog){
+      if(fd_ >= 0){
+        errno = EISCONN;
+        return false;
+      }
+
+      address_cache addresses;
+      int status;
+      const addrinfo *results = addresses.resolve(ip, port, SOCK_STREAM, AI_PASSIVE, 0, &status);
+      if(results == nullptr){
+        errno = EHOSTUNREACH;
+        return false;
+      }
+
+      // Binding to the first result that works
+      int error{0};
+      for(const addrinfo *current = results; current != nullptr; current = current->ai_next){
+        // Non-blocking, so accept() does not stall when another thread took the connection
+        const int fd = ::socket(current->ai_family,
+                                current->ai_socktype | SOCK_CLOEXEC | SOCK_NONBLOCK,
+                                current->ai_protocol);
+        if(fd == -1){
+          error = errno;
+          continue;
+        }
+
+        // Some options only work before binding, the failed ones are not fatal
+        apply_socket_options(fd, options);
+
+        // The file of a local socket outlives a crashed server
+        if(current->ai_family == AF_UNIX)
+          remove_stale_local_socket(current->ai_addr, current->ai_addrlen);
+
+        if(::bind(fd, current->ai_addr, current->ai_addrlen) == -1
+           || ::listen(fd, backlog) == -1){
+          error = errno;
+          ::close(fd);
+          continue;
+        }
+
+        const sockaddr_un *local = reinterpret_cast<const sockaddr_un*>(current->ai_addr);
+        if(current->ai_family == AF_UNIX && local->sun_path[0] != '\0')
+          local_path_ = local->sun_path;
+        fd_ = fd;
+        options_ = options;
+        return true;
+      }
+
+      errno = error;
+      return false;
+    }
+  } // namespace: network_communication
+} // namespace: ramrod
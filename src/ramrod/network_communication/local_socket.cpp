@@ -0,0 +1,53 @@
+#include "ramrod/network_communication/local_socket.h"
+
+#include <cerrno>                      // for errno, ECONNREFUSED
+#include <cstddef>                     // for offsetof
+#include <cstring>                     // for memcpy, memset
+#include <sys/stat.h>                  // for lstat, S_ISSOCK
+#include <unistd.h>                    // for close, unlink
+
+namespace ramrod {
+  namespace network_communication {
+    bool is_local_address(const std::string &host){
+      return host.compare(0, sizeof(local_prefix) - 1, local_prefix) == 0;
+    }
+
+    bool make_local_address(const std::string &host, sockaddr_un *address, socklen_t *length){
+      if(!is_local_address(host)) return false;
+
+      const std::string path{host.substr(sizeof(local_prefix) - 1)};
+      const bool abstract{!path.empty() && path[0] == '@'};
+      // A file's path needs its null character, an abstract name does not
+      if(path.empty() || path.size() + (abstract ? 0 : 1) > sizeof(address->sun_path))
+        return false;
+
+      std::memset(address, 0, sizeof(sockaddr_un));
+      address->sun_family = AF_UNIX;
+      std::memcpy(address->sun_path, path.data(), path.size());
+      if(abstract) address->sun_path[0] = '\0';
+
+      *length = static_cast<socklen_t>(offsetof(sockaddr_un, sun_path) + path.size()
+                                       + (abstract ? 0 : 1));
+      return true;
+    }
+
+    bool remove_stale_local_socket(const sockaddr *address, const socklen_t length){
+      const sockaddr_un *local = reinterpret_cast<const sockaddr_un*>(address);
+      if(address->sa_family != AF_UNIX || length <= offsetof(sockaddr_un, sun_path)
+         || local->sun_path[0] == '\0')
+        return false;
+
+      // Connecting to any other kind of file is refused too, it must never be deleted
+      struct stat status;
+      if(::lstat(local->sun_path, &status) == -1 || !S_ISSOCK(status.st_mode)) return false;
+
+      // Only a file without listener refuses the connection, a full one returns EAGAIN
+      const int probe = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0);
+      if(probe == -1) return false;
+      const bool refused{::connect(probe, address, length) == -1 && errno == ECONNREFUSED};
+      ::close(probe);
+
+      return refused && ::unlink(local->sun_path) == 0;
+    }
+  } // namespace: network_communication
+} // namespace: ramrod
@@ -0,0 +1,81 @@
+#include "ramrod/network_communication/message_buffer.h"
+
+#include <cstring>                     // for memcpy, memmove
+#include <netinet/in.h>                // for htonl, ntohl
+
+namespace ramrod {
+  namespace network_communication {
+    message_buffer::message_buffer(const std::size_t max_message_size) :
+      data_(),
+      head_{0},
+      tail_{0},
+      max_message_size_{max_message_size > 0 ? max_message_size : 1}
+    {}
+
+    void message_buffer::clear(){
+      head_ = 0;
+      tail_ = 0;
+    }
+
+    void message_buffer::commit(const std::size_t size){
+      tail_ += size;
+    }
+
+    std::size_t message_buffer::max_message_size(){
+      return max_message_size_;
+    }
+
+    bool message_buffer::max_message_size(const std::size_t new_max_message_size){
+      if(new_max_message_size == 0) return false;
+
+      max_message_size_ = new_max_message_size;
+      data_.clear();
+      data_.shrink_to_fit();
+      clear();
+      return true;
+    }
+
+    int message_buffer::next(const std::uint8_t **message, std::uint32_t *size){
+      const std::size_t buffered{tail_ - head_};
+      if(buffered < header_size) return 0;
+
+      std::uint32_t network_size;
+      std::memcpy(&network_size, data_.data() + head_, header_size);
+      const std::uint32_t message_size{::ntohl(network_size)};
+
+      if(message_size > max_message_size_) return -1;
+      if(buffered < header_size + message_size) return 0;
+
+      *message = data_.data() + head_ + header_size;
+      *size = message_size;
+      head_ += header_size + message_size;
+
+      // Everything was read, the next bytes can start again from the beginning
+      if(head_ == tail_) clear();
+      return 1;
+    }
+
+    std::size_t message_buffer::reserve(){
+      // Twice the biggest message, so one receive could bring several of them
+      if(data_.empty()) data_.resize(2 * (header_size + max_message_size_));
+
+      // Moves the incomplete message to the beginning only when the remaining space could
+      // not contain the biggest message, in this way the bytes are rarely moved
+      if(head_ > 0 && data_.size() - head_ < header_size + max_message_size_){
+        std::memmove(data_.data(), data_.data() + head_, tail_ - head_);
+        tail_ -= head_;
+        head_ = 0;
+      }
+      return data_.size() - tail_;
+    }
+
+    std::uint8_t *message_buffer::tail(){
+      return data_.data() + tail_;
+    }
+
+    void message_buffer::write_header(std::uint8_t *header, const std::uint32_t size){
+      const std::uint32_t network_size{::htonl(size)};
+      std::memcpy(header, &network_size, header_size);
+    }
+  } // namespace: network_communication
+} // namespace: ramrod
@@ -0,0 +1,131 @@
+#include "ramrod/network_communication/multicast.h"
+
+#include <arpa/inet.h>                 // for inet_pton
+#include <cerrno>                      // for errno, EINVAL, ENODEV
+#include <net/if.h>                    // for if_nametoindex
+#include <netinet/in.h>                // for ip_mreqn, ipv6_mreq, IN_MULTICAST, IPPROTO_IP
+
+#include "ramrod/console/perror.h"     // for perror, perror_stream
+
+namespace ramrod {
+  namespace network_communication {
+    namespace {
+      int family_of(const int fd){
+        int family{AF_UNSPEC};
+        socklen_t length{sizeof(family)};
+        if(::getsockopt(fd, SOL_SOCKET, SO_DOMAIN, &family, &length) == -1) return AF_UNSPEC;
+        return family;
+      }
+
+      // An interface is given by its IPv4 address or by its name, IPv6 only accepts names
+      bool find_interface(const std::string &interface, in_addr *address, unsigned int *index){
+        address->s_addr = htonl(INADDR_ANY);
+        *index = 0;
+        if(interface.empty()) return true;
+        if(::inet_pton(AF_INET, interface.c_str(), address) == 1) return true;
+
+        *index = ::if_nametoindex(interface.c_str());
+        if(*index == 0){
+          errno = ENODEV;
+          return false;
+        }
+        return true;
+      }
+
+      bool membership(const int fd, const std::string &group, const std::string &interface,
+                      const bool join){
+        in_addr interface_address;
+        unsigned int interface_index;
+        if(!find_interface(interface, &interface_address, &interface_index)) return false;
+
+        if(family_of(fd) == AF_INET6){
+          ipv6_mreq request{};
+          if(::inet_pton(AF_INET6, group.c_str(), &request.ipv6mr_multiaddr) != 1
+             || !IN6_IS_ADDR_MULTICAST(&request.ipv6mr_multiaddr)
+             || (interface_index == 0 && !interface.empty())){
+            errno = EINVAL;
+            return false;
+          }
+          request.ipv6mr_interface = interface_index;
+          return ::setsockopt(fd, IPPROTO_IPV6, join ? IPV6_JOIN_GROUP : IPV6_LEAVE_GROUP,
+                              &request, sizeof(request)) != -1;
+        }
+
+        ip_mreqn request{};
+        if(::inet_pton(AF_INET, group.c_str(), &request.imr_multiaddr) != 1
+           || !IN_MULTICAST(ntohl(request.imr_multiaddr.s_addr))){
+          errno = EINVAL;
+          return false;
+        }
+        request.imr_address = interface_address;
+        request.imr_ifindex = static_cast<int>(interface_index);
+        return ::setsockopt(fd, IPPROTO_IP, join ? IP_ADD_MEMBERSHIP : IP_DROP_MEMBERSHIP,
+                            &request, sizeof(request)) != -1;
+      }
+
+      bool apply(const int fd, const int level, const int name, const void *value,
+                 const socklen_t length, const char *description){
+        if(::setsockopt(fd, level, name, value, length) != -1) return true;
+
+        rr::perror(description);
+        return false;
+      }
+    } // namespace: anonymous
+
+    bool apply_multicast_options(const int fd, const multicast_options &options){
+      in_addr interface_address;
+      unsigned int interface_index;
+      const bool found{find_interface(options.interface, &interface_address, &interface_index)};
+      if(!found) rr::perror("Finding the multicast interface");
+
+      const int loopback{options.loopback ? 1 : 0};
+      bool applied{found};
+
+      if(family_of(fd) == AF_INET6){
+        applied &= apply(fd, IPPROTO_IPV6, IPV6_MULTICAST_HOPS, &options.ttl,
+                         sizeof(options.ttl), "Setting IPV6_MULTICAST_HOPS");
+        applied &= apply(fd, IPPROTO_IPV6, IPV6_MULTICAST_LOOP, &loopback, sizeof(loopback),
+                         "Setting IPV6_MULTICAST_LOOP");
+        if(found && interface_index > 0)
+          applied &= apply(fd, IPPROTO_IPV6, IPV6_MULTICAST_IF, &interface_index,
+                           sizeof(interface_index), "Setting IPV6_MULTICAST_IF");
+        return applied;
+      }
+
+      applied &= apply(fd, IPPROTO_IP, IP_MULTICAST_TTL, &options.ttl, sizeof(options.ttl),
+                       "Setting IP_MULTICAST_TTL");
+      applied &= apply(fd, IPPROTO_IP, IP_MULTICAST_LOOP, &loopback, sizeof(loopback),
+                       "Setting IP_MULTICAST_LOOP");
+      if(found && !options.interface.empty()){
+        ip_mreqn request{};
+        request.imr_address = interface_address;
+        request.imr_ifindex = static_cast<int>(interface_index);
+        applied &= apply(fd, IPPROTO_IP, IP_MULTICAST_IF, &request, sizeof(request),
+                         "Setting IP_MULTICAST_IF");
+      }
+      return applied;
+    }
+
+    bool is_multicast(const sockaddr_storage &address){
+      if(address.ss_family == AF_INET){
+        const sockaddr_in &ipv4 = reinterpret_cast<const sockaddr_in&>(address);
+        return IN_MULTICAST(ntohl(ipv4.sin_addr.s_addr));
+      }
+      if(address.ss_family == AF_INET6){
+        const sockaddr_in6 &ipv6 = reinterpret_cast<const sockaddr_in6&>(address);
+        return IN6_IS_ADDR_MULTICAST(&ipv6.sin6_addr);
+      }
+      return false;
+    }
+
+    bool join_multicast_group(const int fd, const std::string &group,
+                              const std::string &interface){
+      return membership(fd, group, interface, true);
+    }
+
+    bool leave_multicast_group(const int fd, const std::string &group,
+                               const std::string &interface){
+      return membership(fd, group, interface, false);
+    }
+  } // namespace: network_communication
+} // namespace: ramrod
@@ -0,0 +1,82 @@
+#include "ramrod/network_communication/operation.h"
+
+#include <cerrno>                      // for errno
+#include <chrono>                      // for milliseconds
+
+namespace ramrod {
+  namespace network_communication {
+    operation::operation() :
+      state_(),
+      result_()
+    {}
+
+    operation::operation(const completion &on_complete) :
+      state_(std::make_shared<state>()),
+      result_()
+    {
+      state_->cancelled.store(false);
+      state_->finished.store(false);
+      state_->progress.store(0);
+      state_->error = 0;
+      state_->on_complete = on_complete;
+      result_ = state_->promise.get_future().share();
+    }
+
+    bool operation::cancel(){
+      if(!state_) return false;
+
+      state_->cancelled.store(true);
+      return !state_->finished.load();
+    }
+
+    const std::atomic<bool> *operation::cancellation() const{
+      return state_ ? &state_->cancelled : nullptr;
+    }
+
+    int operation::error() const{
+      // The promise synchronizes the error with the threads that waited for the result
+      return is_ready() ? state_->error : 0;
+    }
+
+    void operation::finish(const ssize_t result){
+      if(!state_ || state_->finished.exchange(true)) return;
+
+      state_->error = result < 0 ? errno : 0;
+      // Completion first, so the function already returned when get() wakes up
+      if(state_->on_complete) state_->on_complete(result);
+      state_->promise.set_value(result);
+    }
+
+    ssize_t operation::get() const{
+      if(!result_.valid()) return -1;
+      return result_.get();
+    }
+
+    bool operation::is_cancelled() const{
+      return state_ && state_->cancelled.load();
+    }
+
+    bool operation::is_ready() const{
+      return result_.valid() &&
+             result_.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    }
+
+    bool operation::is_valid() const{
+      return static_cast<bool>(state_);
+    }
+
+    std::size_t operation::progress() const{
+      return state_ ? state_->progress.load(std::memory_order_relaxed) : 0;
+    }
+
+    void operation::progress(const std::size_t transferred){
+      if(state_) state_->progress.store(transferred, std::memory_order_relaxed);
+    }
+
+    bool operation::wait_for(const int timeout_in_milliseconds) const{
+      return result_.valid() &&
+             result_.wait_for(std::chrono::milliseconds(timeout_in_milliseconds))
+               == std::future_status::ready;
+    }
+  } // namespace: network_communication
+} // namespace: ramrod
@@ -0,0 +1,198 @@
+#include "ramrod/network_communication/peer_table.h"
+
+#include <cstring>                     // for memcmp, memcpy, memset
+#include <netinet/in.h>                // for sockaddr_in, sockaddr_in6
+
+namespace ramrod {
+  namespace network_communication {
+    namespace {
+      constexpr std::size_t initial_slots{16};
+
+      // Copies only the fields that identify a peer, so equal addresses have equal bytes
+      bool normalize(const sockaddr_storage &address, const socklen_t length,
+                     sockaddr_storage *normalized, socklen_t *normalized_length){
+        std::memset(normalized, 0, sizeof(sockaddr_storage));
+
+        if(address.ss_family == AF_INET && length >= sizeof(sockaddr_in)){
+          const sockaddr_in &from = reinterpret_cast<const sockaddr_in&>(address);
+          sockaddr_in &to = reinterpret_cast<sockaddr_in&>(*normalized);
+          to.sin_family = AF_INET;
+          to.sin_port = from.sin_port;
+          to.sin_addr = from.sin_addr;
+          *normalized_length = sizeof(sockaddr_in);
+          return true;
+        }
+
+        if(address.ss_family == AF_INET6 && length >= sizeof(sockaddr_in6)){
+          const sockaddr_in6 &from = reinterpret_cast<const sockaddr_in6&>(address);
+          sockaddr_in6 &to = reinterpret_cast<sockaddr_in6&>(*normalized);
+          to.sin6_family = AF_INET6;
+          to.sin6_port = from.sin6_port;
+          to.sin6_addr = from.sin6_addr;
+          to.sin6_scope_id = from.sin6_scope_id;
+          *normalized_length = sizeof(sockaddr_in6);
+          return true;
+        }
+        return false;
+      }
+
+      // FNV-1a, the addresses are short and this is enough to spread them
+      std::uint32_t hash_of(const sockaddr_storage &normalized, const socklen_t length){
+        const unsigned char *bytes = reinterpret_cast<const unsigned char*>(&normalized);
+        std::uint32_t hash{2166136261u};
+        for(socklen_t i{0}; i < length; ++i){
+          hash ^= bytes[i];
+          hash *= 16777619u;
+        }
+        return hash;
+      }
+    } // namespace: anonymous
+
+    peer_table::peer_table(const std::size_t max_peers) :
+      slots_(initial_slots, slot{0, -1}),
+      peers_(),
+      free_(),
+      size_{0},
+      max_peers_{max_peers > 0 ? max_peers : 1}
+    {}
+
+    int peer_table::add(const sockaddr_storage &address, const socklen_t length){
+      sockaddr_storage normalized;
+      socklen_t normalized_length;
+      if(!normalize(address, length, &normalized, &normalized_length)) return -1;
+
+      const std::uint32_t hash{hash_of(normalized, normalized_length)};
+      std::size_t index{locate(normalized, normalized_length, hash)};
+      if(slots_[index].peer >= 0) return slots_[index].peer;
+      if(size_ >= max_peers_) return -1;
+
+      // Keeping the load factor under one half, so the probing sequences stay short
+      if(2 * (size_ + 1) > slots_.size()){
+        grow();
+        index = locate(normalized, normalized_length, hash);
+      }
+
+      int peer;
+      if(free_.empty()){
+        peer = static_cast<int>(peers_.size());
+        peers_.push_back(entry());
+      }else{
+        peer = free_.back();
+        free_.pop_back();
+      }
+
+      entry &current = peers_[static_cast<std::size_t>(peer)];
+      current.address = normalized;
+      current.length = normalized_length;
+      current.hash = hash;
+      current.used = true;
+      slots_[index] = slot{hash, peer};
+      ++size_;
+      return peer;
+    }
+
+    void peer_table::clear(){
+      slots_.assign(initial_slots, slot{0, -1});
+      peers_.clear();
+      free_.clear();
+      size_ = 0;
+    }
+
+    int peer_table::find(const sockaddr_storage &address, const socklen_t length) const{
+      sockaddr_storage normalized;
+      socklen_t normalized_length;
+      if(!normalize(address, length, &normalized, &normalized_length)) return -1;
+
+      const std::uint32_t hash{hash_of(normalized, normalized_length)};
+      return slots_[locate(normalized, normalized_length, hash)].peer;
+    }
+
+    bool peer_table::get(const int peer, sockaddr_storage *address, socklen_t *length) const{
+      if(peer < 0 || static_cast<std::size_t>(peer) >= peers_.size()) return false;
+
+      const entry &current = peers_[static_cast<std::size_t>(peer)];
+      if(!current.used) return false;
+
+      *address = current.address;
+      *length = current.length;
+      return true;
+    }
+
+    std::size_t peer_table::max_peers() const{
+      return max_peers_;
+    }
+
+    bool peer_table::max_peers(const std::size_t new_max_peers){
+      if(new_max_peers == 0) return false;
+      max_peers_ = new_max_peers;
+      return true;
+    }
+
+    bool peer_table::remove(const int peer){
+      if(peer < 0 || static_cast<std::size_t>(peer) >= peers_.size()) return false;
+
+      entry &current = peers_[static_cast<std::size_t>(peer)];
+      if(!current.used) return false;
+
+      const std::size_t mask{slots_.size() - 1};
+      std::size_t hole{locate(current.address, current.length, current.hash)};
+      slots_[hole].peer = -1;
+
+      // Backward-shift deletion, the following slots of the probing sequence are moved
+      // into the hole so no tombstones are needed
+      for(std::size_t next{(hole + 1) & mask}; slots_[next].peer >= 0; next = (next + 1) & mask){
+        const std::size_t home{slots_[next].hash & mask};
+        const bool between{hole <= next ? hole < home && home <= next
+                                        : hole < home || home <= next};
+        if(between) continue;
+
+        slots_[hole] = slots_[next];
+        slots_[next].peer = -1;
+        hole = next;
+      }
+
+      current.used = false;
+      free_.push_back(peer);
+      --size_;
+      return true;
+    }
+
+    std::size_t peer_table::size() const{
+      return size_;
+    }
+
+    // :::::::::::::::::::::::::::::::::::: PRIVATE FUNCTIONS ::::::::::::::::::::::::::::::::::::
+
+    void peer_table::grow(){
+      std::vector<slot> old(slots_.size() * 2, slot{0, -1});
+      old.swap(slots_);
+
+      const std::size_t mask{slots_.size() - 1};
+      for(const slot &current : old){
+        if(current.peer < 0) continue;
+
+        std::size_t index{current.hash & mask};
+        while(slots_[index].peer >= 0) index = (index + 1) & mask;
+        slots_[index] = current;
+      }
+    }
+
+    std::size_t peer_table::locate(const sockaddr_storage &address, const socklen_t length,
+                                   const std::uint32_t hash) const{
+      const std::size_t mask{slots_.size() - 1};
+      std::size_t index{hash & mask};
+
+      // The table is never full, so an empty slot always ends the search
+      while(slots_[index].peer >= 0){
+        const slot &current = slots_[index];
+        if(current.hash == hash){
+          const entry &candidate = peers_[static_cast<std::size_t>(current.peer)];
+          if(candidate.length == length && std::memcmp(&candidate.address, &address, length) == 0)
+            return index;
+        }
+        index = (index + 1) & mask;
+      }
+      return index;
+    }
+  } // namespace: network_communication
+} // namespace: ramrod
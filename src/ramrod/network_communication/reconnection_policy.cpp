@@ -0,0 +1,43 @@
+#include "ramrod/network_communication/reconnection_policy.h"
+
+#include <algorithm>                   // for min
+#include <cmath>                       // for pow
+#include <random>                      // for minstd_rand, random_device, uniform_real_distribution
+#include <thread>                      // for sleep_for
+
+namespace ramrod {
+  namespace network_communication {
+    std::chrono::milliseconds backoff_delay(const reconnection_policy &policy,
+                                            const std::uint32_t intent){
+      // Every thread has its own generator, seeded differently in every device
+      thread_local std::minstd_rand generator{std::random_device{}()};
+
+      const double exponent{intent > 0 ? static_cast<double>(intent - 1) : 0.0};
+      const double delay{std::min(static_cast<double>(policy.maximum_delay),
+                                  policy.initial_delay * std::pow(policy.multiplier, exponent))};
+
+      std::uniform_real_distribution<double> random(0.0, policy.jitter);
+      const double waiting{delay * (1.0 - random(generator))};
+      return std::chrono::milliseconds(static_cast<long>(waiting));
+    }
+
+    bool is_valid(const reconnection_policy &policy){
+      return policy.initial_delay >= 0 && policy.maximum_delay >= policy.initial_delay
+             && policy.multiplier >= 1.0 && policy.jitter >= 0.0 && policy.jitter <= 1.0;
+    }
+
+    bool wait_to_reconnect(const std::chrono::milliseconds &delay,
+                           const std::atomic<bool> &cancel){
+      constexpr std::chrono::milliseconds slice(50);
+      const auto deadline = std::chrono::steady_clock::now() + delay;
+
+      while(!cancel.load()){
+        const auto now = std::chrono::steady_clock::now();
+        if(now >= deadline) return true;
+        std::this_thread::sleep_for(std::min<std::chrono::steady_clock::duration>(slice,
+                                                                                 deadline - now));
+      }
+      return false;
+    }
+  } // namespace: network_communication
+} // namespace: ramrod
@@ -0,0 +1,490 @@
+#include "ramrod/network_communication/reliable_udp.h"
+
+#include <cerrno>                      // for errno, EINVAL, EMSGSIZE, ENOBUFS, EPR...
+#include <chrono>                      // for steady_clock, duration_cast, nanoseconds
+#include <cstring>                     // for memcpy
+#include <utility>                     // for move, swap
+
+#include "ramrod/console/perror.h"     // for perror, perror_stream
+
+namespace ramrod {
+  namespace network_communication {
+    namespace {
+      constexpr std::uint8_t acknowledgement_type{0};
+      constexpr std::uint8_t version{1};
+      constexpr std::uint64_t nanoseconds_per_millisecond{1000000};
+      // Datagrams acknowledged after a missing one that make it lost without waiting
+      constexpr std::size_t duplicate_threshold{3};
+
+      std::uint64_t now(){
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                 std::chrono::steady_clock::now().time_since_epoch()).count());
+      }
+
+      // Sequence numbers wrap around, so they are compared by their distance
+      bool before(const std::uint32_t first, const std::uint32_t second){
+        return static_cast<std::int32_t>(first - second) < 0;
+      }
+
+      void write_32(std::uint8_t *destination, const std::uint32_t value){
+        destination[0] = static_cast<std::uint8_t>(value >> 24);
+        destination[1] = static_cast<std::uint8_t>(value >> 16);
+        destination[2] = static_cast<std::uint8_t>(value >> 8);
+        destination[3] = static_cast<std::uint8_t>(value);
+      }
+
+      std::uint32_t read_32(const std::uint8_t *source){
+        return static_cast<std::uint32_t>(source[0]) << 24
+               | static_cast<std::uint32_t>(source[1]) << 16
+               | static_cast<std::uint32_t>(source[2]) << 8
+               | static_cast<std::uint32_t>(source[3]);
+      }
+
+      int milliseconds_until(const std::uint64_t time, const std::uint64_t current){
+        if(time <= current) return 0;
+        // Rounded up, so the timer is already expired when the caller wakes up
+        return static_cast<int>((time - current + nanoseconds_per_millisecond - 1)
+                                / nanoseconds_per_millisecond);
+      }
+    } // namespace: anonymous
+
+    reliable_session::reliable_session(const reliable_options &options) :
+      mutex_(),
+      options_(options),
+      failed_{false},
+      next_sequence_{0},
+      next_sequenced_{0},
+      in_flight_(),
+      reliable_queue_(),
+      sequenced_queue_(),
+      sequenced_turn_{false},
+      queued_bytes_{0},
+      window_{options.initial_window},
+      threshold_{options.max_window},
+      acknowledged_in_window_{0},
+      recovery_{0},
+      recovering_{false},
+      round_trip_{0},
+      variation_{0},
+      timeout_{static_cast<std::uint64_t>(options.initial_timeout) * nanoseconds_per_millisecond},
+      next_send_{0},
+      retransmissions_{0},
+      expected_{0},
+      last_sequenced_{0},
+      any_sequenced_{false},
+      out_of_order_(),
+      ready_(),
+      acknowledge_{false}
+    {}
+
+    int reliable_session::deliver(const reliable_handler &handler){
+      std::deque<incoming> messages;
+      {
+        std::lock_guard<std::mutex> guard(mutex_);
+        std::swap(messages, ready_);
+      }
+
+      for(const incoming &message : messages)
+        if(handler) handler(message.data.data(), static_cast<std::uint32_t>(message.data.size()),
+                            message.mode);
+      return static_cast<int>(messages.size());
+    }
+
+    bool reliable_session::failed() const{
+      std::lock_guard<std::mutex> guard(mutex_);
+      return failed_;
+    }
+
+    std::size_t reliable_session::next(std::uint8_t *packet, const std::size_t capacity){
+      std::lock_guard<std::mutex> guard(mutex_);
+      if(failed_) return 0;
+      const std::uint64_t current{now()};
+
+      // Every datagram without acknowledgement for a whole timeout is lost
+      bool timed_out{false};
+      for(outgoing &pending : in_flight_){
+        if(pending.acknowledged || pending.lost || current - pending.sent_at < timeout_) continue;
+        pending.lost = true;
+        timed_out = true;
+      }
+      if(timed_out){
+        // The path is congested, it starts again slowly and waits more for the next one
+        threshold_ = window_ / 2 > 2 ? window_ / 2 : 2;
+        window_ = options_.initial_window;
+        acknowledged_in_window_ = 0;
+        recovering_ = true;
+        recovery_ = next_sequence_;
+        const std::uint64_t maximum{static_cast<std::uint64_t>(options_.max_timeout)
+                                    * nanoseconds_per_millisecond};
+        timeout_ = timeout_ * 2 < maximum ? timeout_ * 2 : maximum;
+      }
+
+      const bool allowed{can_send(current)};
+      // Retransmissions go before the new messages, they hold the delivery of the others
+      for(outgoing &pending : in_flight_){
+        if(pending.acknowledged || !pending.lost || !allowed) continue;
+        if(pending.transmissions > options_.max_retransmissions
+           || pending.packet.size() > capacity){
+          failed_ = true;
+          return 0;
+        }
+
+        std::memcpy(packet, pending.packet.data(), pending.packet.size());
+        write_header(packet, static_cast<std::uint8_t>(delivery::reliable), pending.sequence);
+        pending.sent_at = current;
+        pending.lost = false;
+        ++pending.transmissions;
+        ++retransmissions_;
+        sent(current);
+        return pending.packet.size();
+      }
+
+      // Sequenced messages are never retransmitted, so they do not use the window, and
+      // both kinds take turns so a steady stream of one does not starve the other
+      const bool reliable_ready{!reliable_queue_.empty() && in_flight_.size() < window_};
+      const bool reliable{sequenced_queue_.empty() || (reliable_ready && !sequenced_turn_)};
+      std::deque<std::vector<std::uint8_t>> &queue = reliable ? reliable_queue_
+                                                              : sequenced_queue_;
+      if(!queue.empty() && allowed && (!reliable || reliable_ready)
+         && reliable_header_size + queue.front().size() <= capacity){
+        const std::vector<std::uint8_t> &message = queue.front();
+        const std::size_t size{reliable_header_size + message.size()};
+        const std::uint32_t sequence{reliable ? next_sequence_++ : next_sequenced_++};
+        write_header(packet, static_cast<std::uint8_t>(reliable ? delivery::reliable
+                                                                : delivery::sequenced),
+                     sequence);
+        if(!message.empty())
+          std::memcpy(packet + reliable_header_size, message.data(), message.size());
+        if(reliable)
+          in_flight_.push_back(outgoing{sequence,
+                                        std::vector<std::uint8_t>(packet, packet + size),
+                                        current, 1, false, false});
+
+        queued_bytes_ -= message.size();
+        queue.pop_front();
+        sequenced_turn_ = reliable;
+        sent(current);
+        return size;
+      }
+
+      // Nothing to carry the acknowledgement, it goes alone
+      if(acknowledge_ && capacity >= reliable_header_size){
+        write_header(packet, acknowledgement_type, 0);
+        return reliable_header_size;
+      }
+      return 0;
+    }
+
+    reliable_options reliable_session::options() const{
+      std::lock_guard<std::mutex> guard(mutex_);
+      return options_;
+    }
+
+    bool reliable_session::options(const reliable_options &new_options){
+      if(new_options.max_payload == 0 || new_options.initial_window == 0
+         || new_options.initial_window > new_options.max_window
+         || new_options.min_timeout <= 0 || new_options.min_timeout > new_options.max_timeout){
+        errno = EINVAL;
+        return false;
+      }
+
+      std::lock_guard<std::mutex> guard(mutex_);
+      options_ = new_options;
+      clear();
+      return true;
+    }
+
+    bool reliable_session::receive(const std::uint8_t *packet, const std::size_t size){
+      if(size < reliable_header_size || packet[1] != version
+         || packet[0] > static_cast<std::uint8_t>(delivery::sequenced)){
+        errno = EPROTO;
+        return false;
+      }
+
+      const std::uint8_t type{packet[0]};
+      const std::uint32_t sequence{read_32(packet + 2)};
+      const std::uint8_t *data{packet + reliable_header_size};
+      std::vector<std::uint8_t> message(data, packet + size);
+
+      std::lock_guard<std::mutex> guard(mutex_);
+      acknowledge(read_32(packet + 6), read_32(packet + 10), now());
+
+      if(type == static_cast<std::uint8_t>(delivery::reliable)){
+        // Also the duplicates, their acknowledgement was probably lost
+        acknowledge_ = true;
+        if(before(sequence, expected_) || sequence - expected_ >= options_.max_window)
+          return true;
+
+        if(sequence != expected_){
+          out_of_order_.emplace(sequence, std::move(message));
+          return true;
+        }
+
+        ready_.push_back(incoming{delivery::reliable, std::move(message)});
+        ++expected_;
+        // The missing datagram could release the ones that arrived after it
+        for(auto found = out_of_order_.find(expected_); found != out_of_order_.end();
+            found = out_of_order_.find(expected_)){
+          ready_.push_back(incoming{delivery::reliable, std::move(found->second)});
+          out_of_order_.erase(found);
+          ++expected_;
+        }
+      }else if(type == static_cast<std::uint8_t>(delivery::sequenced)){
+        // An older message arrived late, a newer one was already delivered
+        if(any_sequenced_ && !before(last_sequenced_, sequence)) return true;
+        any_sequenced_ = true;
+        last_sequenced_ = sequence;
+        ready_.push_back(incoming{delivery::sequenced, std::move(message)});
+      }
+      return true;
+    }
+
+    void reliable_session::reset(){
+      std::lock_guard<std::mutex> guard(mutex_);
+      clear();
+    }
+
+    bool reliable_session::send(const void *buffer, const std::size_t size, const delivery mode){
+      std::lock_guard<std::mutex> guard(mutex_);
+      if(failed_){
+        errno = ETIMEDOUT;
+        return false;
+      }
+      if(size > options_.max_payload){
+        errno = EMSGSIZE;
+        return false;
+      }
+      if(queued_bytes_ + size > options_.max_queued_bytes){
+        errno = ENOBUFS;
+        return false;
+      }
+
+      const std::uint8_t *data{static_cast<const std::uint8_t*>(buffer)};
+      std::deque<std::vector<std::uint8_t>> &queue = mode == delivery::reliable
+                                                     ? reliable_queue_ : sequenced_queue_;
+      queue.emplace_back(data, data + size);
+      queued_bytes_ += size;
+      return true;
+    }
+
+    reliable_statistics reliable_session::statistics() const{
+      std::lock_guard<std::mutex> guard(mutex_);
+      reliable_statistics result;
+      result.window = window_;
+      for(const outgoing &pending : in_flight_)
+        if(!pending.acknowledged) ++result.in_flight;
+      result.queued_bytes = queued_bytes_;
+      result.retransmissions = retransmissions_;
+      result.round_trip = round_trip_ / 1000;
+      result.timeout = timeout_ / 1000;
+      return result;
+    }
+
+    int reliable_session::wait_time() const{
+      std::lock_guard<std::mutex> guard(mutex_);
+      if(failed_) return -1;
+      if(acknowledge_) return 0;
+      const std::uint64_t current{now()};
+
+      bool sendable{false};
+      int waiting{-1};
+      for(const outgoing &pending : in_flight_){
+        if(pending.acknowledged) continue;
+        if(pending.lost){
+          sendable = true;
+          continue;
+        }
+        const int expiration{milliseconds_until(pending.sent_at + timeout_, current)};
+        if(waiting < 0 || expiration < waiting) waiting = expiration;
+      }
+      if(!sequenced_queue_.empty() || (!reliable_queue_.empty() && in_flight_.size() < window_))
+        sendable = true;
+
+      // Only the pacing delays what could be sent
+      if(sendable){
+        const int pacing{can_send(current) ? 0 : milliseconds_until(next_send_, current)};
+        if(waiting < 0 || pacing < waiting) waiting = pacing;
+      }
+      return waiting;
+    }
+
+    // :::::::::::::::::::::::::::::::::::: PRIVATE FUNCTIONS ::::::::::::::::::::::::::::::::::::
+
+    void reliable_session::acknowledge(const std::uint32_t cumulative,
+                                       const std::uint32_t selective, const std::uint64_t current){
+      for(outgoing &pending : in_flight_){
+        if(pending.acknowledged) continue;
+        const std::uint32_t offset{pending.sequence - cumulative - 1};
+        if(!before(pending.sequence, cumulative)
+           && (pending.sequence == cumulative || offset >= 32 || !((selective >> offset) & 1)))
+          continue;
+
+        pending.acknowledged = true;
+        // Retransmitted datagrams do not tell which transmission was acknowledged (Karn)
+        if(pending.transmissions == 1) measure(current - pending.sent_at);
+
+        // Slow start doubles the window every round trip, then it grows by one
+        if(window_ < threshold_) ++window_;
+        else if(++acknowledged_in_window_ >= window_){
+          ++window_;
+          acknowledged_in_window_ = 0;
+        }
+        if(window_ > options_.max_window) window_ = options_.max_window;
+      }
+
+      // A datagram is lost when enough later ones were acknowledged
+      bool lost{false};
+      std::size_t acknowledged_after{0};
+      for(auto pending = in_flight_.rbegin(); pending != in_flight_.rend(); ++pending){
+        if(pending->acknowledged){
+          ++acknowledged_after;
+          continue;
+        }
+        if(acknowledged_after >= duplicate_threshold && !pending->lost
+           && pending->transmissions == 1){
+          pending->lost = true;
+          lost = true;
+        }
+      }
+      if(lost && !recovering_){
+        threshold_ = window_ / 2 > 2 ? window_ / 2 : 2;
+        window_ = threshold_;
+        acknowledged_in_window_ = 0;
+        recovering_ = true;
+        recovery_ = next_sequence_;
+      }
+
+      while(!in_flight_.empty() && in_flight_.front().acknowledged) in_flight_.pop_front();
+      if(recovering_ && (in_flight_.empty() || !before(in_flight_.front().sequence, recovery_)))
+        recovering_ = false;
+    }
+
+    bool reliable_session::can_send(const std::uint64_t current) const{
+      return !options_.pacing || current >= next_send_;
+    }
+
+    void reliable_session::clear(){
+      failed_ = false;
+      next_sequence_ = 0;
+      next_sequenced_ = 0;
+      in_flight_.clear();
+      reliable_queue_.clear();
+      sequenced_queue_.clear();
+      sequenced_turn_ = false;
+      queued_bytes_ = 0;
+      window_ = options_.initial_window;
+      threshold_ = options_.max_window;
+      acknowledged_in_window_ = 0;
+      recovery_ = 0;
+      recovering_ = false;
+      round_trip_ = 0;
+      variation_ = 0;
+      timeout_ = static_cast<std::uint64_t>(options_.initial_timeout) * nanoseconds_per_millisecond;
+      next_send_ = 0;
+      retransmissions_ = 0;
+      expected_ = 0;
+      last_sequenced_ = 0;
+      any_sequenced_ = false;
+      out_of_order_.clear();
+      ready_.clear();
+      acknowledge_ = false;
+    }
+
+    void reliable_session::measure(const std::uint64_t sample){
+      // RFC 6298, the first sample sets the variation to half of it
+      if(round_trip_ == 0){
+        round_trip_ = sample > 0 ? sample : 1;
+        variation_ = sample / 2;
+      }else{
+        const std::uint64_t difference{round_trip_ > sample ? round_trip_ - sample
+                                                            : sample - round_trip_};
+        variation_ = (3 * variation_ + difference) / 4;
+        round_trip_ = (7 * round_trip_ + sample) / 8;
+      }
+
+      const std::uint64_t minimum{static_cast<std::uint64_t>(options_.min_timeout)
+                                  * nanoseconds_per_millisecond};
+      const std::uint64_t maximum{static_cast<std::uint64_t>(options_.max_timeout)
+                                  * nanoseconds_per_millisecond};
+      const std::uint64_t spread{4 * variation_ > nanoseconds_per_millisecond
+                                 ? 4 * variation_ : nanoseconds_per_millisecond};
+      timeout_ = round_trip_ + spread;
+      if(timeout_ < minimum) timeout_ = minimum;
+      if(timeout_ > maximum) timeout_ = maximum;
+    }
+
+    void reliable_session::sent(const std::uint64_t current){
+      // Every acknowledgement travels with the data, there is no need to send it alone
+      acknowledge_ = false;
+      if(options_.pacing && round_trip_ > 0) next_send_ = current + round_trip_ / window_;
+    }
+
+    void reliable_session::write_header(std::uint8_t *packet, const std::uint8_t type,
+                                        const std::uint32_t sequence){
+      packet[0] = type;
+      packet[1] = version;
+      write_32(packet + 2, sequence);
+      write_32(packet + 6, expected_);
+
+      std::uint32_t selective{0};
+      for(const auto &received : out_of_order_){
+        const std::uint32_t offset{received.first - expected_ - 1};
+        if(offset < 32) selective |= 1u << offset;
+      }
+      write_32(packet + 10, selective);
+      acknowledge_ = false;
+    }
+
+    // :::::::::::::::::::::::::::::::::::: OUTTER FUNCTIONS :::::::::::::::::::::::::::::::::::
+
+    void send_reliable_batches(reliable_session *session, std::vector<std::uint8_t> *buffer,
+                               const datagram_batch &send){
+      const std::size_t capacity{session->options().max_payload + reliable_header_size};
+      if(buffer->size() < reliable_batch * capacity)
+        buffer->resize(reliable_batch * capacity);
+
+      datagram datagrams[reliable_batch]{};
+      std::size_t count;
+      // Everything allowed by the window and the pacing, in batches of one system call
+      do{
+        count = 0;
+        while(count < reliable_batch){
+          std::uint8_t *packet{buffer->data() + count * capacity};
+          const std::size_t size{session->next(packet, capacity)};
+          if(size == 0) break;
+          datagrams[count].buffer = packet;
+          datagrams[count].size = size;
+          ++count;
+        }
+        // A datagram that could not be sent is lost, its timer will send it again
+        if(count > 0 && send(datagrams, count) < 0){
+#ifdef VERBOSE
+          rr::perror("Sending reliable datagrams");
+#endif
+        }
+      }while(count == reliable_batch);
+    }
+
+    bool receive_reliable_batch(reliable_session *session, std::vector<std::uint8_t> *buffer,
+                                const datagram_batch &receive){
+      const std::size_t capacity{session->options().max_payload + reliable_header_size};
+      if(buffer->size() < reliable_batch * capacity)
+        buffer->resize(reliable_batch * capacity);
+
+      datagram datagrams[reliable_batch]{};
+      for(std::size_t i{0}; i < reliable_batch; ++i){
+        datagrams[i].buffer = buffer->data() + i * capacity;
+        datagrams[i].size = capacity;
+      }
+
+      const int received = receive(datagrams, reliable_batch);
+      if(received < 0) return false;
+      // The datagrams that do not belong to a session are ignored
+      for(int i{0}; i < received; ++i)
+        if(!datagrams[i].truncated)
+          session->receive(static_cast<const std::uint8_t*>(datagrams[i].buffer),
+                           datagrams[i].length);
+      return true;
+    }
+  } // namespace: network_communication
+} // namespace: ramrod
@@ -0,0 +1,218 @@
+#include "ramrod/network_communication/send_queue.h"
+
+#include <cerrno>                      // for errno, EINVAL, ENOBUFS, ENOMEM
+#include <cstdint>                     // for uint8_t
+#include <cstring>                     // for memcpy
+#include <new>                         // for operator new, nothrow
+
+namespace ramrod {
+  namespace network_communication {
+    namespace {
+      // The bytes of a message are stored just after its node
+      template<typename Node>
+      std::uint8_t *message_data(Node *message){
+        return reinterpret_cast<std::uint8_t*>(message + 1);
+      }
+    } // namespace: anonymous
+
+    send_queue::send_queue(const std::size_t max_bytes) :
+      head_{&stub_},
+      tail_{&stub_},
+      stub_(),
+      taken_(),
+      bytes_{0},
+      max_bytes_{max_bytes},
+      writing_{false},
+      high_watermark_{0},
+      low_watermark_{0},
+      saturated_{false},
+      transition_mutex_(),
+      handler_mutex_(),
+      handler_()
+    {
+      stub_.next.store(nullptr, std::memory_order_relaxed);
+      stub_.size = 0;
+      taken_.reserve(max_batch);
+    }
+
+    send_queue::~send_queue(){
+      // The owner of the handler could be already destroyed
+      {
+        std::lock_guard<std::mutex> guard(handler_mutex_);
+        handler_ = nullptr;
+      }
+      release();
+      while(node *message = pop()){
+        message->~node();
+        ::operator delete(message);
+      }
+    }
+
+    bool send_queue::add(const void *header, const std::size_t header_size,
+                         const void *buffer, const std::size_t size, bool *start){
+      *start = false;
+      const std::size_t total{header_size + size};
+
+      // Reserving the bytes first, so several producers cannot exceed the limit together
+      const std::size_t queued{bytes_.fetch_add(total) + total};
+      if(queued > max_bytes_.load(std::memory_order_relaxed)){
+        bytes_.fetch_sub(total);
+        errno = ENOBUFS;
+        return false;
+      }
+
+      void *memory{::operator new(sizeof(node) + total, std::nothrow)};
+      if(memory == nullptr){
+        bytes_.fetch_sub(total);
+        errno = ENOMEM;
+        return false;
+      }
+
+      // Before linking the node, so the writer cannot release it before the flag is set
+      const std::size_t high{high_watermark_.load(std::memory_order_relaxed)};
+      if(high > 0 && queued >= high && !saturated_.load()) transition(true);
+
+      node *message{new(memory) node()};
+      message->size = total;
+      if(header_size > 0) std::memcpy(message_data(message), header, header_size);
+      if(size > 0) std::memcpy(message_data(message) + header_size, buffer, size);
+
+      push(message);
+      // Only the producer that changes the flag starts the writer
+      *start = !writing_.exchange(true);
+      return true;
+    }
+
+    std::size_t send_queue::bytes() const{
+      return bytes_.load(std::memory_order_relaxed);
+    }
+
+    bool send_queue::keep_writing(){
+      if(tail_ != &stub_ || head_.load() != &stub_) return true;
+
+      writing_.store(false);
+      // A producer could have added its node before the flag was cleared, then it did not
+      // start a writer and this one must continue, unless a new writer was already started
+      if(tail_ == &stub_ && head_.load() == &stub_) return false;
+      return !writing_.exchange(true);
+    }
+
+    std::size_t send_queue::max_bytes() const{
+      return max_bytes_.load(std::memory_order_relaxed);
+    }
+
+    void send_queue::max_bytes(const std::size_t new_max_bytes){
+      max_bytes_.store(new_max_bytes, std::memory_order_relaxed);
+    }
+
+    void send_queue::release(){
+      for(node *message : taken_){
+        bytes_.fetch_sub(message->size, std::memory_order_relaxed);
+        message->~node();
+        ::operator delete(message);
+      }
+      taken_.clear();
+
+      if(saturated_.load() && bytes_.load() <= low_watermark_.load(std::memory_order_relaxed))
+        transition(false);
+    }
+
+    bool send_queue::saturated() const{
+      return saturated_.load(std::memory_order_relaxed);
+    }
+
+    std::size_t send_queue::take(iovec *parts){
+      std::size_t count{0};
+      while(count < max_batch){
+        node *message{pop()};
+        if(message == nullptr) break;
+
+        taken_.push_back(message);
+        parts[count++] = iovec{message_data(message), message->size};
+      }
+      return count;
+    }
+
+    bool send_queue::watermarks(const std::size_t high, const std::size_t low,
+                                const watermark_handler &handler){
+      if(high > 0 && low >= high){
+        errno = EINVAL;
+        return false;
+      }
+
+      std::lock_guard<std::mutex> guard(handler_mutex_);
+      handler_ = handler;
+      low_watermark_.store(low, std::memory_order_relaxed);
+      high_watermark_.store(high, std::memory_order_relaxed);
+      if(high == 0) saturated_.store(false);
+      return true;
+    }
+
+    // :::::::::::::::::::::::::::::::::::: PRIVATE FUNCTIONS ::::::::::::::::::::::::::::::::::::
+
+    void send_queue::notify(const bool high){
+      watermark_handler handler;
+      {
+        std::lock_guard<std::mutex> guard(handler_mutex_);
+        handler = handler_;
+      }
+      // Called without this lock, so the handler could change the watermarks
+      if(handler) handler(high);
+    }
+
+    send_queue::node *send_queue::pop(){
+      // Intrusive queue of Dmitry Vyukov, the stub node is never returned
+      node *tail{tail_};
+      node *next{tail->next.load(std::memory_order_acquire)};
+
+      if(tail == &stub_){
+        if(next == nullptr) return nullptr;
+        tail_ = next;
+        tail = next;
+        next = next->next.load(std::memory_order_acquire);
+      }
+      if(next != nullptr){
+        tail_ = next;
+        return tail;
+      }
+
+      // A producer exchanged the head but it did not link its node yet
+      if(tail != head_.load(std::memory_order_acquire)) return nullptr;
+
+      // The last node can only be taken when there is another one after it
+      push(&stub_);
+      next = tail->next.load(std::memory_order_acquire);
+      if(next != nullptr){
+        tail_ = next;
+        return tail;
+      }
+      return nullptr;
+    }
+
+    void send_queue::push(node *message){
+      message->next.store(nullptr, std::memory_order_relaxed);
+      node *previous{head_.exchange(message)};
+      previous->next.store(message, std::memory_order_release);
+    }
+
+    void send_queue::transition(const bool high){
+      std::lock_guard<std::mutex> guard(transition_mutex_);
+      if(saturated_.load() == high) return;
+
+      const std::size_t low{low_watermark_.load(std::memory_order_relaxed)};
+      if(high){
+        saturated_.store(true);
+        // The writer drained the queue without seeing the flag, then it is not saturated
+        if(bytes_.load() <= low){
+          saturated_.store(false);
+          return;
+        }
+      }else{
+        // A producer reached the high watermark again before this transition
+        if(bytes_.load() > low) return;
+        saturated_.store(false);
+      }
+      notify(high);
+    }
+  } // namespace: network_communication
+} // namespace: ramrod
@@ -1,13 +1,23 @@
 #include "ramrod/network_communication/server.h"
 
+#include <algorithm>                   // for find
 #include <cerrno>                      // for errno
-#include <cstring>                     // for memset
+#include <cstring>                     // for memcmp, memcpy, memset
+#include <fcntl.h>                     // for fcntl, F_GETFL, F_SETFL, O_NONBLOCK
 #include <iosfwd>                      // for size_t
+#ifdef RAMROD_NETWORK_IO_URING
+#include <linux/io_uring.h>            // for IORING_CQE_F_MORE
+#endif
 #include <netdb.h>                     // for addrinfo, freeaddrinfo, gai_st...
+#include <poll.h>                      // for POLLIN, POLLOUT
 #include <signal.h>                    // for sigaction, sigemptyset, SA_RES...
-#include <sys/wait.h>                  // for waitpid, WNOHANG
+#include <sys/epoll.h>                 // for EPOLLIN, EPOLLOUT, EPOLLRDHUP
+#include <sys/uio.h>                   // for iovec
+#include <sys/un.h>                    // for sockaddr_un
 #include <thread>                      // for sleep_for, thread
-#include <unistd.h>                    // for ssize_t, close
+#include <unistd.h>                    // for ssize_t, close, unlink
+#include <utility>                     // for move, swap
+#include <vector>                      // for vector
 
 #include "ramrod/console.h"            // for formatted
 #include "ramrod/console/attention.h"  // for attention_stream, attention
@@ -16,9 +26,26 @@
 #include "ramrod/console/perror.h"     // for perror, perror_stream
 #include "ramrod/console/types.h"      // for error
 #include "ramrod/console/warning.h"    // for warning, warning_stream
+#include "ramrod/network_communication/io_vectors.h"
+#include "ramrod/network_communication/local_socket.h"
+#include "ramrod/network_communication/multicast.h"
+#include "ramrod/network_communication/reconnection_policy.h"
+#include "ramrod/network_communication/socket_options.h"
+#include "ramrod/network_communication/socket_wait.h"
+#include "ramrod/network_communication/timestamping.h"
+#include "ramrod/network_communication/zero_copy.h"
 
 namespace ramrod {
   namespace network_communication {
+#ifdef RAMROD_NETWORK_IO_URING
+    namespace {
+      // Buffers leased by every multishot reception, and results read at once
+      constexpr std::size_t multishot_buffers{32};
+      constexpr std::uint64_t multishot_reception{1};
+      constexpr std::uint64_t multishot_cancellation{2};
+    } // namespace: anonymous
+
+#endif
     server::server() :
       conversor(),
       ip_(),
@@ -35,13 +62,83 @@ namespace ramrod {
       connecting_{false},
       is_tcp_{false},
       client_{nullptr},
-      results_{nullptr},
+      peer_(),
+      peer_address_(),
       incoming_{},
-      reconnection_time_(std::chrono::milliseconds(5000))
-    {}
+      reconnection_(),
+      addresses_(),
+      reactor_{false},
+      reactor_workers_{2},
+      reactor_cpu_{-1},
+      handlers_(),
+      loop_(),
+      reactor_pool_(),
+      clients_mutex_(),
+      clients_(),
+      multi_peer_{false},
+      peers_mutex_(),
+      peers_(),
+      groups_mutex_(),
+      groups_(),
+      local_path_(),
+      non_blocking_{false},
+      io_timeout_{1000},
+      options_(),
+      messages_(),
+      message_timestamp_(),
+      compression_(),
+      negotiated_compression_{compression_algorithm::none},
+      compression_mutex_(),
+      compression_context_(),
+#ifdef RAMROD_NETWORK_IO_URING
+      io_uring_{false},
+      send_ring_mutex_(),
+      send_ring_(),
+      receive_ring_mutex_(),
+      receive_ring_(),
+#endif
+      io_threads_mutex_(),
+      io_threads_(),
+      receive_worker_(1),
+      send_worker_(1),
+      zero_copy_{false},
+      zero_copy_sends_(),
+      zero_copy_worker_(1),
+      send_queue_(),
+      channels_(),
+      channel_messages_(),
+      reliable_(),
+      reliable_receive_mutex_(),
+      reliable_send_mutex_(),
+      reliable_incoming_(),
+      reliable_outgoing_(),
+      metrics_()
+    {
+#ifdef RAMROD_NETWORK_IO_URING
+      // The backend was chosen when compiling, it is only disabled if the kernel is too old
+      io_uring(true);
+#endif
+    }
 
     server::~server(){
       disconnect();
+      // Waiting for the pending tasks, they stop quickly because the socket is closed
+      receive_worker_.stop();
+      send_worker_.stop();
+      zero_copy_worker_.stop();
+    }
+
+    compression_options server::compression(){
+      return compression_;
+    }
+
+    bool server::compression(const compression_options &new_options){
+      if(!compression_context::available(new_options.algorithm)){
+        errno = EPROTONOSUPPORT;
+        return false;
+      }
+      compression_ = new_options;
+      return true;
     }
 
     bool server::connect(const std::string &ip, const int port, const int socket_type,
@@ -53,27 +150,134 @@ namespace ramrod {
       port_ = port;
       current_intent_ = 0;
       is_tcp_ = socket_type != SOCK_DGRAM;
+      reactor_ = false;
+      multi_peer_ = false;
       terminate_concurrent_.store(false);
 
       if(concurrent)
-        std::thread(&server::concurrent_connector, this, false).detach();
+        std::thread([this, options = io_thread("connect")]{
+          configure_current_thread(options);
+          concurrent_connector(false);
+        }).detach();
       else
         concurrent_connector(true);
       return true;
     }
 
+    std::uint8_t server::channel_priority(const std::uint8_t channel){
+      return channels_.priority(channel);
+    }
+
+    bool server::channel_priority(const std::uint8_t channel, const std::uint8_t priority){
+      return channels_.priority(channel, priority);
+    }
+
+    std::size_t server::clients(){
+      std::lock_guard<std::mutex> guard(clients_mutex_);
+      return clients_.size();
+    }
+
+    bool server::close_client(const int client_fd){
+      std::lock_guard<std::mutex> guard(clients_mutex_);
+      if(clients_.find(client_fd) == clients_.end()) return false;
+
+      // The event loop will receive a hang up event and the worker will close it
+      if(::shutdown(client_fd, SHUT_RDWR) == -1){
+        rr::perror("Client connection cannot be shutdown");
+        return false;
+      }
+      return true;
+    }
+
     bool server::disconnect(){
       connecting_.store(false);
       terminate_send_.store(true);
       terminate_receive_.store(true);
       terminate_concurrent_.store(true);
 
-      if(results_) ::freeaddrinfo(results_);
-      results_ = nullptr;
+      if(reactor_){
+        loop_.stop();
+        if(reactor_pool_) reactor_pool_->stop();
+        reactor_close_all();
+      }
+
+      client_ = nullptr;
 
       return close_child() & close();
     }
 
+    bool server::has_client(const int client_fd){
+      std::lock_guard<std::mutex> guard(clients_mutex_);
+      return clients_.find(client_fd) != clients_.end();
+    }
+
+    thread_options server::io_threads(){
+      std::lock_guard<std::mutex> guard(io_threads_mutex_);
+      return io_threads_;
+    }
+
+    bool server::io_threads(const thread_options &new_options){
+      if(!validate_thread_options(new_options)) return false;
+      {
+        std::lock_guard<std::mutex> guard(io_threads_mutex_);
+        io_threads_ = new_options;
+      }
+      receive_worker_.options(thread_role(new_options, "recv"));
+      send_worker_.options(thread_role(new_options, "send"));
+      zero_copy_worker_.options(thread_role(new_options, "zcopy"));
+      return true;
+    }
+
+    int server::io_timeout(){
+      return io_timeout_;
+    }
+
+    void server::io_timeout(const int timeout_in_milliseconds){
+      io_timeout_ = timeout_in_milliseconds < 0 ? -1 : timeout_in_milliseconds;
+    }
+
+#ifdef RAMROD_NETWORK_IO_URING
+    bool server::io_uring(){
+      return io_uring_.load();
+    }
+
+    bool server::io_uring(const bool enable){
+      if(enable){
+        std::lock_guard<std::mutex> send_lock(send_ring_mutex_);
+        std::lock_guard<std::mutex> receive_lock(receive_ring_mutex_);
+        // The rings are never destroyed before the server, disabling only stops using them
+        if(!send_ring_) send_ring_ = std::make_unique<io_ring>();
+        if(!receive_ring_) receive_ring_ = std::make_unique<io_ring>();
+
+        if(!send_ring_->is_valid() || !receive_ring_->is_valid()){
+#ifdef VERBOSE
+          rr::perror("Creating io_uring");
+#endif
+          send_ring_.reset();
+          receive_ring_.reset();
+          io_uring_.store(false);
+          return false;
+        }
+      }
+      io_uring_.store(enable);
+      return true;
+    }
+
+    bool server::io_uring_buffers(const buffer_pool *pool){
+      std::lock_guard<std::mutex> lock(receive_ring_mutex_);
+      if(!receive_ring_){
+        errno = ENODEV;
+        return false;
+      }
+
+      if(!receive_ring_->unregister_buffers() && errno != ENXIO) return false;
+      if(pool == nullptr) return true;
+
+      const std::vector<iovec> slabs{pool->slabs()};
+      return receive_ring_->register_buffers(slabs.data(), slabs.size());
+    }
+#endif
+
     const std::string &server::ip(){
       return ip_;
     }
@@ -82,6 +286,114 @@ namespace ramrod {
       return connected_.load(std::memory_order_relaxed);
     }
 
+    bool server::join_group(const std::string &group, const std::string &interface){
+      if(is_tcp_ && (connected_.load() || connecting_.load())){
+        errno = EOPNOTSUPP;
+        return false;
+      }
+
+      std::lock_guard<std::mutex> guard(groups_mutex_);
+      if(connected_.load() && !join_multicast_group(socket_fd_, group, interface))
+        return false;
+
+      const std::pair<std::string, std::string> joined{group, interface};
+      if(std::find(groups_.begin(), groups_.end(), joined) == groups_.end())
+        groups_.push_back(joined);
+      return true;
+    }
+
+    bool server::latency_metrics(){
+      return metrics_.latencies();
+    }
+
+    void server::latency_metrics(const bool enable){
+      metrics_.latencies(enable);
+    }
+
+    bool server::leave_group(const std::string &group, const std::string &interface){
+      std::lock_guard<std::mutex> guard(groups_mutex_);
+      const auto joined = std::find(groups_.begin(), groups_.end(),
+                                    std::make_pair(group, interface));
+      if(joined == groups_.end()){
+        errno = EADDRNOTAVAIL;
+        return false;
+      }
+      groups_.erase(joined);
+
+      return !connected_.load() || is_tcp_ || leave_multicast_group(socket_fd_, group, interface);
+    }
+
+    bool server::listen(const std::string &ip, const connection_handlers &handlers,
+                        const int port, const std::size_t workers, const bool concurrent,
+                        const int cpu){
+      if(connecting_.load()) return false;
+      if(connected_.load()) disconnect();
+
+      ip_ = ip;
+      port_ = port;
+      current_intent_ = 0;
+      is_tcp_ = true;
+      reactor_ = true;
+      multi_peer_ = false;
+      reactor_workers_ = workers;
+      reactor_cpu_ = cpu;
+      handlers_ = handlers;
+      terminate_concurrent_.store(false);
+
+      if(concurrent)
+        std::thread([this, options = io_thread("connect")]{
+          configure_current_thread(options);
+          concurrent_connector(false);
+        }).detach();
+      else
+        concurrent_connector(true);
+      return true;
+    }
+
+    bool server::listen_peers(const std::string &ip, const int port, const bool concurrent){
+      if(connecting_.load()) return false;
+      if(connected_.load()) disconnect();
+
+      ip_ = ip;
+      port_ = port;
+      current_intent_ = 0;
+      is_tcp_ = false;
+      reactor_ = false;
+      multi_peer_ = true;
+      terminate_concurrent_.store(false);
+      {
+        std::lock_guard<std::mutex> guard(peers_mutex_);
+        peers_.clear();
+      }
+
+      if(concurrent)
+        std::thread([this, options = io_thread("connect")]{
+          configure_current_thread(options);
+          concurrent_connector(false);
+        }).detach();
+      else
+        concurrent_connector(true);
+      return true;
+    }
+
+    std::size_t server::max_message_size(){
+      return messages_.max_message_size();
+    }
+
+    bool server::max_message_size(const std::size_t new_max_message_size){
+      return messages_.max_message_size(new_max_message_size);
+    }
+
+    std::size_t server::max_peers(){
+      std::lock_guard<std::mutex> guard(peers_mutex_);
+      return peers_.max_peers();
+    }
+
+    bool server::max_peers(const std::size_t new_max_peers){
+      std::lock_guard<std::mutex> guard(peers_mutex_);
+      return peers_.max_peers(new_max_peers);
+    }
+
     int server::max_queue(){
       return max_queue_;
     }
@@ -92,6 +404,16 @@ namespace ramrod {
       return true;
     }
 
+    std::size_t server::max_queued_bytes(){
+      return send_queue_.max_bytes();
+    }
+
+    bool server::max_queued_bytes(const std::size_t new_max_queued_bytes){
+      if(new_max_queued_bytes == 0) return false;
+      send_queue_.max_bytes(new_max_queued_bytes);
+      return true;
+    }
+
     std::uint32_t server::max_reconnection_intents(){
       return max_intents_;
     }
@@ -100,14 +422,92 @@ namespace ramrod {
       max_intents_ = new_max_intents;
     }
 
+    packet_timestamp server::message_timestamp(){
+      return message_timestamp_;
+    }
+
+    metrics_snapshot server::metrics(){
+      return metrics_.snapshot();
+    }
+
+    compression_algorithm server::negotiated_compression(){
+      return negotiated_compression_;
+    }
+
+    bool server::non_blocking(){
+      return non_blocking_;
+    }
+
+    bool server::non_blocking(const bool enable){
+      non_blocking_ = enable;
+      // Changing the current connection, the next ones are changed when connected
+      if(connected_.load() && connected_fd_ >= 0)
+        return set_non_blocking(connected_fd_, enable);
+      return true;
+    }
+
+    bool server::notify_writable(const int client_fd, const bool enable){
+      std::lock_guard<std::mutex> guard(clients_mutex_);
+      auto found = clients_.find(client_fd);
+      if(found == clients_.end()) return false;
+
+      client_state &state = found->second;
+      state.interest = enable ? state.interest | EPOLLOUT : state.interest & ~EPOLLOUT;
+      // A busy client will be re-armed with the new interest when its worker finishes
+      if(!state.busy) loop_.modify(client_fd, state.interest);
+      return true;
+    }
+
+    socket_options server::options(){
+      // Without an accepted client the listening socket is used
+      const int current{connected_fd_ >= 0 ? connected_fd_ : socket_fd_};
+      if(connected_.load() && current >= 0)
+        return read_socket_options(current);
+      return options_;
+    }
+
+    bool server::options(const socket_options &new_options){
+      options_ = new_options;
+      // Without an accepted client the listening socket is used
+      const int current{connected_fd_ >= 0 ? connected_fd_ : socket_fd_};
+      // Changing the current connection, the next ones are changed when connected
+      if(connected_.load() && current >= 0)
+        return apply_socket_options(current, options_);
+      return true;
+    }
+
+    bool server::peer_address(const int peer, sockaddr_storage *address, socklen_t *length){
+      std::lock_guard<std::mutex> guard(peers_mutex_);
+      return peers_.get(peer, address, length);
+    }
+
+    std::size_t server::peers(){
+      std::lock_guard<std::mutex> guard(peers_mutex_);
+      return peers_.size();
+    }
+
     int server::port(){
       return port_;
     }
 
+    bool server::queue_saturated(){
+      return send_queue_.saturated();
+    }
+
+    bool server::queue_watermarks(const std::size_t high, const std::size_t low,
+                                const watermark_handler &handler){
+      return send_queue_.watermarks(high, low, handler);
+    }
+
+    std::size_t server::queued_bytes(){
+      return send_queue_.bytes();
+    }
+
     ssize_t server::receive(void *buffer, const std::size_t size, const int flags){
       if(!connected_.load() || size == 0)
         return 0;
 
+      const std::uint64_t start{metrics_.start()};
       ssize_t received{0};
       std::uint32_t error_counter{0};
 
@@ -115,27 +515,63 @@ namespace ramrod {
         if(is_tcp_)
           received = ::recv(connected_fd_, buffer, size, flags);
         else{
-          socklen_t addr_len;
-          received = ::recvfrom(socket_fd_, buffer, size, flags, &incoming_, &addr_len);
+          socklen_t addr_len = sizeof(incoming_);
+          received = ::recvfrom(socket_fd_, buffer, size, flags,
+                                reinterpret_cast<sockaddr*>(&incoming_), &addr_len);
           // Ignores data that does not come from the same client
-          if(std::strncmp(client_->ai_addr->sa_data, incoming_.sa_data, addr_len) != 0)
+          if(received >= 0 && !from_client(incoming_, addr_len)){
+            // It is not an error, it only waits for the next datagram
+            errno = EAGAIN;
             received = -1;
+          }
         }
 
         if(received == 0) return 0;
 
         if(received < 0){
-  #ifdef VERBOSE
-          rr::perror("Receiving data");
-  #endif
-          if(++error_counter > max_intents_)
+          // Waits until the socket is ready again, it fails after the max intents
+          if(!retry(is_tcp_ ? connected_fd_ : socket_fd_, POLLIN, &error_counter, nullptr))
             return received;
+          continue;
+        }
+        return metrics_.received(received, start);
+      }
+    }
+
+    ssize_t server::receive(const iovec *buffers, const std::size_t count, const int flags){
+      if(!connected_.load() || count == 0)
+        return 0;
+
+      const std::uint64_t start{metrics_.start()};
+      io_vectors parts(buffers, count);
+      if(parts.empty()) return 0;
+
+      ssize_t received{0};
+      std::uint32_t error_counter{0};
+      msghdr header{};
+      header.msg_iov = parts.data();
+      header.msg_iovlen = parts.count();
+
+      while(true){
+        header.msg_name = &incoming_;
+        header.msg_namelen = sizeof(incoming_);
+        received = ::recvmsg(is_tcp_ ? connected_fd_ : socket_fd_, &header, flags);
+        // Ignores data that does not come from the same client
+        if(!is_tcp_ && received >= 0 && !from_client(incoming_, header.msg_namelen)){
+          // It is not an error, it only waits for the next datagram
+          errno = EAGAIN;
+          received = -1;
+        }
 
-          // This will try to receive the same data than the last time
-          std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        if(received == 0) return 0;
+
+        if(received < 0){
+          // Waits until the socket is ready again, it fails after the max intents
+          if(!retry(is_tcp_ ? connected_fd_ : socket_fd_, POLLIN, &error_counter, nullptr))
+            return received;
           continue;
         }
-        return received;
+        return metrics_.received(received, start);
       }
     }
 
@@ -144,6 +580,7 @@ namespace ramrod {
       if(!connected_.load() || size == 0)
         return 0;
 
+      const std::uint64_t start{metrics_.start()};
       std::size_t total_received{0};
       std::size_t bytes_left = size;
       ssize_t received_size;
@@ -152,36 +589,123 @@ namespace ramrod {
       bool never{false};
       if(breaker == nullptr) breaker = &never;
 
+#ifdef RAMROD_NETWORK_IO_URING
+      if(is_tcp_ && io_uring_.load()){
+        std::lock_guard<std::mutex> lock(receive_ring_mutex_);
+        return metrics_.received(ring_receive_all(receive_ring_.get(), connected_fd_, buffer, size,
+                                                  breaker, flags, io_timeout_, max_intents_,
+                                                  &metrics_), start);
+      }
+#endif
       while(total_received < size && !(*breaker)){
         if(is_tcp_)
           received_size = ::recv(connected_fd_, (std::uint8_t*)buffer + total_received,
                                  bytes_left, flags);
         else{
+          addr_len = sizeof(incoming_);
           received_size = ::recvfrom(socket_fd_, (std::uint8_t*)buffer + total_received,
-                                     bytes_left, flags, &incoming_, &addr_len);
+                                     bytes_left, flags,
+                                     reinterpret_cast<sockaddr*>(&incoming_), &addr_len);
           // Ignores data that does not come from the same client
-          if(std::strncmp(client_->ai_addr->sa_data, incoming_.sa_data, addr_len) != 0)
+          if(received_size >= 0 && !from_client(incoming_, addr_len))
             continue;
         }
 
         if(received_size == 0) return 0;
 
         if(received_size < 0){
-#ifdef VERBOSE
-          rr::perror("Receiving data");
-#endif
-          // There is an error and returns after the max intents have been reached
-          if(++error_counter > max_intents_)
+          // Waits until the socket is ready again, it fails after the max intents
+          if(!retry(is_tcp_ ? connected_fd_ : socket_fd_, POLLIN, &error_counter, nullptr))
             return received_size;
-
-          // This will try to receive the same data than the last time
-          std::this_thread::sleep_for(std::chrono::milliseconds(10));
           continue;
         }
         total_received += static_cast<std::size_t>(received_size);
         bytes_left -= static_cast<std::size_t>(received_size);
       }
-      return static_cast<ssize_t>(total_received);
+      return metrics_.received(static_cast<ssize_t>(total_received), start);
+    }
+
+    ssize_t server::receive_all(const iovec *buffers, const std::size_t count, bool *breaker,
+                                 const int flags){
+      if(!connected_.load() || count == 0)
+        return 0;
+
+      const std::uint64_t start{metrics_.start()};
+      io_vectors parts(buffers, count);
+      std::size_t total_received{0};
+      ssize_t received_size;
+      std::uint32_t error_counter{0};
+      msghdr header{};
+      bool never{false};
+      if(breaker == nullptr) breaker = &never;
+
+      while(!parts.empty() && !(*breaker)){
+        header.msg_iov = parts.data();
+        header.msg_iovlen = parts.count();
+        header.msg_name = &incoming_;
+        header.msg_namelen = sizeof(incoming_);
+        received_size = ::recvmsg(is_tcp_ ? connected_fd_ : socket_fd_, &header, flags);
+        // Ignores data that does not come from the same client
+        if(!is_tcp_ && received_size >= 0 && !from_client(incoming_, header.msg_namelen)){
+          // It is not an error, it only waits for the next datagram
+          errno = EAGAIN;
+          received_size = -1;
+        }
+
+        if(received_size == 0) return 0;
+
+        if(received_size < 0){
+          // Waits until the socket is ready again, it fails after the max intents
+          if(!retry(is_tcp_ ? connected_fd_ : socket_fd_, POLLIN, &error_counter, nullptr))
+            return received_size;
+          continue;
+        }
+        total_received += static_cast<std::size_t>(received_size);
+        parts.advance(static_cast<std::size_t>(received_size));
+      }
+      return metrics_.received(static_cast<ssize_t>(total_received), start);
+    }
+
+    operation server::receive_all_async(void *buffer, const std::size_t size,
+                                        const operation::completion &on_complete, const int flags){
+      operation task(on_complete);
+      if(!connected_.load() || size == 0){
+        task.finish(0);
+        return task;
+      }
+
+      if(!receive_worker_.post([this, buffer, size, flags, task]() mutable{
+           task.finish(concurrent_receive_all(buffer, size, nullptr, task.cancellation(), flags));
+         })){
+        errno = ECANCELED;
+        task.finish(-1);
+      }
+      return task;
+    }
+
+    operation server::receive_all_async(buffer_pool *pool, const std::size_t size,
+                                        const lease_completion &on_complete, const int flags){
+      operation task(nullptr);
+      if(!connected_.load() || size == 0){
+        if(on_complete) on_complete(buffer_lease(), 0);
+        task.finish(0);
+        return task;
+      }
+      if(pool == nullptr || size > pool->buffer_size()){
+        if(on_complete) on_complete(buffer_lease(), -1);
+        errno = EMSGSIZE;
+        task.finish(-1);
+        return task;
+      }
+
+      if(!receive_worker_.post([this, pool, size, on_complete, flags, task]{
+           concurrent_receive_leased(pool, size, true, task, on_complete, flags);
+         })){
+        if(on_complete) on_complete(buffer_lease(), -1);
+        errno = ECANCELED;
+        task.finish(-1);
+      }
+      return task;
     }
 
     bool server::receive_all_concurrently(void *buffer, std::size_t *size, bool *breaker,
@@ -191,20 +715,407 @@ namespace ramrod {
         return false;
       }
 
-      std::thread(&server::concurrent_receive_all, this, buffer, size, breaker, flags).detach();
+      if(!receive_worker_.post([this, buffer, size, breaker, flags]{
+           const ssize_t received = concurrent_receive_all(buffer, *size, breaker, nullptr, flags);
+           *size = received > 0 ? static_cast<std::size_t>(received) : 0;
+         })){
+        *size = 0;
+        return false;
+      }
       return true;
     }
 
+    operation server::receive_async(void *buffer, const std::size_t size,
+                                    const operation::completion &on_complete, const int flags){
+      operation task(on_complete);
+      if(!connected_.load() || size == 0){
+        task.finish(0);
+        return task;
+      }
+
+      if(!receive_worker_.post([this, buffer, size, flags, task]() mutable{
+           task.finish(concurrent_receive(buffer, size, task.cancellation(), flags));
+         })){
+        errno = ECANCELED;
+        task.finish(-1);
+      }
+      return task;
+    }
+
+    operation server::receive_async(buffer_pool *pool, const lease_completion &on_complete,
+                                    const int flags){
+      operation task(nullptr);
+      if(!connected_.load() || pool == nullptr){
+        if(on_complete) on_complete(buffer_lease(), 0);
+        task.finish(0);
+        return task;
+      }
+
+      if(!receive_worker_.post([this, pool, on_complete, flags, task]{
+           concurrent_receive_leased(pool, pool->buffer_size(), false, task, on_complete, flags);
+         })){
+        if(on_complete) on_complete(buffer_lease(), -1);
+        errno = ECANCELED;
+        task.finish(-1);
+      }
+      return task;
+    }
+
+    int server::receive_channels(const channel_handler &handler, bool *breaker, const int flags){
+      if(!connected_.load())
+        return 0;
+
+      const std::uint8_t *message;
+      std::uint32_t message_size;
+      int total{0};
+      // Chunks of incomplete messages do not count, it keeps waiting until one is complete
+      while(total == 0){
+        int status = next_message(&message, &message_size, breaker, flags);
+        if(status <= 0) return status;
+
+        do{
+          const int completed = channel_messages_.add(message, message_size, handler);
+          if(completed < 0) return -1;
+          total += completed;
+        }while((status = messages_.next(&message, &message_size)) > 0);
+      }
+
+      metrics_.messages_received(static_cast<std::uint64_t>(total));
+      return total;
+    }
+
     bool server::receive_concurrently(void *buffer, std::size_t *size, const int flags){
       if(!connected_.load() || *size == 0){
         *size = 0;
         return false;
       }
 
-      std::thread(&server::concurrent_receive, this, buffer, size, flags).detach();
+      if(!receive_worker_.post([this, buffer, size, flags]{
+           const ssize_t received = concurrent_receive(buffer, *size, nullptr, flags);
+           *size = received > 0 ? static_cast<std::size_t>(received) : 0;
+         })){
+        *size = 0;
+        return false;
+      }
       return true;
     }
 
+    int server::receive_datagrams(datagram *datagrams, const std::size_t count, const int flags){
+      if(!connected_.load() || count == 0)
+        return 0;
+      if(is_tcp_){
+        errno = EOPNOTSUPP;
+        return -1;
+      }
+
+      const std::size_t batch{count < max_datagram_batch ? count : max_datagram_batch};
+      mmsghdr headers[max_datagram_batch];
+      iovec parts[max_datagram_batch];
+      // Only the sockets with timestamps need room for the control messages
+      const bool timestamps{options_.receive_timestamps || options_.hardware_timestamps};
+      alignas(cmsghdr) std::uint8_t controls[max_datagram_batch][timestamp_control_size];
+      std::uint32_t error_counter{0};
+
+      while(true){
+        // The kernel overwrites the address lengths, so they are prepared every time
+        for(std::size_t i{0}; i < batch; ++i){
+          parts[i] = {datagrams[i].buffer, datagrams[i].size};
+          headers[i] = mmsghdr{};
+          headers[i].msg_hdr.msg_iov = &parts[i];
+          headers[i].msg_hdr.msg_iovlen = 1;
+          headers[i].msg_hdr.msg_name = &datagrams[i].address;
+          headers[i].msg_hdr.msg_namelen = sizeof(sockaddr_storage);
+          if(timestamps){
+            headers[i].msg_hdr.msg_control = controls[i];
+            headers[i].msg_hdr.msg_controllen = sizeof(controls[i]);
+          }
+        }
+
+        // Returns after the first datagram instead of waiting for the whole batch
+        const int received = ::recvmmsg(socket_fd_, headers, static_cast<unsigned int>(batch),
+                                        flags | MSG_WAITFORONE, nullptr);
+        if(received > 0){
+          int accepted{0};
+          std::size_t bytes{0};
+          for(int i{0}; i < received; ++i){
+            datagram &current = datagrams[i];
+            current.length = headers[i].msg_len;
+            current.truncated = (headers[i].msg_hdr.msg_flags & MSG_TRUNC) != 0;
+            current.address_length = headers[i].msg_hdr.msg_namelen;
+            read_timestamp(headers[i].msg_hdr, &current.timestamp);
+            // Ignores data that does not come from the same client
+            if(!from_client(current.address, current.address_length)) continue;
+            // Counted before swapping, then `current` holds the rejected datagram
+            bytes += current.length;
+            if(i != accepted) std::swap(datagrams[accepted], current);
+            ++accepted;
+          }
+          if(accepted > 0){
+            metrics_.received(static_cast<ssize_t>(bytes));
+            metrics_.messages_received(static_cast<std::uint64_t>(accepted));
+            return accepted;
+          }
+          // It is not an error, it only waits for the next datagrams
+          errno = EAGAIN;
+        }
+
+        // Waits until the socket is ready again, it fails after the max intents
+        if(!retry(socket_fd_, POLLIN, &error_counter, nullptr))
+          return -1;
+      }
+    }
+
+    ssize_t server::receive_from(const int client_fd, void *buffer, const std::size_t size,
+                                 const int flags){
+      if(!connected_.load() || size == 0)
+        return 0;
+
+      return metrics_.received(::recv(client_fd, buffer, size, flags));
+    }
+
+    ssize_t server::receive_from_peer(void *buffer, const std::size_t size, int *peer,
+                                      const int flags){
+      *peer = -1;
+      if(!connected_.load() || size == 0)
+        return 0;
+
+      if(!multi_peer_){
+        errno = EOPNOTSUPP;
+        return -1;
+      }
+
+      sockaddr_storage address;
+      socklen_t length{sizeof(address)};
+      const ssize_t received = ::recvfrom(socket_fd_, buffer, size, flags,
+                                          reinterpret_cast<sockaddr*>(&address), &length);
+      if(received < 0) return received;
+
+      std::lock_guard<std::mutex> guard(peers_mutex_);
+      *peer = peers_.add(address, length);
+      return metrics_.received(received);
+    }
+
+    ssize_t server::receive_message(void *buffer, const std::size_t size, bool *breaker,
+                                    const int flags){
+      if(!connected_.load() || size == 0)
+        return 0;
+
+      const std::uint8_t *message;
+      std::uint32_t message_size;
+      const int status = next_message(&message, &message_size, breaker, flags);
+      if(status <= 0) return status;
+
+      const std::uint8_t *data{message};
+      std::size_t data_size{message_size};
+      if(negotiated_compression_ != compression_algorithm::none
+         && !compression_context_.decompress(message, message_size, size, &data, &data_size))
+        return -1;
+
+      if(data_size > size){
+        errno = EMSGSIZE;
+        return -1;
+      }
+      std::memcpy(buffer, data, data_size);
+      metrics_.messages_received();
+      return static_cast<ssize_t>(data_size);
+    }
+
+    int server::receive_messages(const message_handler &handler, bool *breaker, const int flags){
+      if(!connected_.load())
+        return 0;
+
+      const std::uint8_t *message;
+      std::uint32_t message_size;
+      // Only the first message could wait for receiving more bytes
+      int status = next_message(&message, &message_size, breaker, flags);
+      if(status <= 0) return status;
+
+      const bool compressed{negotiated_compression_ != compression_algorithm::none};
+      const std::uint8_t *data;
+      std::size_t data_size;
+      int total{0};
+      do{
+        data = message;
+        data_size = message_size;
+        if(compressed && !compression_context_.decompress(message, message_size,
+                                                          messages_.max_message_size(),
+                                                          &data, &data_size))
+          return -1;
+        ++total;
+        if(handler) handler(data, static_cast<std::uint32_t>(data_size));
+      }while((status = messages_.next(&message, &message_size)) > 0);
+
+      metrics_.messages_received(static_cast<std::uint64_t>(total));
+      // The broken message will be reported in the next call
+      return total;
+    }
+
+#ifdef RAMROD_NETWORK_IO_URING
+    ssize_t server::receive_multishot(buffer_pool *pool, const data_handler &handler,
+                                      bool *breaker, const int flags){
+      if(!connected_.load())
+        return 0;
+      if(!is_tcp_ || pool == nullptr){
+        errno = EINVAL;
+        return -1;
+      }
+
+      // The leases are declared before the ring, so the kernel stops using the buffers
+      // before they return to the pool
+      std::vector<buffer_lease> leases(multishot_buffers);
+      std::vector<iovec> buffers(multishot_buffers);
+      for(std::size_t i = 0; i < multishot_buffers; ++i){
+        leases[i] = pool->acquire();
+        if(!leases[i].is_valid()){
+          errno = ENOMEM;
+          return -1;
+        }
+        buffers[i] = iovec{leases[i].data(), leases[i].capacity()};
+      }
+
+      io_ring ring;
+      if(!ring.is_valid() || !ring.provide_buffers(buffers.data(), buffers.size())){
+#ifdef VERBOSE
+        rr::perror("Preparing multishot reception");
+#endif
+        return -1;
+      }
+
+      io_completion results[multishot_buffers];
+      std::size_t total_received{0};
+      std::uint32_t error_counter{0};
+      bool armed{false};
+      bool cancelling{false};
+      bool never{false};
+      if(breaker == nullptr) breaker = &never;
+
+      while(true){
+        if(!armed){
+          if(*breaker) return static_cast<ssize_t>(total_received);
+          if(!ring.prepare_receive_multishot(connected_fd_, flags, multishot_reception))
+            return -1;
+          armed = true;
+          cancelling = false;
+        }
+        if(*breaker && !cancelling){
+          ring.prepare_cancel(multishot_reception, multishot_cancellation);
+          cancelling = true;
+        }
+
+        // Waking up periodically to check the breaker
+        const int count{ring.wait(results, multishot_buffers, 50)};
+        if(count < 0) return -1;
+
+        for(int i = 0; i < count; ++i){
+          const io_completion &result{results[i]};
+          if(result.user_data != multishot_reception) continue;
+
+          // The kernel stopped the reception, it is armed again in the next iteration
+          if((result.flags & IORING_CQE_F_MORE) == 0) armed = false;
+
+          if(result.result > 0){
+            if(handler) handler(ring.provided_buffer(result),
+                                static_cast<std::size_t>(result.result));
+            ring.recycle(result);
+            metrics_.received(result.result);
+            total_received += static_cast<std::size_t>(result.result);
+            error_counter = 0;
+            continue;
+          }
+          if(result.result == 0) return 0;
+          // All the buffers were used because the handler is slower than the stream
+          if(result.result == -ENOBUFS || result.result == -ECANCELED) continue;
+
+          errno = -result.result;
+          if(!retry(connected_fd_, POLLIN, &error_counter, nullptr)) return -1;
+        }
+      }
+    }
+
+#endif
+    int server::receive_reliable(const reliable_handler &handler, bool *breaker){
+      if(!connected_.load())
+        return 0;
+      // In multi-peer mode there is no single session
+      if(is_tcp_ || multi_peer_){
+        errno = EOPNOTSUPP;
+        return -1;
+      }
+
+      bool never{false};
+      if(breaker == nullptr) breaker = &never;
+
+      std::lock_guard<std::mutex> guard(reliable_receive_mutex_);
+      while(!(*breaker) && connected_.load()){
+        // Acknowledgements of the last datagrams, expired retransmissions and new messages
+        flush_reliable();
+        const int delivered = reliable_.deliver(handler);
+        if(delivered > 0) return delivered;
+        if(reliable_.failed()){
+          errno = ETIMEDOUT;
+          return -1;
+        }
+
+        // Waiting until the next timer at most, the breaker is checked every 50 milliseconds
+        int timeout{reliable_.wait_time()};
+        if(timeout < 0 || timeout > 50) timeout = 50;
+        const int ready = wait_for_socket(socket_fd_, POLLIN, timeout);
+        if(ready < 0) return -1;
+        if(ready > 0 && !receive_reliable_datagrams()) return -1;
+      }
+
+      if(!connected_.load()) return 0;
+      errno = ECANCELED;
+      return -1;
+    }
+
+    ssize_t server::receive_timestamped(void *buffer, const std::size_t size,
+                                        packet_timestamp *timestamp, const int flags){
+      *timestamp = packet_timestamp{};
+      if(!connected_.load() || size == 0)
+        return 0;
+
+      const std::uint64_t start{metrics_.start()};
+      iovec part{buffer, size};
+      alignas(cmsghdr) std::uint8_t control[timestamp_control_size];
+      ssize_t received{0};
+      std::uint32_t error_counter{0};
+
+      while(true){
+        // The kernel overwrites the control and address lengths, so they are prepared
+        // every time
+        msghdr header{};
+        header.msg_iov = &part;
+        header.msg_iovlen = 1;
+        header.msg_control = control;
+        header.msg_controllen = sizeof(control);
+        if(is_tcp_)
+          received = ::recvmsg(connected_fd_, &header, flags);
+        else{
+          header.msg_name = &incoming_;
+          header.msg_namelen = sizeof(incoming_);
+          received = ::recvmsg(socket_fd_, &header, flags);
+          // Ignores data that does not come from the same client
+          if(received >= 0 && !from_client(incoming_, header.msg_namelen)){
+            // It is not an error, it only waits for the next datagram
+            errno = EAGAIN;
+            received = -1;
+          }
+        }
+
+        if(received == 0) return 0;
+
+        if(received < 0){
+          // Waits until the socket is ready again, it fails after the max intents
+          if(!retry(is_tcp_ ? connected_fd_ : socket_fd_, POLLIN, &error_counter, nullptr))
+            return received;
+          continue;
+        }
+        read_timestamp(header, timestamp);
+        return metrics_.received(received, start);
+      }
+    }
+
     bool server::reconnect(const bool concurrent){
       if(ip_.size() == 0 || port_ <= 0) return false;
       if(connecting_.load()) return true;
@@ -215,37 +1126,102 @@ namespace ramrod {
       terminate_concurrent_.store(false);
 
       if(concurrent)
-        std::thread(&server::concurrent_connector, this, false).detach();
+        std::thread([this, options = io_thread("connect")]{
+          configure_current_thread(options);
+          concurrent_connector(false);
+        }).detach();
       else
         concurrent_connector(true);
       return true;
     }
 
+    reconnection_policy server::reconnection(){
+      return reconnection_;
+    }
+
+    bool server::reconnection(const reconnection_policy &new_policy){
+      if(!is_valid(new_policy)) return false;
+      reconnection_ = new_policy;
+      return true;
+    }
+
+    bool server::remove_peer(const int peer){
+      std::lock_guard<std::mutex> guard(peers_mutex_);
+      return peers_.remove(peer);
+    }
+
+    reliable_options server::reliable_udp(){
+      return reliable_.options();
+    }
+
+    bool server::reliable_udp(const reliable_options &new_options){
+      return reliable_.options(new_options);
+    }
+
+    reliable_statistics server::reliable_udp_statistics(){
+      return reliable_.statistics();
+    }
+
+    void server::reset_metrics(){
+      metrics_.reset();
+    }
+
     ssize_t server::send(const void *buffer, const std::size_t size, const int flags){
       if(!connected_.load() || size == 0)
         return 0;
 
+      const std::uint64_t start{metrics_.start()};
       std::uint32_t error_counter{0};
       ssize_t sent{0};
 
       while(true){
-        sent = ::sendto(connected_fd_, buffer, size, flags,
-                        client_->ai_addr, client_->ai_addrlen);
+        // The TCP socket is already connected, only the datagrams need the destination
+        sent = ::sendto(connected_fd_, buffer, size, flags, destination(),
+                        destination_length());
 
         if(sent == 0) return 0;
 
         if(sent < 0){
-#ifdef VERBOSE
-          rr::perror("Sending data");
-#endif
-          if(++error_counter > max_intents_)
+          // Waits until the socket is ready again, it fails after the max intents
+          if(!retry(connected_fd_, POLLOUT, &error_counter, nullptr))
             return sent;
+          continue;
+        }
+        return metrics_.sent(sent, start);
+      }
+    }
+
+    ssize_t server::send(const iovec *buffers, const std::size_t count, const int flags){
+      if(!connected_.load() || count == 0)
+        return 0;
+
+      const std::uint64_t start{metrics_.start()};
+      io_vectors parts(buffers, count);
+      if(parts.empty()) return 0;
+
+      std::uint32_t error_counter{0};
+      ssize_t sent{0};
+      msghdr header{};
+      // The TCP socket is already connected, only the datagrams need the destination
+      if(!is_tcp_){
+        header.msg_name = destination();
+        header.msg_namelen = destination_length();
+      }
+      header.msg_iov = parts.data();
+      header.msg_iovlen = parts.count();
 
-          // This will try to receive the same data than the last time
-          std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      while(true){
+        sent = ::sendmsg(connected_fd_, &header, flags);
+
+        if(sent == 0) return 0;
+
+        if(sent < 0){
+          // Waits until the socket is ready again, it fails after the max intents
+          if(!retry(connected_fd_, POLLOUT, &error_counter, nullptr))
+            return sent;
           continue;
         }
-        return sent;
+        return metrics_.sent(sent, start);
       }
     }
 
@@ -254,6 +1230,7 @@ namespace ramrod {
       if(!connected_.load() || size == 0)
         return 0;
 
+      const std::uint64_t start{metrics_.start()};
       std::size_t total_sent{0};
       std::size_t bytes_left = size;
       ssize_t sent_size;
@@ -261,60 +1238,426 @@ namespace ramrod {
       bool never{false};
       if(breaker == nullptr) breaker = &never;
 
+#ifdef RAMROD_NETWORK_IO_URING
+      if(is_tcp_ && io_uring_.load()){
+        std::lock_guard<std::mutex> lock(send_ring_mutex_);
+        return metrics_.sent(ring_send_all(send_ring_.get(), connected_fd_, buffer, size, breaker,
+                                           flags, io_timeout_, max_intents_, &metrics_),
+                             start);
+      }
+#endif
       while(total_sent < size && !(*breaker)){
+        // The TCP socket is already connected, only the datagrams need the destination
         sent_size = ::sendto(connected_fd_, (const std::uint8_t*)buffer + total_sent,
-                             bytes_left, flags, client_->ai_addr, client_->ai_addrlen);
+                             bytes_left, flags, destination(), destination_length());
         if(sent_size == 0)
           return 0;
 
         if(sent_size < 0){
-#ifdef VERBOSE
-          rr::perror("Sending data");
-#endif
-          // There is an error and returns after the max intents have been reached
-          if(++error_counter > max_intents_)
+          // Waits until the socket is ready again, it fails after the max intents
+          if(!retry(connected_fd_, POLLOUT, &error_counter, nullptr))
             return sent_size;
-
-          // This will try to send the same data than the last time
-          std::this_thread::sleep_for(std::chrono::milliseconds(10));
           continue;
         }
         total_sent += static_cast<std::size_t>(sent_size);
         bytes_left -= static_cast<std::size_t>(sent_size);
       }
-      return static_cast<ssize_t>(total_sent);
+      return metrics_.sent(static_cast<ssize_t>(total_sent), start);
+    }
+
+    ssize_t server::send_all(const iovec *buffers, const std::size_t count, bool *breaker,
+                              const int flags){
+      if(!connected_.load() || count == 0)
+        return 0;
+
+      const std::uint64_t start{metrics_.start()};
+      io_vectors parts(buffers, count);
+      std::size_t total_sent{0};
+      ssize_t sent_size;
+      std::uint32_t error_counter{0};
+      msghdr header{};
+      // The TCP socket is already connected, only the datagrams need the destination
+      if(!is_tcp_){
+        header.msg_name = destination();
+        header.msg_namelen = destination_length();
+      }
+      bool never{false};
+      if(breaker == nullptr) breaker = &never;
+
+      while(!parts.empty() && !(*breaker)){
+        header.msg_iov = parts.data();
+        header.msg_iovlen = parts.count();
+        sent_size = ::sendmsg(connected_fd_, &header, flags);
+        if(sent_size == 0)
+          return 0;
+
+        if(sent_size < 0){
+          // Waits until the socket is ready again, it fails after the max intents
+          if(!retry(connected_fd_, POLLOUT, &error_counter, nullptr))
+            return sent_size;
+          continue;
+        }
+        total_sent += static_cast<std::size_t>(sent_size);
+        parts.advance(static_cast<std::size_t>(sent_size));
+      }
+      return metrics_.sent(static_cast<ssize_t>(total_sent), start);
+    }
+
+    operation server::send_all_async(const void *buffer, const std::size_t size,
+                                     const operation::completion &on_complete, const int flags){
+      operation task(on_complete);
+      if(!connected_.load() || size == 0){
+        task.finish(0);
+        return task;
+      }
+
+      if(!send_worker_.post([this, buffer, size, flags, task]() mutable{
+           if(size >= zero_copy_minimum_size && zero_copy_sends_.active())
+             concurrent_send_zero_copy(buffer, size, task, flags);
+           else
+             task.finish(concurrent_send_all(buffer, size, nullptr, task.cancellation(), flags));
+         })){
+        errno = ECANCELED;
+        task.finish(-1);
+      }
+      return task;
+    }
+
+    bool server::send_all_concurrently(const void *buffer, std::size_t *size, bool *breaker,
+                                       const int flags){
+      if(!connected_.load() || *size == 0){
+        *size = 0;
+        return false;
+      }
+
+      if(!send_worker_.post([this, buffer, size, breaker, flags]{
+           const ssize_t sent = concurrent_send_all(buffer, *size, breaker, nullptr, flags);
+           *size = sent > 0 ? static_cast<std::size_t>(sent) : 0;
+         })){
+        *size = 0;
+        return false;
+      }
+      return true;
+    }
+
+    operation server::send_async(const void *buffer, const std::size_t size,
+                                 const operation::completion &on_complete, const int flags){
+      operation task(on_complete);
+      if(!connected_.load() || size == 0){
+        task.finish(0);
+        return task;
+      }
+
+      if(!send_worker_.post([this, buffer, size, flags, task]() mutable{
+           task.finish(concurrent_send(buffer, size, task.cancellation(), flags));
+         })){
+        errno = ECANCELED;
+        task.finish(-1);
+      }
+      return task;
+    }
+
+    bool server::send_channel(const std::uint8_t channel, const void *buffer,
+                              const std::size_t size){
+      if(!connected_.load())
+        return false;
+
+      bool start;
+      if(!channels_.add(channel, buffer, size, &start))
+        return false;
+      if(start && !send_worker_.post([this]{ concurrent_send_channels(); })){
+        errno = ECANCELED;
+        return false;
+      }
+      metrics_.messages_sent();
+      return true;
+    }
+
+    bool server::send_concurrently(const void *buffer, std::size_t *size, const int flags){
+      if(!connected_.load() || *size == 0){
+        *size = 0;
+        return false;
+      }
+
+      if(!send_worker_.post([this, buffer, size, flags]{
+           const ssize_t sent = concurrent_send(buffer, *size, nullptr, flags);
+           *size = sent > 0 ? static_cast<std::size_t>(sent) : 0;
+         })){
+        *size = 0;
+        return false;
+      }
+      return true;
+    }
+
+    int server::send_datagrams(const datagram *datagrams, const std::size_t count,
+                               const int flags){
+      if(!connected_.load() || count == 0)
+        return 0;
+      if(is_tcp_){
+        errno = EOPNOTSUPP;
+        return -1;
+      }
+
+      mmsghdr headers[max_datagram_batch];
+      iovec parts[max_datagram_batch];
+      std::size_t total_sent{0};
+      std::uint32_t error_counter{0};
+
+      while(total_sent < count){
+        const std::size_t left{count - total_sent};
+        const std::size_t batch{left < max_datagram_batch ? left : max_datagram_batch};
+        for(std::size_t i{0}; i < batch; ++i){
+          const datagram &current = datagrams[total_sent + i];
+          parts[i] = {current.buffer, current.size};
+          headers[i] = mmsghdr{};
+          headers[i].msg_hdr.msg_iov = &parts[i];
+          headers[i].msg_hdr.msg_iovlen = 1;
+          headers[i].msg_hdr.msg_name = destination();
+          headers[i].msg_hdr.msg_namelen = destination_length();
+        }
+
+        const int sent = ::sendmmsg(connected_fd_, headers, static_cast<unsigned int>(batch),
+                                    flags);
+        if(sent < 0){
+          // Waits until the socket is ready again, it fails after the max intents
+          if(!retry(connected_fd_, POLLOUT, &error_counter, nullptr))
+            return total_sent > 0 ? static_cast<int>(total_sent) : -1;
+          continue;
+        }
+        std::size_t bytes{0};
+        for(int i{0}; i < sent; ++i) bytes += headers[i].msg_len;
+        metrics_.sent(static_cast<ssize_t>(bytes));
+        metrics_.messages_sent(static_cast<std::uint64_t>(sent));
+        total_sent += static_cast<std::size_t>(sent);
+      }
+      return static_cast<int>(total_sent);
+    }
+
+    ssize_t server::send_file(const int file_fd, const off_t offset, const std::size_t length,
+                              bool *breaker){
+      if(!connected_.load())
+        return 0;
+      if(!is_tcp_){
+        errno = EOPNOTSUPP;
+        return -1;
+      }
+
+      file_stream stream;
+      if(!stream.open(file_fd, offset, length)) return -1;
+
+      const std::uint64_t start{metrics_.start()};
+      ssize_t sent_size;
+      std::uint32_t error_counter{0};
+      bool never{false};
+      if(breaker == nullptr) breaker = &never;
+
+      while(!stream.finished() && !(*breaker)){
+        sent_size = stream.send(connected_fd_);
+        // The file or pipe ended before sending `length` bytes
+        if(sent_size == 0) break;
+
+        if(sent_size < 0){
+          // Waits until the socket (or the empty pipe) is ready again, it fails after the
+          // max intents
+          short events;
+          const int waiting{stream.waiting_fd(connected_fd_, &events)};
+          if(!retry(waiting, events, &error_counter, nullptr))
+            return sent_size;
+          continue;
+        }
+      }
+      return metrics_.sent(static_cast<ssize_t>(stream.sent()), start);
+    }
+
+    operation server::send_file_async(const int file_fd, const off_t offset,
+                                      const std::size_t length,
+                                      const operation::completion &on_complete,
+                                      const file_progress &on_progress){
+      operation task(on_complete);
+      if(!connected_.load()){
+        task.finish(0);
+        return task;
+      }
+      if(!is_tcp_){
+        errno = EOPNOTSUPP;
+        task.finish(-1);
+        return task;
+      }
+
+      // Wrong descriptors and offsets are reported before posting the task
+      file_stream stream;
+      if(!stream.open(file_fd, offset, length)){
+        task.finish(-1);
+        return task;
+      }
+
+      if(!send_worker_.post([this, stream, task, on_progress]() mutable{
+           concurrent_send_file(&stream, task, on_progress);
+         })){
+        errno = ECANCELED;
+        task.finish(-1);
+      }
+      return task;
+    }
+
+    ssize_t server::send_message(const void *buffer, const std::uint32_t size, bool *breaker,
+                                 const int flags){
+      if(!connected_.load())
+        return 0;
+
+      std::uint8_t header[message_buffer::header_size];
+      message_buffer::write_header(header, size);
+      iovec parts[3]{{header, sizeof(header)}, {const_cast<void*>(buffer), size}, {}};
+      std::size_t count{2};
+
+      // The compressed message and its header replace the original one
+      std::unique_lock<std::mutex> guard(compression_mutex_, std::defer_lock);
+      if(negotiated_compression_ != compression_algorithm::none){
+        guard.lock();
+        if(!compression_context_.compress(buffer, size, compression_.threshold, parts + 1))
+          return -1;
+        message_buffer::write_header(header, static_cast<std::uint32_t>(parts[1].iov_len
+                                                                        + parts[2].iov_len));
+        count = 3;
+      }
+
+      const ssize_t sent = send_all(parts, count, breaker, flags);
+      if(sent <= 0) return sent;
+      metrics_.messages_sent();
+
+      const std::size_t total{sizeof(header) + parts[1].iov_len + parts[2].iov_len};
+      if(count == 3)
+        return static_cast<std::size_t>(sent) == total ? static_cast<ssize_t>(size) : 0;
+      return sent > static_cast<ssize_t>(sizeof(header))
+             ? sent - static_cast<ssize_t>(sizeof(header)) : 0;
+    }
+
+    bool server::send_message_queued(const void *buffer, const std::uint32_t size){
+      if(!connected_.load())
+        return false;
+
+      std::uint8_t header[message_buffer::header_size + compression_header_size];
+      message_buffer::write_header(header, size);
+      std::size_t header_size{message_buffer::header_size};
+      iovec parts[2]{{}, {const_cast<void*>(buffer), size}};
+
+      // The compression's header is copied together with the message's one
+      std::unique_lock<std::mutex> guard(compression_mutex_, std::defer_lock);
+      if(negotiated_compression_ != compression_algorithm::none){
+        guard.lock();
+        if(!compression_context_.compress(buffer, size, compression_.threshold, parts))
+          return false;
+        std::memcpy(header + header_size, parts[0].iov_base, parts[0].iov_len);
+        header_size += parts[0].iov_len;
+        message_buffer::write_header(header, static_cast<std::uint32_t>(parts[0].iov_len
+                                                                        + parts[1].iov_len));
+      }
+
+      bool start;
+      if(!send_queue_.add(header, header_size, parts[1].iov_base, parts[1].iov_len, &start))
+        return false;
+      if(start && !send_worker_.post([this]{ concurrent_send_queue(); })){
+        errno = ECANCELED;
+        return false;
+      }
+      metrics_.messages_sent();
+      return true;
+    }
+
+    bool server::send_queued(const void *buffer, const std::size_t size){
+      if(!connected_.load())
+        return false;
+
+      bool start;
+      if(!send_queue_.add(nullptr, 0, buffer, size, &start))
+        return false;
+      if(start && !send_worker_.post([this]{ concurrent_send_queue(); })){
+        errno = ECANCELED;
+        return false;
+      }
+      return true;
     }
 
-    bool server::send_all_concurrently(const void *buffer, std::size_t *size, bool *breaker,
-                                       const int flags){
-      if(!connected_.load() || *size == 0){
-        *size = 0;
+    bool server::send_reliable(const void *buffer, const std::size_t size, const delivery mode){
+      if(!connected_.load())
+        return false;
+      if(is_tcp_ || multi_peer_){
+        errno = EOPNOTSUPP;
         return false;
       }
+      if(!reliable_.send(buffer, size, mode))
+        return false;
+
+      // Without a thread in receive_reliable() the acknowledgements are read here
+      std::unique_lock<std::mutex> receiving(reliable_receive_mutex_, std::try_to_lock);
+      if(receiving.owns_lock() && wait_for_socket(socket_fd_, POLLIN, 0) > 0
+         && !receive_reliable_datagrams())
+        return false;
 
-      std::thread(&server::concurrent_send_all, this, buffer, size, breaker, flags).detach();
+      flush_reliable();
       return true;
     }
 
-    bool server::send_concurrently(const void *buffer, std::size_t *size, const int flags){
-      if(!connected_.load() || *size == 0){
-        *size = 0;
-        return false;
+    ssize_t server::send_to(const int client_fd, const void *buffer, const std::size_t size,
+                            const int flags){
+      if(!connected_.load() || size == 0)
+        return 0;
+
+      return metrics_.sent(::send(client_fd, buffer, size, flags));
+    }
+
+    ssize_t server::send_to_peer(const int peer, const void *buffer, const std::size_t size,
+                                 const int flags){
+      if(!connected_.load() || size == 0)
+        return 0;
+
+      if(!multi_peer_){
+        errno = EOPNOTSUPP;
+        return -1;
       }
 
-      std::thread(&server::concurrent_send, this, buffer, size, flags).detach();
-      return true;
+      sockaddr_storage address;
+      socklen_t length;
+      {
+        std::lock_guard<std::mutex> guard(peers_mutex_);
+        if(!peers_.get(peer, &address, &length)){
+          errno = ENOENT;
+          return -1;
+        }
+      }
+      return metrics_.sent(::sendto(socket_fd_, buffer, size, flags,
+                                    reinterpret_cast<const sockaddr*>(&address), length));
     }
 
     int server::time_to_reconnect(){
-      return static_cast<int>(reconnection_time_.count());
+      return reconnection_.initial_delay;
     }
 
     void server::time_to_reconnect(const int waiting_time_in_milliseconds){
-      if(waiting_time_in_milliseconds > 0)
-        reconnection_time_ = std::chrono::duration<long, std::milli>(
-              std::chrono::milliseconds(waiting_time_in_milliseconds)
-            );
+      if(waiting_time_in_milliseconds > 0){
+        reconnection_.initial_delay = waiting_time_in_milliseconds;
+        if(reconnection_.maximum_delay < waiting_time_in_milliseconds)
+          reconnection_.maximum_delay = waiting_time_in_milliseconds;
+      }
+    }
+
+    bool server::zero_copy(){
+      return zero_copy_.load();
+    }
+
+    bool server::zero_copy(const bool enable){
+      zero_copy_.store(enable);
+      // Changing the current connection, the next ones are changed when connected
+      if(!connected_.load() || !is_tcp_ || connected_fd_ < 0)
+        return true;
+
+      if(enable && !set_zero_copy(connected_fd_, true)){
+        zero_copy_sends_.set_active(false);
+        return false;
+      }
+      // The option stays in the socket, so the pending sends still get their notifications
+      zero_copy_sends_.set_active(enable);
+      return true;
     }
 
     // :::::::::::::::::::::::::::::::::::: PRIVATE FUNCTIONS ::::::::::::::::::::::::::::::::::::
@@ -333,6 +1676,13 @@ namespace ramrod {
       if(::close(socket_fd_) == -1)
         rr::perror("Connection cannot be closed");
 
+      // Nobody else could bind to the local socket's path while the file exists
+      if(!local_path_.empty()){
+        if(::unlink(local_path_.c_str()) == -1)
+          rr::perror("Local socket cannot be deleted");
+        local_path_.clear();
+      }
+
       socket_fd_ = -1;
       return true;
     }
@@ -367,78 +1717,71 @@ namespace ramrod {
       if(connected_.load()) return;
 
       connecting_.store(true);
+      negotiated_compression_ = compression_algorithm::none;
       int status;
-      struct addrinfo hints;
 
-      std::memset(&hints, 0, sizeof(addrinfo));               // make sure the struct is empty
-      hints.ai_family   = AF_UNSPEC;                          // don't care if IPv4 or IPv6
-      hints.ai_socktype = is_tcp_ ? SOCK_STREAM : SOCK_DGRAM; // UDP or TCP socket
-      hints.ai_flags    = AI_PASSIVE;                         // Fill in my Ip information for me
+      // Retrying in a loop until it binds, it is cancelled or the intents are exhausted
+      while(true){
+        // The addresses are resolved again only when they expire, see reconnection_policy
+        const addrinfo *results = addresses_.resolve(ip_, port_,
+                                                     is_tcp_ ? SOCK_STREAM : SOCK_DGRAM,
+                                                     AI_PASSIVE, reconnection_.address_ttl,
+                                                     &status);
+        if(results == nullptr)
+          rr::formatted("Error: getaddrinfo (%s)\n", rr::message::error, ::gai_strerror(status));
+
+        // loop through all the results and bind to the first we can
+        for(client_ = results; client_ != nullptr; client_ = client_->ai_next){
+          // Making a socket
+          if((socket_fd_ = ::socket(client_->ai_family, client_->ai_socktype,
+                                    client_->ai_protocol)) == -1){
+            rr::perror("Selecting socket");
+            continue;
+          }
 
-      // first, load up address structs with getaddrinfo():
-      if((status = ::getaddrinfo(ip_.c_str(), std::to_string(port_).c_str(),
-                                 &hints, &results_)) != 0){
-        rr::formatted("Error: getaddrinfo (%s)\n", rr::message::error, ::gai_strerror(status));
-        return;
-      }
+          // Some options only work before binding, the failed ones are reported but not fatal
+          apply_socket_options(socket_fd_, options_);
 
-      // loop through all the results and bind to the first we can
-      for(client_ = results_; client_ != nullptr; client_ = client_->ai_next){
-        // Making a socket
-        if((socket_fd_ = ::socket(client_->ai_family, client_->ai_socktype,
-                                  client_->ai_protocol)) == -1){
-          rr::perror("Selecting socket");
-          continue;
-        }
+          // The file of a local socket outlives a crashed server
+          if(client_->ai_family == AF_UNIX)
+            remove_stale_local_socket(client_->ai_addr, client_->ai_addrlen);
 
-        if(::setsockopt(socket_fd_, SOL_SOCKET, SO_REUSEADDR, &status, sizeof(int)) == -1){
-          rr::perror("Setting socket options");
-          ::close(socket_fd_);
-          return;
-        }
+          // Binding the socket to the port
+          if(::bind(socket_fd_, client_->ai_addr, client_->ai_addrlen) == -1){
+            rr::perror("Binding socket");
+            ::close(socket_fd_);
+            continue;
+          }
 
-        // Binding the socket to the port
-        if(::bind(socket_fd_, client_->ai_addr, client_->ai_addrlen) == -1){
-          rr::perror("Binding socket");
-          ::close(socket_fd_);
-          continue;
+          const sockaddr_un *local = reinterpret_cast<const sockaddr_un*>(client_->ai_addr);
+          if(client_->ai_family == AF_UNIX && local->sun_path[0] != '\0')
+            local_path_ = local->sun_path;
+          break;
         }
-        break;
-      }
-
-      if(is_tcp_){
-        ::freeaddrinfo(results_); // all done with this structure
-        results_ = nullptr;
-      }
-
-      if(client_ == nullptr){
-        if(results_) freeaddrinfo(results_);
-        results_ = nullptr;
+        if(client_ != nullptr) break;
 
-        rr::perror("Server failed to bind");
+        socket_fd_ = -1;
+        if(results != nullptr) rr::perror("Server failed to bind");
+        metrics_.connection_failed();
         if(++current_intent_ > max_intents_){
+          metrics_.intents_exhausted();
           rr::error("Max number of reconnections has been reached "
                     "and therefore failed to connect.");
+          connecting_.store(false);
           return;
         }
-        rr::attention() << "Trying reconnection in " << reconnection_time_.count() / 1000
-                        << " seconds... (#" << current_intent_ << ")" << rr::endl;
-        std::this_thread::sleep_for(reconnection_time_);
+
+        const std::chrono::milliseconds delay{backoff_delay(reconnection_, current_intent_)};
+        rr::attention() << "Trying reconnection in " << delay.count() << " milliseconds... (#"
+                        << current_intent_ << ")" << rr::endl;
 
         // Terminates the pending connection in case disconnect() is called:
-        if(terminate_concurrent_.load()){
+        if(!wait_to_reconnect(delay, terminate_concurrent_)){
           connecting_.store(false);
           return;
         }
 
         rr::attention("Reconnecting!");
-
-        if(wait)
-          concurrent_connector(true);
-        else
-          std::thread(&server::concurrent_connector, this, false).detach();
-
-        return;
       }
 
       if(is_tcp_)
@@ -458,6 +1801,34 @@ namespace ramrod {
         return;
       }
 
+      // In multi-peer mode every datagram tells who sent it, there is no handshake
+      if(!is_tcp_ && multi_peer_){
+        {
+          std::lock_guard<std::mutex> guard(groups_mutex_);
+          for(const std::pair<std::string, std::string> &group : groups_)
+            if(!join_multicast_group(socket_fd_, group.first, group.second))
+              rr::perror("Joining multicast group");
+        }
+        client_ = nullptr;
+        connected_fd_ = socket_fd_;
+        if(non_blocking_ && !set_non_blocking(connected_fd_, true))
+          rr::perror("Setting socket as non-blocking");
+        // Datagrams are always copied
+        zero_copy_sends_.reset(false);
+        messages_.clear();
+        channel_messages_.clear();
+        reliable_.reset();
+        metrics_.connected(0);
+        terminate_receive_.store(false);
+        terminate_send_.store(false);
+        connecting_.store(false);
+        connected_.store(true);
+#ifdef VERBOSE
+        rr::attention("Waiting for datagrams from any peer!");
+#endif
+        return;
+      }
+
       // If is UDP we wait for an incoming message that contains the client information
       if(!is_tcp_){
         sockaddr_storage receiver;
@@ -480,9 +1851,23 @@ namespace ramrod {
 #endif
           return;
         }
-        std::memcpy(client_->ai_addr, &receiver, addrlen);
-        client_->ai_addrlen = addrlen;
+        // The resolved addresses stay in the cache, the client's one is kept apart
+        peer_ = *client_;
+        peer_.ai_canonname = nullptr;
+        peer_.ai_next = nullptr;
+        std::memcpy(&peer_address_, &receiver, addrlen);
+        peer_.ai_addr = reinterpret_cast<sockaddr*>(&peer_address_);
+        peer_.ai_addrlen = addrlen;
+        client_ = &peer_;
         connected_fd_ = socket_fd_;
+        if(non_blocking_ && !set_non_blocking(connected_fd_, true))
+          rr::perror("Setting socket as non-blocking");
+        // Datagrams are always copied
+        zero_copy_sends_.reset(false);
+        messages_.clear();
+        channel_messages_.clear();
+        reliable_.reset();
+        metrics_.connected(0);
         connected_.store(true);
 #ifdef VERBOSE
         rr::attention("Connection established!");
@@ -490,11 +1875,20 @@ namespace ramrod {
         return;
       }
 
+      // In multi-client mode the event loop accepts all the incomming connections
+      if(reactor_){
+        reactor_start();
+        return;
+      }
+
       // In case is TCP then we must accept an incomming connection
       if(wait)
         concurrent_connection();
       else
-        std::thread(&server::concurrent_connection, this).detach();
+        std::thread([this, options = io_thread("accept")]{
+          configure_current_thread(options);
+          concurrent_connection();
+        }).detach();
     }
 
     void server::concurrent_connection(){
@@ -514,6 +1908,25 @@ namespace ramrod {
 #ifdef VERBOSE
         rr::attention("Connection established!");
 #endif
+        // Accepted sockets inherit most options, but not all of them in every kernel
+        apply_socket_options(connected_fd_, options_);
+        if(!negotiate()){
+          rr::perror("Negotiating compression");
+          continue;
+        }
+        if(non_blocking_ && !set_non_blocking(connected_fd_, true))
+          rr::perror("Setting socket as non-blocking");
+        // Numbering of the zero-copy sends starts again with every socket
+        bool zero_copy_enabled{false};
+        if(is_tcp_ && zero_copy_.load()){
+          zero_copy_enabled = set_zero_copy(connected_fd_, true);
+          if(!zero_copy_enabled) rr::perror("Enabling zero-copy sending");
+        }
+        zero_copy_sends_.reset(zero_copy_enabled);
+        messages_.clear();
+        channel_messages_.clear();
+        reliable_.reset();
+        metrics_.connected(0);
         connected_.store(true);
         connecting_.store(false);
         terminate_send_.store(false);
@@ -524,162 +1937,520 @@ namespace ramrod {
       }
     }
 
-    void server::concurrent_receive(void *buffer, std::size_t *size, const int flags){
+    ssize_t server::concurrent_receive(void *buffer, const std::size_t size,
+                                       const std::atomic<bool> *cancel, const int flags){
+      const std::uint64_t start{metrics_.start()};
       ssize_t received{0};
       std::uint32_t error_counter{0};
 
       while(true){
+        if(terminate_receive_.load() || (cancel && cancel->load())){
+          errno = ECANCELED;
+          return -1;
+        }
+
         if(is_tcp_)
-          received = ::recv(connected_fd_, buffer, *size, flags);
+          received = ::recv(connected_fd_, buffer, size, flags);
         else{
-          socklen_t addr_len;
-          received = ::recvfrom(socket_fd_, buffer, *size, flags, &incoming_, &addr_len);
+          socklen_t addr_len = sizeof(incoming_);
+          received = ::recvfrom(socket_fd_, buffer, size, flags,
+                                reinterpret_cast<sockaddr*>(&incoming_), &addr_len);
           // Ignores data that does not come from the same client
-          if(std::strncmp(client_->ai_addr->sa_data, incoming_.sa_data, addr_len) != 0)
+          if(received >= 0 && !from_client(incoming_, addr_len)){
+            // It is not an error, it only waits for the next datagram
+            errno = EAGAIN;
             received = -1;
+          }
         }
 
-        if(received == 0) break;
-
         if(received < 0){
-  #ifdef VERBOSE
-          rr::perror("Receiving data");
-  #endif
-          if(++error_counter > max_intents_){
-            *size = 0;
-            return;
-          }
-
-          // This will try to receive the same data than the last time
-          std::this_thread::sleep_for(std::chrono::milliseconds(10));
+          // Waits until the socket is ready again, it fails after the max intents
+          if(!retry(is_tcp_ ? connected_fd_ : socket_fd_, POLLIN, &error_counter, cancel))
+            return received;
           continue;
         }
-        break;
+        return metrics_.received(received, start);
       }
-      *size = static_cast<std::size_t>(received);
-      return;
     }
 
-    void server::concurrent_receive_all(void *buffer, std::size_t *size, bool *breaker,
-                                        const int flags){
+    ssize_t server::concurrent_receive_all(void *buffer, const std::size_t size, bool *breaker,
+                                           const std::atomic<bool> *cancel, const int flags){
+      const std::uint64_t start{metrics_.start()};
       std::size_t total_received{0};
-      std::size_t bytes_left = *size;
+      std::size_t bytes_left = size;
       ssize_t received_size;
       std::uint32_t error_counter{0};
       socklen_t addr_len;
       bool never{false};
       if(breaker == nullptr) breaker = &never;
 
-      while(total_received < *size && !terminate_receive_.load() && !(*breaker)){
+      while(total_received < size && !terminate_receive_.load() && !(*breaker)
+            && !(cancel && cancel->load())){
         if(is_tcp_)
           received_size = ::recv(connected_fd_, (std::uint8_t*)buffer + total_received,
                                  bytes_left, flags);
         else{
+          addr_len = sizeof(incoming_);
           received_size = ::recvfrom(socket_fd_, (std::uint8_t*)buffer + total_received,
-                                     bytes_left, flags, &incoming_, &addr_len);
+                                     bytes_left, flags,
+                                     reinterpret_cast<sockaddr*>(&incoming_), &addr_len);
           // Ignores data that does not come from the same client
-          if(std::strncmp(client_->ai_addr->sa_data, incoming_.sa_data, addr_len) != 0)
+          if(received_size >= 0 && !from_client(incoming_, addr_len))
             continue;
         }
 
-        if(received_size == 0){
-          *size = 0;
-          return;
-        }
+        if(received_size == 0)
+          return 0;
 
         if(received_size < 0){
-#ifdef VERBOSE
-          rr::perror("Receiving data");
-#endif
-          // There is an error and returns after the max intents have been reached
-          if(++error_counter > max_intents_){
-            *size = 0;
-            return;
-          }
-
-          // This will try to receive the same data than the last time
-          std::this_thread::sleep_for(std::chrono::milliseconds(10));
+          // Waits until the socket is ready again, it fails after the max intents
+          if(!retry(is_tcp_ ? connected_fd_ : socket_fd_, POLLIN, &error_counter, cancel))
+            return received_size;
           continue;
         }
         total_received += static_cast<std::size_t>(received_size);
         bytes_left -= static_cast<std::size_t>(received_size);
       }
-      *size = total_received;
+
+      if(total_received == 0 && size > 0){
+        errno = ECANCELED;
+        return -1;
+      }
+      return metrics_.received(static_cast<ssize_t>(total_received), start);
     }
 
-    void server::concurrent_send(const void *buffer, std::size_t *size, const int flags){
+    void server::concurrent_receive_leased(buffer_pool *pool, const std::size_t size,
+                                           const bool all, operation task,
+                                           const lease_completion &on_complete, const int flags){
+      buffer_lease buffer = pool->acquire();
+      ssize_t result{-1};
+      if(!buffer.is_valid())
+        errno = ENOMEM;
+      else if(all)
+        result = concurrent_receive_all(buffer.data(), size, nullptr, task.cancellation(), flags);
+      else
+        result = concurrent_receive(buffer.data(), size, task.cancellation(), flags);
+      buffer.size(result > 0 ? static_cast<std::size_t>(result) : 0);
+
+      // The completion could change errno, which is saved when the operation finishes
+      const int error{errno};
+      if(on_complete) on_complete(std::move(buffer), result);
+      errno = error;
+      task.finish(result);
+    }
+
+    ssize_t server::concurrent_send(const void *buffer, const std::size_t size,
+                                    const std::atomic<bool> *cancel, const int flags){
+      const std::uint64_t start{metrics_.start()};
       std::uint32_t error_counter{0};
       ssize_t sent{0};
 
       while(true){
-        sent = ::sendto(connected_fd_, buffer, *size, flags,
-                        client_->ai_addr, client_->ai_addrlen);
+        if(terminate_send_.load() || (cancel && cancel->load())){
+          errno = ECANCELED;
+          return -1;
+        }
 
-        if(sent == 0) break;
+        // The TCP socket is already connected, only the datagrams need the destination
+        sent = ::sendto(connected_fd_, buffer, size, flags, destination(),
+                        destination_length());
 
         if(sent < 0){
-#ifdef VERBOSE
-          rr::perror("Sending data");
-#endif
-          if(++error_counter > max_intents_){
-            *size = 0;
-            return;
-          }
-
-          // This will try to receive the same data than the last time
-          std::this_thread::sleep_for(std::chrono::milliseconds(10));
+          // Waits until the socket is ready again, it fails after the max intents
+          if(!retry(connected_fd_, POLLOUT, &error_counter, cancel))
+            return sent;
           continue;
         }
-        break;
+        return metrics_.sent(sent, start);
       }
-      *size = static_cast<std::size_t>(sent);
-      return;
     }
 
-    void server::concurrent_send_all(const void *buffer, std::size_t *size, bool *breaker,
-                                     const int flags){
+    ssize_t server::concurrent_send_all(const void *buffer, const std::size_t size, bool *breaker,
+                                        const std::atomic<bool> *cancel, const int flags,
+                                        std::uint32_t *sends){
+      const std::uint64_t start{metrics_.start()};
       std::size_t total_sent{0};
-      std::size_t bytes_left = *size;
+      std::size_t bytes_left = size;
       ssize_t sent_size;
       std::uint32_t error_counter{0};
       bool never{false};
       if(breaker == nullptr) breaker = &never;
 
-      while(total_sent < *size && !terminate_send_.load() && !(*breaker)){
+      while(total_sent < size && !terminate_send_.load() && !(*breaker)
+            && !(cancel && cancel->load())){
+        // The TCP socket is already connected, only the datagrams need the destination
         sent_size = ::sendto(connected_fd_, (const std::uint8_t*)buffer + total_sent,
-                             bytes_left, flags, client_->ai_addr, client_->ai_addrlen);
-        if(sent_size == 0){
-          *size = 0;
-          return;
-        }
+                             bytes_left, flags, destination(), destination_length());
+        if(sent_size == 0)
+          return 0;
 
         if(sent_size < 0){
+          // Waits until the socket is ready again, it fails after the max intents
+          if(!retry(connected_fd_, POLLOUT, &error_counter, cancel))
+            return sent_size;
+          continue;
+        }
+        if(sends) ++(*sends);
+        total_sent += static_cast<std::size_t>(sent_size);
+        bytes_left -= static_cast<std::size_t>(sent_size);
+      }
+
+      if(total_sent == 0 && size > 0){
+        errno = ECANCELED;
+        return -1;
+      }
+      return metrics_.sent(static_cast<ssize_t>(total_sent), start);
+    }
+
+    void server::concurrent_send_channels(){
+      iovec parts[channel_scheduler::max_parts];
+      std::size_t count;
+      // One chunk at a time, so a more urgent message queued meanwhile is the next one
+      while((count = channels_.next(parts)) > 0){
+        const bool failed{send_all(parts, count, nullptr, MSG_NOSIGNAL) < 0};
 #ifdef VERBOSE
-          rr::perror("Sending data");
+        if(failed) rr::perror("Sending channel messages");
 #endif
-          // There is an error and returns after the max intents have been reached
-          if(++error_counter > max_intents_){
-            *size = 0;
+        channels_.sent(failed);
+      }
+    }
+
+    void server::concurrent_send_file(file_stream *stream, operation task,
+                                      const file_progress &on_progress){
+      const std::uint64_t start{metrics_.start()};
+      const std::atomic<bool> *cancel{task.cancellation()};
+      ssize_t sent_size;
+      std::uint32_t error_counter{0};
+
+      while(!stream->finished() && !terminate_send_.load() && !cancel->load()){
+        sent_size = stream->send(connected_fd_);
+        // The file or pipe ended before sending `length` bytes
+        if(sent_size == 0) break;
+
+        if(sent_size < 0){
+          // Waits until the socket (or the empty pipe) is ready again, it fails after the
+          // max intents
+          short events;
+          const int waiting{stream->waiting_fd(connected_fd_, &events)};
+          if(!retry(waiting, events, &error_counter, cancel)){
+            task.finish(-1);
             return;
           }
+          continue;
+        }
+        task.progress(stream->sent());
+        if(on_progress) on_progress(stream->sent(), stream->total());
+      }
+
+      if(stream->sent() == 0 && !stream->finished()){
+        errno = ECANCELED;
+        task.finish(-1);
+        return;
+      }
+      task.finish(metrics_.sent(static_cast<ssize_t>(stream->sent()), start));
+    }
+
+    void server::concurrent_send_queue(){
+      iovec parts[send_queue::max_batch];
+      do{
+        std::size_t count;
+        while((count = send_queue_.take(parts)) > 0){
+          // Every message taken is written by the same writev(), a failure discards them
+          if(send_all(parts, count, nullptr, MSG_NOSIGNAL) < 0){
+#ifdef VERBOSE
+            rr::perror("Sending queued messages");
+#endif
+          }
+          send_queue_.release();
+        }
+      }while(send_queue_.keep_writing());
+    }
+
+    void server::concurrent_send_zero_copy(const void *buffer, const std::size_t size,
+                                           operation task, const int flags){
+      std::uint32_t sends{0};
+      const ssize_t result = concurrent_send_all(buffer, size, nullptr, task.cancellation(),
+                                                 flags | MSG_ZEROCOPY, &sends);
 
-          // This will try to receive the same data than the last time
-          std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      // The buffer is released by the reaper after the kernel reports all the sends
+      if(zero_copy_sends_.add(task, result, result < 0 ? errno : 0, sends)
+         && !zero_copy_worker_.post([this]{ concurrent_zero_copy_reaper(); }))
+        zero_copy_sends_.release();
+    }
+
+    void server::concurrent_zero_copy_reaper(){
+      while(zero_copy_sends_.keep_reaping()){
+        if(terminate_send_.load()){
+          zero_copy_sends_.release();
           continue;
         }
-        total_sent += static_cast<std::size_t>(sent_size);
-        bytes_left -= static_cast<std::size_t>(sent_size);
+
+        // The notifications are reported as an error condition, no event is needed
+        const int ready = wait_for_socket(connected_fd_, 0, 50);
+        if(ready == 0) continue;
+
+        // The socket is broken, the pending operations are cancelled
+        const int reaped = ready < 0 ? -1 : zero_copy_sends_.reap(connected_fd_);
+        if(reaped < 0){
+#ifdef VERBOSE
+          rr::perror("Reading zero-copy notifications");
+#endif
+          zero_copy_sends_.release();
+        }else if(reaped == 0){
+          // A hung up socket is always ready, waiting a slice avoids spinning on it
+          std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        }
+      }
+    }
+
+    void server::reactor_accept(){
+      struct sockaddr_storage their_addr;
+      socklen_t addr_size;
+      int client_fd;
+      constexpr std::uint32_t interest{EPOLLIN | EPOLLRDHUP | EPOLLONESHOT};
+
+      // The listening socket is non-blocking, accepts everything that is pending
+      while(true){
+        addr_size = sizeof(their_addr);
+        if((client_fd = ::accept4(socket_fd_, (struct sockaddr*)&their_addr, &addr_size,
+                                  SOCK_NONBLOCK | SOCK_CLOEXEC)) == -1){
+          if(errno == EINTR) continue;
+          if(errno != EAGAIN && errno != EWOULDBLOCK)
+            rr::perror("Accepting connection");
+          return;
+        }
+
+        apply_socket_options(client_fd, options_);
+
+        {
+          std::lock_guard<std::mutex> guard(clients_mutex_);
+          // It is busy until the worker calls the `connected` handler
+          clients_[client_fd] = client_state{interest, 0, true, true};
+          if(!loop_.add(client_fd, interest)){
+            clients_.erase(client_fd);
+            ::close(client_fd);
+            continue;
+          }
+        }
+        metrics_.connected(0);
+#ifdef VERBOSE
+        rr::attention("Connection established!");
+#endif
+        reactor_pool_->post([this, client_fd]{ reactor_dispatch(client_fd); });
+      }
+    }
+
+    void server::reactor_close_all(){
+      std::unordered_map<int, client_state> clients;
+      {
+        std::lock_guard<std::mutex> guard(clients_mutex_);
+        std::swap(clients, clients_);
+      }
+
+      for(const auto &client : clients){
+        if(handlers_.disconnected) handlers_.disconnected(client.first);
+        loop_.remove(client.first);
+        ::shutdown(client.first, SHUT_RDWR);
+        ::close(client.first);
+      }
+    }
+
+    void server::reactor_dispatch(const int client_fd){
+      std::uint32_t events;
+      bool fresh;
+
+      while(true){
+        {
+          std::lock_guard<std::mutex> guard(clients_mutex_);
+          auto found = clients_.find(client_fd);
+          if(found == clients_.end()) return;
+
+          events = found->second.pending;
+          fresh = found->second.fresh;
+          found->second.pending = 0;
+          found->second.fresh = false;
+        }
+
+        if(fresh && handlers_.connected) handlers_.connected(client_fd);
+        // Reading first, in this way the data sent before a hang up is not lost
+        if((events & EPOLLIN) && handlers_.readable) handlers_.readable(client_fd);
+
+        if(events & (EPOLLHUP | EPOLLRDHUP | EPOLLERR)){
+          if(handlers_.disconnected) handlers_.disconnected(client_fd);
+#ifdef VERBOSE
+          rr::attention("Client disconnected!");
+#endif
+          // Closing while locked, so the descriptor number is not reused before erasing it
+          std::lock_guard<std::mutex> guard(clients_mutex_);
+          loop_.remove(client_fd);
+          clients_.erase(client_fd);
+          ::close(client_fd);
+          return;
+        }
+
+        if((events & EPOLLOUT) && handlers_.writable) handlers_.writable(client_fd);
+
+        std::lock_guard<std::mutex> guard(clients_mutex_);
+        auto found = clients_.find(client_fd);
+        if(found == clients_.end()) return;
+        // Events that arrived while the handlers were running are handled by this same thread
+        if(found->second.pending != 0) continue;
+
+        found->second.busy = false;
+        loop_.modify(client_fd, found->second.interest);
+        return;
+      }
+    }
+
+    void server::reactor_event(const int fd, const std::uint32_t events){
+      if(fd == socket_fd_){
+        reactor_accept();
+        return;
+      }
+
+      {
+        std::lock_guard<std::mutex> guard(clients_mutex_);
+        auto found = clients_.find(fd);
+        if(found == clients_.end()) return;
+
+        found->second.pending |= events;
+        if(found->second.busy) return;
+        found->second.busy = true;
+      }
+      reactor_pool_->post([this, fd]{ reactor_dispatch(fd); });
+    }
+
+    bool server::reactor_start(){
+      // accept() must never block the event loop
+      const int file_flags = ::fcntl(socket_fd_, F_GETFL, 0);
+      if(file_flags == -1 || ::fcntl(socket_fd_, F_SETFL, file_flags | O_NONBLOCK) == -1){
+        rr::perror("Setting listening socket as non-blocking");
+        connecting_.store(false);
+        return false;
+      }
+
+      thread_options workers{io_thread("work")};
+      thread_options loop{io_thread("loop")};
+      if(reactor_cpu_ >= 0) workers.cpus = loop.cpus = {reactor_cpu_};
+      reactor_pool_ = std::make_unique<worker_pool>(reactor_workers_, workers);
+
+      if(!loop_.start([this](const int fd, const std::uint32_t events){
+                        reactor_event(fd, events);
+                      }, loop)){
+        connecting_.store(false);
+        return false;
+      }
+
+      if(!loop_.add(socket_fd_, EPOLLIN)){
+        loop_.stop();
+        connecting_.store(false);
+        return false;
+      }
+
+      messages_.clear();
+      channel_messages_.clear();
+      reliable_.reset();
+      connected_.store(true);
+      connecting_.store(false);
+      terminate_concurrent_.store(true);
+#ifdef VERBOSE
+      rr::attention("Waiting for incomming connections!");
+#endif
+      return true;
+    }
+
+    sockaddr *server::destination() const{
+      // The TCP socket is already connected and the multi-peer mode has no single client
+      return is_tcp_ || client_ == nullptr ? nullptr : client_->ai_addr;
+    }
+
+    socklen_t server::destination_length() const{
+      return is_tcp_ || client_ == nullptr ? 0 : client_->ai_addrlen;
+    }
+
+    void server::flush_reliable(){
+      std::lock_guard<std::mutex> guard(reliable_send_mutex_);
+      send_reliable_batches(&reliable_, &reliable_outgoing_,
+                            [this](datagram *datagrams, const std::size_t count){
+                              return send_datagrams(datagrams, count, MSG_NOSIGNAL);
+                            });
+    }
+
+    bool server::from_client(const sockaddr_storage &address, const socklen_t length){
+      // Every sender is a peer in multi-peer mode, even if the table is full
+      if(multi_peer_){
+        std::lock_guard<std::mutex> guard(peers_mutex_);
+        peers_.add(address, length);
+        return true;
+      }
+
+      // Comparing the whole address, the family and port are part of it
+      return client_ != nullptr && length == client_->ai_addrlen
+             && std::memcmp(client_->ai_addr, &address, length) == 0;
+    }
+
+    thread_options server::io_thread(const char *role){
+      std::lock_guard<std::mutex> guard(io_threads_mutex_);
+      return thread_role(io_threads_, role);
+    }
+
+    bool server::negotiate(){
+      if(!is_tcp_ || compression_.algorithm == compression_algorithm::none) return true;
+
+      compression_algorithm agreed;
+      // Both devices must agree on the compression before the first message
+      if(!negotiate_compression(connected_fd_, compression_, false, io_timeout_, &agreed)
+         || !compression_context_.algorithm(agreed, compression_.level)){
+        ::close(connected_fd_);
+        connected_fd_ = -1;
+        return false;
+      }
+      negotiated_compression_ = agreed;
+      return true;
+    }
+
+    int server::next_message(const std::uint8_t **message, std::uint32_t *size, bool *breaker,
+                                 const int flags){
+      bool never{false};
+      if(breaker == nullptr) breaker = &never;
+
+      while(!(*breaker)){
+        const int status = messages_.next(message, size);
+        if(status > 0) return status;
+        if(status < 0){
+#ifdef VERBOSE
+          rr::error("Received message is bigger than the maximum message size");
+#endif
+          errno = EMSGSIZE;
+          return -1;
+        }
+
+        // Receives everything that is available, not only the missing part of the message
+        const std::size_t free_space = messages_.reserve();
+        // Every message completed by this reception gets its timestamp
+        const ssize_t received = options_.receive_timestamps || options_.hardware_timestamps
+                                 ? receive_timestamped(messages_.tail(), free_space,
+                                                       &message_timestamp_, flags)
+                                 : receive(messages_.tail(), free_space, flags);
+        if(received <= 0) return static_cast<int>(received);
+        messages_.commit(static_cast<std::size_t>(received));
       }
-      *size = total_sent;
+
+      errno = ECANCELED;
+      return -1;
     }
 
-    // :::::::::::::::::::::::::::::::::::: OUTTER FUNCTIONS :::::::::::::::::::::::::::::::::::
+    bool server::receive_reliable_datagrams(){
+      return receive_reliable_batch(&reliable_, &reliable_incoming_,
+                                    [this](datagram *datagrams, const std::size_t count){
+                                      return receive_datagrams(datagrams, count);
+                                    });
+    }
 
-    void signal_children_handler(const int /*signal*/){
-      // waitpid() might overwrite errno, so we save and restore it:
-      const int saved_errno = errno;
-      while(::waitpid(-1, nullptr, WNOHANG) > 0);
-      errno = saved_errno;
+    bool server::retry(const int fd, const short events, std::uint32_t *error_counter,
+                     const std::atomic<bool> *cancel){
+      return retry_transfer(fd, events, io_timeout_, max_intents_, error_counter, cancel,
+                            &metrics_);
     }
   } // namespace: network_communication
 } // namespace: ramrod
@@ -0,0 +1,152 @@
+#include "ramrod/network_communication/sharded_server.h"
+
+#include <cerrno>                      // for errno, ENOTCONN
+
+#include "ramrod/network_communication/thread_affinity.h"
+
+namespace ramrod {
+  namespace network_communication {
+    sharded_server::sharded_server() :
+      shards_(),
+      options_(),
+      io_threads_(),
+      binders_()
+    {
+      options_.reuse_port = true;
+    }
+
+    sharded_server::~sharded_server(){
+      disconnect();
+    }
+
+    std::size_t sharded_server::clients(){
+      std::size_t total{0};
+      for(std::unique_ptr<server> &current : shards_)
+        total += current->clients();
+      return total;
+    }
+
+    bool sharded_server::close_client(const int client_fd){
+      // Every shard only knows its own clients
+      for(std::unique_ptr<server> &current : shards_)
+        if(current->close_client(client_fd)) return true;
+      return false;
+    }
+
+    bool sharded_server::disconnect(){
+      bool disconnected{true};
+      for(std::unique_ptr<server> &current : shards_)
+        disconnected &= current->disconnect();
+      // A shard that is still binding would be used after being destroyed, the destructors
+      // disconnect again whatever these threads started after the first disconnect()
+      for(std::thread &binder : binders_) binder.join();
+      binders_.clear();
+      shards_.clear();
+      return disconnected;
+    }
+
+    thread_options sharded_server::io_threads(){
+      return io_threads_;
+    }
+
+    bool sharded_server::io_threads(const thread_options &new_options){
+      if(!validate_thread_options(new_options)) return false;
+      io_threads_ = new_options;
+
+      for(std::unique_ptr<server> &current : shards_)
+        current->io_threads(io_threads_);
+      return true;
+    }
+
+    bool sharded_server::is_connected(){
+      if(shards_.empty()) return false;
+
+      for(std::unique_ptr<server> &current : shards_)
+        if(!current->is_connected()) return false;
+      return true;
+    }
+
+    bool sharded_server::listen(const std::string &ip, const connection_handlers &handlers,
+                                const int port, std::size_t shards, const std::size_t workers,
+                                const bool pin, const bool concurrent){
+      disconnect();
+
+      // The shards stay in the CPUs reserved for the network, if there are any
+      const std::vector<int> cpus{io_threads_.cpus.empty() ? allowed_cpus() : io_threads_.cpus};
+      if(shards == 0) shards = cpus.empty() ? 1 : cpus.size();
+
+      bool started{true};
+      shards_.reserve(shards);
+      for(std::size_t i{0}; i < shards; ++i){
+        shards_.emplace_back(new server());
+        server &current = *shards_.back();
+        // Without SO_REUSEPORT in all of them only the first shard could bind
+        current.options(options_);
+        current.io_threads(io_threads_);
+
+        const int cpu{pin && !cpus.empty() ? cpus[i % cpus.size()] : -1};
+        // The shards bind in threads of this object, so disconnect() can wait for them
+        if(concurrent)
+          binders_.emplace_back([&current, ip, handlers, port, workers, cpu,
+                                 options = thread_role(io_threads_, "connect")]{
+            configure_current_thread(options);
+            current.listen(ip, handlers, port, workers, false, cpu);
+          });
+        else
+          started &= current.listen(ip, handlers, port, workers, false, cpu);
+      }
+      return started;
+    }
+
+    bool sharded_server::notify_writable(const int client_fd, const bool enable){
+      for(std::unique_ptr<server> &current : shards_)
+        if(current->notify_writable(client_fd, enable)) return true;
+      return false;
+    }
+
+    socket_options sharded_server::options(){
+      return shards_.empty() ? options_ : shards_.front()->options();
+    }
+
+    bool sharded_server::options(const socket_options &new_options){
+      options_ = new_options;
+      options_.reuse_port = true;
+
+      bool applied{true};
+      for(std::unique_ptr<server> &current : shards_)
+        applied &= current->options(options_);
+      return applied;
+    }
+
+    ssize_t sharded_server::receive_from(const int client_fd, void *buffer,
+                                         const std::size_t size, const int flags){
+      // The shard that accepted the client is connected and counts its traffic
+      server *current{owner(client_fd)};
+      return current == nullptr ? -1 : current->receive_from(client_fd, buffer, size, flags);
+    }
+
+    ssize_t sharded_server::send_to(const int client_fd, const void *buffer,
+                                    const std::size_t size, const int flags){
+      // The shard that accepted the client is connected and counts its traffic
+      server *current{owner(client_fd)};
+      return current == nullptr ? -1 : current->send_to(client_fd, buffer, size, flags);
+    }
+
+    server *sharded_server::shard(const std::size_t index){
+      return index < shards_.size() ? shards_[index].get() : nullptr;
+    }
+
+    std::size_t sharded_server::shards(){
+      return shards_.size();
+    }
+
+    // :::::::::::::::::::::::::::::::::::: PRIVATE FUNCTIONS ::::::::::::::::::::::::::::::::::::
+
+    server *sharded_server::owner(const int client_fd){
+      for(std::unique_ptr<server> &current : shards_)
+        if(current->has_client(client_fd)) return current.get();
+      errno = ENOTCONN;
+      return nullptr;
+    }
+  } // namespace: network_communication
+} // namespace: ramrod
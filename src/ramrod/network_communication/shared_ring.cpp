@@ -0,0 +1,296 @@
+#include "ramrod/network_communication/shared_ring.h"
+
+#include <algorithm>                   // for min
+#include <atomic>                      // for atomic, atomic_thread_fence
+#include <cerrno>                      // for errno, EBADF, EINVAL, EPIPE, ETIMEDOUT
+#include <chrono>                      // for steady_clock, nanoseconds
+#include <cstdint>                     // for uint32_t, uint64_t
+#include <cstring>                     // for memcpy
+#include <fcntl.h>                     // for O_CREAT, O_EXCL, O_RDWR
+#include <linux/futex.h>               // for FUTEX_WAIT, FUTEX_WAKE
+#include <new>                         // for placement new
+#include <sys/mman.h>                  // for mmap, munmap, shm_open, shm_unlink
+#include <sys/stat.h>                  // for fstat
+#include <sys/syscall.h>               // for SYS_futex
+#include <time.h>                      // for timespec
+#include <unistd.h>                    // for close, ftruncate, syscall
+
+#include "ramrod/network_communication/buffer_pool.h"
+
+namespace ramrod {
+  namespace network_communication {
+    // Both processes map this header before the ring's bytes
+    struct shared_ring::control {
+      std::atomic<std::uint64_t> magic;
+      std::uint64_t capacity;
+      std::atomic<std::uint32_t> closed;
+
+      // Written by the sender
+      alignas(cache_line_size) std::atomic<std::uint64_t> head;
+      std::atomic<std::uint32_t> data_signal;
+      std::atomic<std::uint32_t> sender_waiting;
+
+      // Written by the receiver
+      alignas(cache_line_size) std::atomic<std::uint64_t> tail;
+      std::atomic<std::uint32_t> space_signal;
+      std::atomic<std::uint32_t> receiver_waiting;
+    };
+
+    namespace {
+      using clock = std::chrono::steady_clock;
+
+      constexpr std::uint64_t ring_magic{0x72616D726F647267}; // "ramrodrg"
+      constexpr std::size_t header_size{4 * cache_line_size};
+
+      static_assert(sizeof(std::atomic<std::uint32_t>) == sizeof(std::uint32_t)
+                    && std::atomic<std::uint32_t>::is_always_lock_free,
+                    "The futex needs a plain 32 bit word");
+
+      std::string object_name(const std::string &name){
+        return name.empty() || name[0] != '/' ? "/" + name : name;
+      }
+
+      // Returns false if the time expired, the caller checks again the condition otherwise
+      bool wait(std::atomic<std::uint32_t> *signal, const std::uint32_t seen,
+                const clock::time_point *deadline){
+        timespec left{0, 0};
+        if(deadline != nullptr){
+          const auto remaining = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                   *deadline - clock::now()).count();
+          if(remaining <= 0) return false;
+          left.tv_sec = static_cast<time_t>(remaining / 1000000000);
+          left.tv_nsec = static_cast<long>(remaining % 1000000000);
+        }
+
+        // Not private, the other process waits in the same word
+        if(::syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(signal), FUTEX_WAIT, seen,
+                     deadline != nullptr ? &left : nullptr, nullptr, 0) == -1)
+          return errno != ETIMEDOUT;
+        return true;
+      }
+
+      void wake(std::atomic<std::uint32_t> *signal){
+        signal->fetch_add(1, std::memory_order_release);
+        ::syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(signal), FUTEX_WAKE, 1,
+                  nullptr, nullptr, 0);
+      }
+    } // namespace: anonymous
+
+    shared_ring::shared_ring() :
+      control_{nullptr},
+      data_{nullptr},
+      mapped_size_{0},
+      name_(),
+      creator_{false}
+    {}
+
+    shared_ring::~shared_ring(){
+      close();
+    }
+
+    std::size_t shared_ring::capacity(){
+      return control_ != nullptr ? static_cast<std::size_t>(control_->capacity) : 0;
+    }
+
+    void shared_ring::close(){
+      if(control_ == nullptr) return;
+
+      control_->closed.store(1);
+      wake(&control_->data_signal);
+      wake(&control_->space_signal);
+
+      ::munmap(control_, mapped_size_);
+      if(creator_) ::shm_unlink(name_.c_str());
+
+      control_ = nullptr;
+      data_ = nullptr;
+      mapped_size_ = 0;
+      name_.clear();
+      creator_ = false;
+    }
+
+    bool shared_ring::create(const std::string &name, const std::size_t capacity){
+      close();
+
+      std::size_t rounded{cache_line_size};
+      while(rounded < capacity) rounded <<= 1;
+
+      const std::string path{object_name(name)};
+      const int fd = ::shm_open(path.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+      if(fd == -1) return false;
+
+      if(::ftruncate(fd, static_cast<off_t>(header_size + rounded)) == -1
+         || !map(fd, header_size + rounded)){
+        const int error{errno};
+        ::close(fd);
+        ::shm_unlink(path.c_str());
+        errno = error;
+        return false;
+      }
+      ::close(fd);
+
+      new(control_) control();
+      control_->capacity = rounded;
+      // The magic number is the last value written, so open() never sees a half ring
+      control_->magic.store(ring_magic, std::memory_order_release);
+
+      name_ = path;
+      creator_ = true;
+      return true;
+    }
+
+    bool shared_ring::is_open(){
+      return control_ != nullptr;
+    }
+
+    bool shared_ring::open(const std::string &name){
+      close();
+
+      const std::string path{object_name(name)};
+      const int fd = ::shm_open(path.c_str(), O_RDWR, 0);
+      if(fd == -1) return false;
+
+      struct stat status;
+      if(::fstat(fd, &status) == -1
+         || static_cast<std::size_t>(status.st_size) <= header_size){
+        ::close(fd);
+        errno = EINVAL;
+        return false;
+      }
+
+      const bool mapped{map(fd, static_cast<std::size_t>(status.st_size))};
+      const int error{errno};
+      ::close(fd);
+      if(!mapped){
+        errno = error;
+        return false;
+      }
+
+      if(control_->magic.load(std::memory_order_acquire) != ring_magic
+         || header_size + control_->capacity != mapped_size_){
+        ::munmap(control_, mapped_size_);
+        control_ = nullptr;
+        data_ = nullptr;
+        mapped_size_ = 0;
+        errno = EINVAL;
+        return false;
+      }
+
+      name_ = path;
+      return true;
+    }
+
+    ssize_t shared_ring::receive(void *buffer, const std::size_t size, const int timeout){
+      if(control_ == nullptr){
+        errno = EBADF;
+        return -1;
+      }
+      if(size == 0) return 0;
+
+      const clock::time_point deadline{clock::now() + std::chrono::milliseconds(timeout)};
+      const std::uint64_t tail{control_->tail.load(std::memory_order_relaxed)};
+      std::uint64_t head{control_->head.load(std::memory_order_acquire)};
+
+      while(head == tail){
+        if(control_->closed.load()) return 0;
+
+        // Announcing the sleep before checking again, so the sender cannot miss it
+        const std::uint32_t seen{control_->data_signal.load(std::memory_order_acquire)};
+        control_->receiver_waiting.store(1);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        head = control_->head.load(std::memory_order_acquire);
+
+        bool expired{false};
+        if(head == tail && !control_->closed.load())
+          expired = !wait(&control_->data_signal, seen, timeout < 0 ? nullptr : &deadline);
+        control_->receiver_waiting.store(0, std::memory_order_relaxed);
+
+        if(expired){
+          errno = ETIMEDOUT;
+          return -1;
+        }
+        head = control_->head.load(std::memory_order_acquire);
+      }
+
+      const std::size_t ring_size{static_cast<std::size_t>(control_->capacity)};
+      const std::size_t length{std::min(size, static_cast<std::size_t>(head - tail))};
+      const std::size_t start{static_cast<std::size_t>(tail) & (ring_size - 1)};
+      const std::size_t first{std::min(length, ring_size - start)};
+
+      std::memcpy(buffer, data_ + start, first);
+      std::memcpy(static_cast<unsigned char*>(buffer) + first, data_, length - first);
+      control_->tail.store(tail + length, std::memory_order_release);
+
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      if(control_->sender_waiting.load(std::memory_order_relaxed))
+        wake(&control_->space_signal);
+      return static_cast<ssize_t>(length);
+    }
+
+    ssize_t shared_ring::send(const void *buffer, const std::size_t size, const int timeout){
+      if(control_ == nullptr){
+        errno = EBADF;
+        return -1;
+      }
+      if(size == 0) return 0;
+
+      const clock::time_point deadline{clock::now() + std::chrono::milliseconds(timeout)};
+      const std::uint64_t ring_size{control_->capacity};
+      const std::uint64_t head{control_->head.load(std::memory_order_relaxed)};
+      std::uint64_t tail{control_->tail.load(std::memory_order_acquire)};
+
+      while(true){
+        if(control_->closed.load()){
+          errno = EPIPE;
+          return -1;
+        }
+        if(head - tail < ring_size) break;
+
+        // Announcing the sleep before checking again, so the receiver cannot miss it
+        const std::uint32_t seen{control_->space_signal.load(std::memory_order_acquire)};
+        control_->sender_waiting.store(1);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        tail = control_->tail.load(std::memory_order_acquire);
+
+        bool expired{false};
+        if(head - tail >= ring_size && !control_->closed.load())
+          expired = !wait(&control_->space_signal, seen, timeout < 0 ? nullptr : &deadline);
+        control_->sender_waiting.store(0, std::memory_order_relaxed);
+
+        if(expired){
+          errno = ETIMEDOUT;
+          return -1;
+        }
+        tail = control_->tail.load(std::memory_order_acquire);
+      }
+
+      const std::size_t free_space{static_cast<std::size_t>(ring_size - (head - tail))};
+      const std::size_t length{std::min(size, free_space)};
+      const std::size_t start{static_cast<std::size_t>(head & (ring_size - 1))};
+      const std::size_t first{std::min(length, static_cast<std::size_t>(ring_size) - start)};
+
+      std::memcpy(data_ + start, buffer, first);
+      std::memcpy(data_, static_cast<const unsigned char*>(buffer) + first, length - first);
+      control_->head.store(head + length, std::memory_order_release);
+
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      if(control_->receiver_waiting.load(std::memory_order_relaxed))
+        wake(&control_->data_signal);
+      return static_cast<ssize_t>(length);
+    }
+
+    // :::::::::::::::::::::::::::::::::::: PRIVATE FUNCTIONS ::::::::::::::::::::::::::::::::::::
+
+    bool shared_ring::map(const int fd, const std::size_t size){
+      static_assert(sizeof(control) <= header_size, "The ring's header is too small");
+
+      void *memory = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+      if(memory == MAP_FAILED) return false;
+
+      control_ = static_cast<control*>(memory);
+      data_ = static_cast<unsigned char*>(memory) + header_size;
+      mapped_size_ = size;
+      return true;
+    }
+  } // namespace: network_communication
+} // namespace: ramrod
@@ -0,0 +1,102 @@
+#include "ramrod/network_communication/socket_options.h"
+
+#include <linux/net_tstamp.h>          // for SOF_TIMESTAMPING_RX_HARDWARE, SOF...
+#include <netinet/in.h>                // for IPPROTO_IP, IPPROTO_IPV6, IPPROTO_TCP
+#include <netinet/ip.h>                // for IP_TOS
+#include <netinet/tcp.h>               // for TCP_NODELAY, TCP_QUICKACK
+#include <sys/socket.h>                // for getsockopt, setsockopt, SOL_SOCKET
+
+#include "ramrod/console/perror.h"     // for perror, perror_stream
+#include "ramrod/network_communication/timestamping.h"
+
+namespace ramrod {
+  namespace network_communication {
+    namespace {
+      bool apply(const int fd, const int level, const int name, const int value,
+                 const char *description){
+        if(::setsockopt(fd, level, name, &value, sizeof(value)) != -1) return true;
+
+        rr::perror(description);
+        return false;
+      }
+
+      int read(const int fd, const int level, const int name){
+        int value{0};
+        socklen_t length{sizeof(value)};
+        if(::getsockopt(fd, level, name, &value, &length) == -1) return -1;
+        return value;
+      }
+    } // namespace: anonymous
+
+    bool apply_socket_options(const int fd, const socket_options &options){
+      const int family{read(fd, SOL_SOCKET, SO_DOMAIN)};
+      const bool is_tcp{read(fd, SOL_SOCKET, SO_PROTOCOL) == IPPROTO_TCP};
+      bool applied{true};
+
+      applied &= apply(fd, SOL_SOCKET, SO_REUSEADDR, options.reuse_address ? 1 : 0,
+                       "Setting SO_REUSEADDR");
+      if(options.reuse_port)
+        applied &= apply(fd, SOL_SOCKET, SO_REUSEPORT, 1, "Setting SO_REUSEPORT");
+      if(options.send_buffer > 0)
+        applied &= apply(fd, SOL_SOCKET, SO_SNDBUF, options.send_buffer, "Setting SO_SNDBUF");
+      if(options.receive_buffer > 0)
+        applied &= apply(fd, SOL_SOCKET, SO_RCVBUF, options.receive_buffer,
+                         "Setting SO_RCVBUF");
+      if(options.busy_poll > 0)
+        applied &= apply(fd, SOL_SOCKET, SO_BUSY_POLL, options.busy_poll,
+                         "Setting SO_BUSY_POLL");
+
+      // IP_TOS also changes the priority, so the explicit priority is applied after it
+      if(options.type_of_service >= 0){
+        if(family == AF_INET6)
+          applied &= apply(fd, IPPROTO_IPV6, IPV6_TCLASS, options.type_of_service,
+                           "Setting IPV6_TCLASS");
+        else
+          applied &= apply(fd, IPPROTO_IP, IP_TOS, options.type_of_service, "Setting IP_TOS");
+      }
+      if(options.priority >= 0)
+        applied &= apply(fd, SOL_SOCKET, SO_PRIORITY, options.priority, "Setting SO_PRIORITY");
+
+      // Only a socket that asked for the timestamps is changed, the others keep theirs
+      if(options.receive_timestamps || options.hardware_timestamps){
+        if(!enable_timestamping(fd, true, options.hardware_timestamps)){
+          rr::perror("Setting SO_TIMESTAMPING");
+          applied = false;
+        }
+      }
+
+      // Writing 0 would disable the quick acknowledgements of the start of the connection
+      if(is_tcp && options.no_delay)
+        applied &= apply(fd, IPPROTO_TCP, TCP_NODELAY, 1, "Setting TCP_NODELAY");
+      if(is_tcp && options.quick_ack)
+        applied &= apply(fd, IPPROTO_TCP, TCP_QUICKACK, 1, "Setting TCP_QUICKACK");
+      return applied;
+    }
+
+    socket_options read_socket_options(const int fd){
+      const int family{read(fd, SOL_SOCKET, SO_DOMAIN)};
+      const bool is_tcp{read(fd, SOL_SOCKET, SO_PROTOCOL) == IPPROTO_TCP};
+      socket_options options;
+
+      options.reuse_address = read(fd, SOL_SOCKET, SO_REUSEADDR) > 0;
+      options.reuse_port = read(fd, SOL_SOCKET, SO_REUSEPORT) > 0;
+      // The kernel reports the doubled sizes, halving them lets options(options()) keep them
+      const int send_buffer{read(fd, SOL_SOCKET, SO_SNDBUF)};
+      const int receive_buffer{read(fd, SOL_SOCKET, SO_RCVBUF)};
+      options.send_buffer = send_buffer > 0 ? send_buffer / 2 : send_buffer;
+      options.receive_buffer = receive_buffer > 0 ? receive_buffer / 2 : receive_buffer;
+      options.busy_poll = read(fd, SOL_SOCKET, SO_BUSY_POLL);
+      options.priority = read(fd, SOL_SOCKET, SO_PRIORITY);
+      options.type_of_service = family == AF_INET6 ? read(fd, IPPROTO_IPV6, IPV6_TCLASS)
+                                                   : read(fd, IPPROTO_IP, IP_TOS);
+      const int timestamping{read(fd, SOL_SOCKET, SO_TIMESTAMPING)};
+      options.receive_timestamps = timestamping > 0
+                                   && (timestamping & SOF_TIMESTAMPING_RX_SOFTWARE) != 0;
+      options.hardware_timestamps = timestamping > 0
+                                    && (timestamping & SOF_TIMESTAMPING_RX_HARDWARE) != 0;
+      options.no_delay = is_tcp && read(fd, IPPROTO_TCP, TCP_NODELAY) > 0;
+      options.quick_ack = is_tcp && read(fd, IPPROTO_TCP, TCP_QUICKACK) > 0;
+      return options;
+    }
+  } // namespace: network_communication
+} // namespace: ramrod
@@ -0,0 +1,92 @@
+#include "ramrod/network_communication/socket_wait.h"
+
+#include <cerrno>                      // for errno, EAGAIN, EBADF, ECANCELED, EINTR
+#include <chrono>                      // for steady_clock, milliseconds
+#include <fcntl.h>                     // for fcntl, F_GETFL, F_SETFL, O_NONBLOCK
+#include <poll.h>                      // for poll, pollfd, POLLIN, POLLOUT
+
+#include "ramrod/console/perror.h"     // for perror, perror_stream
+
+namespace ramrod {
+  namespace network_communication {
+    bool retry_transfer(const int fd, const short events, const int timeout_in_milliseconds,
+                        const std::uint32_t max_intents, std::uint32_t *error_counter,
+                        const std::atomic<bool> *cancel, connection_metrics *metrics){
+      const int error{errno};
+      // Interrupted by a signal before transferring anything, nothing went wrong
+      if(error == EINTR){
+        if(metrics) metrics->retried();
+        return true;
+      }
+
+      // A busy socket is not an error, the waiting below decides when it is too much
+      const bool failed{error != EAGAIN && error != EWOULDBLOCK};
+      if(failed){
+#ifdef VERBOSE
+        rr::perror(events == POLLIN ? "Receiving data" : "Sending data");
+#endif
+        if(++(*error_counter) > max_intents)
+          return metrics ? metrics->failed(events == POLLOUT, true) : false;
+      }
+
+      // Retries as soon as the socket is ready instead of sleeping a fixed time
+      const int ready = wait_for_socket(fd, events, timeout_in_milliseconds, cancel);
+      if(ready < 0) return metrics ? metrics->failed(events == POLLOUT, false) : false;
+
+      // The error was already counted, one iteration is only one intent
+      if(ready == 0 && !failed && ++(*error_counter) > max_intents){
+        errno = error;
+        return metrics ? metrics->failed(events == POLLOUT, true) : false;
+      }
+      if(metrics) metrics->retried();
+      return true;
+    }
+
+    bool set_non_blocking(const int fd, const bool enable){
+      const int file_flags = ::fcntl(fd, F_GETFL, 0);
+      if(file_flags == -1) return false;
+
+      const int new_flags = enable ? file_flags | O_NONBLOCK : file_flags & ~O_NONBLOCK;
+      if(new_flags == file_flags) return true;
+      return ::fcntl(fd, F_SETFL, new_flags) != -1;
+    }
+
+    int wait_for_socket(const int fd, const short events, const int timeout_in_milliseconds,
+                        const std::atomic<bool> *cancel){
+      // poll() ignores negative descriptors, it would wait the whole time for nothing
+      if(fd < 0){
+        errno = EBADF;
+        return -1;
+      }
+
+      // Only a waiting with cancellation flag needs to wake up periodically
+      constexpr int slice{50};
+      const auto deadline = std::chrono::steady_clock::now()
+                            + std::chrono::milliseconds(timeout_in_milliseconds);
+      pollfd watched{fd, events, 0};
+
+      while(true){
+        if(cancel && cancel->load()){
+          errno = ECANCELED;
+          return -1;
+        }
+
+        int waiting{timeout_in_milliseconds};
+        if(timeout_in_milliseconds >= 0){
+          const auto left = std::chrono::duration_cast<std::chrono::milliseconds>(
+                              deadline - std::chrono::steady_clock::now()).count();
+          waiting = left > 0 ? static_cast<int>(left) : 0;
+        }
+        if(cancel && (waiting < 0 || waiting > slice)) waiting = slice;
+
+        const int ready = ::poll(&watched, 1, waiting);
+
+        if(ready > 0) return 1;
+        if(ready < 0 && errno != EINTR) return -1;
+        if(ready == 0 && timeout_in_milliseconds >= 0
+           && std::chrono::steady_clock::now() >= deadline)
+          return 0;
+      }
+    }
+  } // namespace: network_communication
+} // namespace: ramrod
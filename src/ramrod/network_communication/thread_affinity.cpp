@@ -0,0 +1,132 @@
+#include "ramrod/network_communication/thread_affinity.h"
+
+#include <cerrno>                      // for errno, EINVAL
+#include <cstddef>                     // for size_t
+#include <fstream>                     // for ifstream
+#include <pthread.h>                   // for pthread_self, pthread_setaffinity_np...
+#include <sched.h>                     // for cpu_set_t, CPU_SET, CPU_ZERO, SCHED_FIFO
+#include <string>                      // for string, to_string
+
+#include "ramrod/console/perror.h"     // for perror, perror_stream
+
+namespace ramrod {
+  namespace network_communication {
+    namespace {
+      // Linux names have 16 bytes including the terminating null
+      constexpr std::size_t max_name_size{15};
+
+      bool is_real_time(const int policy){
+        return policy == SCHED_FIFO || policy == SCHED_RR;
+      }
+
+      bool set_affinity(const std::vector<int> &cpus){
+        cpu_set_t selected;
+        CPU_ZERO(&selected);
+        for(const int cpu : cpus) CPU_SET(static_cast<std::size_t>(cpu), &selected);
+        // pthread functions return the error instead of setting errno
+        const int error = ::pthread_setaffinity_np(::pthread_self(), sizeof(selected), &selected);
+        if(error != 0){
+          errno = error;
+          rr::perror("Pinning thread to CPUs");
+          return false;
+        }
+        return true;
+      }
+    } // namespace: anonymous
+
+    std::vector<int> allowed_cpus(){
+      std::vector<int> cpus;
+      cpu_set_t allowed;
+      CPU_ZERO(&allowed);
+      if(::sched_getaffinity(0, sizeof(allowed), &allowed) == -1) return cpus;
+
+      for(int cpu{0}; cpu < CPU_SETSIZE; ++cpu)
+        if(CPU_ISSET(static_cast<std::size_t>(cpu), &allowed)) cpus.push_back(cpu);
+      return cpus;
+    }
+
+    bool configure_current_thread(const thread_options &options){
+      if(!validate_thread_options(options)){
+        rr::perror("Configuring thread");
+        return false;
+      }
+
+      int failure{0};
+      if(!options.name.empty()){
+        const std::string name{options.name.substr(0, max_name_size)};
+        const int error = ::pthread_setname_np(::pthread_self(), name.c_str());
+        if(error != 0){
+          errno = failure = error;
+          rr::perror("Naming thread");
+        }
+      }
+
+      if(!options.cpus.empty() && !set_affinity(options.cpus)) failure = errno;
+
+      if(options.policy >= 0){
+        sched_param parameters{};
+        parameters.sched_priority = options.priority;
+        const int error = ::pthread_setschedparam(::pthread_self(), options.policy, &parameters);
+        if(error != 0){
+          errno = failure = error;
+          rr::perror("Setting thread scheduling policy");
+        }
+      }
+
+      if(failure == 0) return true;
+      errno = failure;
+      return false;
+    }
+
+    std::vector<int> node_cpus(const int node){
+      std::vector<int> cpus;
+      if(node < 0) return cpus;
+
+      // The list looks like "0-3,8-11"
+      std::ifstream list("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+      int first{0};
+      while(list >> first){
+        int last{first};
+        if(list.peek() == '-'){
+          list.get();
+          if(!(list >> last)) break;
+        }
+        for(int cpu{first}; cpu <= last && cpu < CPU_SETSIZE; ++cpu) cpus.push_back(cpu);
+        if(list.peek() == ',') list.get();
+      }
+      return cpus;
+    }
+
+    bool pin_current_thread(const int cpu){
+      if(cpu < 0) return true;
+      if(cpu >= CPU_SETSIZE) return false;
+      return set_affinity(std::vector<int>{cpu});
+    }
+
+    thread_options thread_role(const thread_options &options, const char *role){
+      thread_options result{options};
+      if(!result.name.empty()) result.name = result.name + "-" + role;
+      return result;
+    }
+
+    bool validate_thread_options(const thread_options &options){
+      for(const int cpu : options.cpus){
+        if(cpu < 0 || cpu >= CPU_SETSIZE){
+          errno = EINVAL;
+          return false;
+        }
+      }
+      if(options.policy < 0) return true;
+
+      const int minimum{::sched_get_priority_min(options.policy)};
+      const int maximum{::sched_get_priority_max(options.policy)};
+      // The sched functions reject unknown policies
+      if(minimum == -1 || maximum == -1 || options.priority < minimum
+         || options.priority > maximum || (!is_real_time(options.policy) && options.priority != 0)){
+        errno = EINVAL;
+        return false;
+      }
+      return true;
+    }
+  } // namespace: network_communication
+} // namespace: ramrod
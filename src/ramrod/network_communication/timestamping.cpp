@@ -0,0 +1,53 @@
+#include "ramrod/network_communication/timestamping.h"
+
+#include <cstring>                     // for memcpy
+#include <linux/net_tstamp.h>          // for SOF_TIMESTAMPING_RX_SOFTWARE, SOF...
+
+namespace ramrod {
+  namespace network_communication {
+    namespace {
+      std::int64_t nanoseconds(const timespec &time){
+        return static_cast<std::int64_t>(time.tv_sec) * 1000000000
+               + static_cast<std::int64_t>(time.tv_nsec);
+      }
+    } // namespace: anonymous
+
+    std::int64_t packet_timestamp::software_nanoseconds() const{
+      return nanoseconds(software);
+    }
+
+    std::int64_t packet_timestamp::hardware_nanoseconds() const{
+      return nanoseconds(hardware);
+    }
+
+    bool enable_timestamping(const int fd, const bool enable, const bool hardware){
+      int flags{0};
+      if(enable){
+        // The RX flags generate the timestamps and the others report them
+        flags = SOF_TIMESTAMPING_RX_SOFTWARE | SOF_TIMESTAMPING_SOFTWARE;
+        if(hardware) flags |= SOF_TIMESTAMPING_RX_HARDWARE | SOF_TIMESTAMPING_RAW_HARDWARE;
+      }
+      return ::setsockopt(fd, SOL_SOCKET, SO_TIMESTAMPING, &flags, sizeof(flags)) != -1;
+    }
+
+    bool read_timestamp(const msghdr &header, packet_timestamp *timestamp){
+      *timestamp = packet_timestamp{};
+      if(header.msg_control == nullptr) return false;
+
+      for(cmsghdr *message = CMSG_FIRSTHDR(&header); message != nullptr;
+          message = CMSG_NXTHDR(const_cast<msghdr*>(&header), message)){
+        if(message->cmsg_level != SOL_SOCKET || message->cmsg_type != SCM_TIMESTAMPING
+           || message->cmsg_len < CMSG_LEN(3 * sizeof(timespec)))
+          continue;
+
+        // The second time is deprecated, the third one is the raw hardware time
+        timespec times[3];
+        std::memcpy(times, CMSG_DATA(message), sizeof(times));
+        timestamp->software = times[0];
+        timestamp->hardware = times[2];
+        return true;
+      }
+      return false;
+    }
+  } // namespace: network_communication
+} // namespace: ramrod
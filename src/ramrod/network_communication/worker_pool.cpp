@@ -0,0 +1,125 @@
+#include "ramrod/network_communication/worker_pool.h"
+
+#include <algorithm>  // for find_if
+#include <utility>    // for move
+
+namespace ramrod {
+  namespace network_communication {
+    worker_pool::worker_pool(const std::size_t threads, const int cpu) :
+      size_{threads > 0 ? threads : 1},
+      options_(),
+      generation_{1},
+      stopping_{false},
+      threads_(),
+      tasks_(),
+      mutex_(),
+      condition_()
+    {
+      if(cpu >= 0) options_.cpus.push_back(cpu);
+    }
+
+    worker_pool::worker_pool(const std::size_t threads, const thread_options &options) :
+      size_{threads > 0 ? threads : 1},
+      options_(options),
+      generation_{1},
+      stopping_{false},
+      threads_(),
+      tasks_(),
+      mutex_(),
+      condition_()
+    {}
+
+    worker_pool::~worker_pool(){
+      stop();
+    }
+
+    thread_options worker_pool::options(){
+      std::lock_guard<std::mutex> guard(mutex_);
+      return options_;
+    }
+
+    void worker_pool::options(const thread_options &new_options){
+      std::lock_guard<std::mutex> guard(mutex_);
+      options_ = new_options;
+      ++generation_;
+    }
+
+    bool worker_pool::post(std::function<void()> task){
+      if(!task) return false;
+      {
+        std::lock_guard<std::mutex> guard(mutex_);
+        if(stopping_) return false;
+        if(threads_.empty()) start();
+        tasks_.push_back(std::move(task));
+      }
+      condition_.notify_one();
+      return true;
+    }
+
+    std::size_t worker_pool::size(){
+      return size_;
+    }
+
+    void worker_pool::stop(){
+      std::vector<std::thread> threads;
+      {
+        std::lock_guard<std::mutex> guard(mutex_);
+        if(threads_.empty() || stopping_) return;
+        stopping_ = true;
+        threads.swap(threads_);
+      }
+      condition_.notify_all();
+
+      for(std::thread &thread : threads){
+        // A task could stop its own pool, joining itself would never return
+        if(thread.get_id() == std::this_thread::get_id())
+          thread.detach();
+        else
+          thread.join();
+      }
+
+      std::lock_guard<std::mutex> guard(mutex_);
+      stopping_ = false;
+    }
+
+    // :::::::::::::::::::::::::::::::::::: PRIVATE FUNCTIONS ::::::::::::::::::::::::::::::::::::
+
+    void worker_pool::start(){
+      threads_.reserve(size_);
+      for(std::size_t i = 0; i < size_; ++i)
+        threads_.emplace_back(&worker_pool::work, this);
+    }
+
+    void worker_pool::work(){
+      std::function<void()> task;
+      thread_options options;
+      std::uint64_t applied{0};
+      bool configure{false};
+
+      while(true){
+        {
+          std::unique_lock<std::mutex> lock(mutex_);
+          // A thread that stopped its own pool was detached and it must not keep working
+          if(!stopping_ && std::find_if(threads_.begin(), threads_.end(), [](std::thread &t){
+                             return t.get_id() == std::this_thread::get_id();
+                           }) == threads_.end())
+            return;
+          condition_.wait(lock, [this]{ return stopping_ || !tasks_.empty(); });
+          // Pending tasks are finished before stopping
+          if(tasks_.empty()) return;
+          task = std::move(tasks_.front());
+          tasks_.pop_front();
+          configure = applied != generation_;
+          if(configure){
+            options = options_;
+            applied = generation_;
+          }
+        }
+        // Outside the lock, changing the scheduling while holding it could stop the others
+        if(configure) configure_current_thread(options);
+        task();
+        task = nullptr;
+      }
+    }
+  } // namespace: network_communication
+} // namespace: ramrod
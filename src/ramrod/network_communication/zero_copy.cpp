@@ -0,0 +1,159 @@
+#include "ramrod/network_communication/zero_copy.h"
+
+#include <cerrno>                      // for errno, EAGAIN, ECANCELED, EINTR, EWO...
+#include <cstring>                     // for memcpy
+#include <linux/errqueue.h>            // for sock_extended_err, SO_EE_ORIGIN_ZEROCOPY
+#include <netinet/in.h>                // for IPPROTO_IP, IPPROTO_IPV6
+#include <sys/socket.h>                // for setsockopt, recvmsg, SO_ZEROCOPY
+#include <utility>                     // for move
+
+namespace ramrod {
+  namespace network_communication {
+    bool set_zero_copy(const int fd, const bool enable){
+      const int value{enable ? 1 : 0};
+      return ::setsockopt(fd, SOL_SOCKET, SO_ZEROCOPY, &value, sizeof(value)) != -1;
+    }
+
+    zero_copy_tracker::zero_copy_tracker() :
+      mutex_(),
+      pending_(),
+      active_{false},
+      reaping_{false},
+      next_{0},
+      completed_{0}
+    {}
+
+    zero_copy_tracker::~zero_copy_tracker(){
+      release();
+    }
+
+    bool zero_copy_tracker::active() const{
+      std::lock_guard<std::mutex> lock(mutex_);
+      return active_;
+    }
+
+    bool zero_copy_tracker::add(operation task, const ssize_t result, const int error,
+                                const std::uint32_t sends){
+      if(sends == 0){
+        errno = error;
+        task.finish(result);
+        return false;
+      }
+
+      std::lock_guard<std::mutex> lock(mutex_);
+      next_ += sends;
+      pending_.push_back(pending{std::move(task), result, error, next_ - 1});
+
+      const bool start{!reaping_};
+      reaping_ = true;
+      return start;
+    }
+
+    bool zero_copy_tracker::keep_reaping(){
+      std::lock_guard<std::mutex> lock(mutex_);
+      if(pending_.empty()) reaping_ = false;
+      return reaping_;
+    }
+
+    int zero_copy_tracker::reap(const int fd){
+      int reaped{0};
+      std::uint32_t last_completed{0};
+
+      while(true){
+        char control[128];
+        msghdr header{};
+        header.msg_control = control;
+        header.msg_controllen = sizeof(control);
+
+        if(::recvmsg(fd, &header, MSG_ERRQUEUE | MSG_DONTWAIT) == -1){
+          if(errno == EINTR) continue;
+          if(errno != EAGAIN && errno != EWOULDBLOCK) return -1;
+          break;
+        }
+
+        for(cmsghdr *message = CMSG_FIRSTHDR(&header); message != nullptr;
+            message = CMSG_NXTHDR(&header, message)){
+          if(!(message->cmsg_level == IPPROTO_IP && message->cmsg_type == IP_RECVERR)
+             && !(message->cmsg_level == IPPROTO_IPV6 && message->cmsg_type == IPV6_RECVERR))
+            continue;
+
+          sock_extended_err notification;
+          std::memcpy(&notification, CMSG_DATA(message), sizeof(notification));
+          if(notification.ee_origin != SO_EE_ORIGIN_ZEROCOPY || notification.ee_errno != 0)
+            continue;
+
+          // The range from ee_info to ee_data was completed, they arrive in order
+          last_completed = notification.ee_data;
+          ++reaped;
+        }
+      }
+
+      if(reaped == 0){
+        // The socket is ready because of a connection error, not a notification
+        int pending_error{0};
+        socklen_t length{sizeof(pending_error)};
+        if(::getsockopt(fd, SOL_SOCKET, SO_ERROR, &pending_error, &length) == -1)
+          return -1;
+        if(pending_error != 0){
+          errno = pending_error;
+          return -1;
+        }
+        return 0;
+      }
+
+      std::deque<pending> finished;
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        // Comparing with the difference so the numbers can wrap around
+        if(static_cast<std::int32_t>(last_completed + 1 - completed_) > 0)
+          completed_ = last_completed + 1;
+
+        while(!pending_.empty()
+              && static_cast<std::int32_t>(completed_ - pending_.front().last) > 0){
+          finished.push_back(std::move(pending_.front()));
+          pending_.pop_front();
+        }
+      }
+      finish(&finished);
+      return 1;
+    }
+
+    void zero_copy_tracker::release(){
+      std::deque<pending> finished;
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        finished.swap(pending_);
+      }
+      // Without a notification the kernel could still be sending from the buffers
+      for(pending &cancelled : finished){
+        cancelled.result = -1;
+        cancelled.error = ECANCELED;
+      }
+      finish(&finished);
+    }
+
+    void zero_copy_tracker::reset(const bool active){
+      release();
+
+      std::lock_guard<std::mutex> lock(mutex_);
+      active_ = active;
+      next_ = 0;
+      completed_ = 0;
+    }
+
+    void zero_copy_tracker::set_active(const bool active){
+      std::lock_guard<std::mutex> lock(mutex_);
+      active_ = active;
+    }
+
+    // :::::::::::::::::::::::::::::::::::: PRIVATE FUNCTIONS ::::::::::::::::::::::::::::::::::::
+
+    void zero_copy_tracker::finish(std::deque<pending> *finished){
+      // Outside the lock, a completion function could send again
+      for(pending &sent : *finished){
+        errno = sent.error;
+        sent.task.finish(sent.result);
+      }
+    }
+  } // namespace: network_communication
+} // namespace: ramrod